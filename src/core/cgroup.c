@@ -0,0 +1,657 @@
+#include "cgroup.h"
+#include "metric_source.h"
+#include "../utils/error.h"
+
+// Group selected on the command line (NULL: the monitor's own), set before the engine starts
+static const char *cgroup_path = NULL;
+
+/**
+ * Select the cgroup the cgroup source reports on
+ * @param path Group directory (NULL: the monitor's own group)
+ */
+void cgroupSetPath(const char *path) {
+    cgroup_path = path;
+}
+
+#ifdef __linux__
+#include "../platform/proc_file.h"
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/sysinfo.h>
+
+/**
+ * Interface files read from the group directory
+ */
+enum {
+    CGROUP_MEMORY_CURRENT,
+    CGROUP_MEMORY_MAX,
+    CGROUP_MEMORY_STAT,
+    CGROUP_CPU_STAT,
+    CGROUP_CPU_MAX,
+    CGROUP_CPUSET,
+    CGROUP_FILES
+};
+
+static const char *const cgroup_files[CGROUP_FILES] = {
+    "memory.current", "memory.max", "memory.stat", "cpu.stat", "cpu.max", "cpuset.cpus.effective"
+};
+
+/**
+ * Limit files of one ancestor group
+ *
+ * A group is bound by the memory.max and cpu.max of every group above it,
+ * not only by its own.
+ */
+typedef struct {
+    char memory_path[PATH_MAX];     // Paths the readers were opened from
+    char cpu_path[PATH_MAX];
+    proc_file_t memory_max;
+    proc_file_t cpu_max;
+    int has_memory_max;
+    int has_cpu_max;
+} CgroupAncestor;
+
+/**
+ * Cgroup source state
+ *
+ * Every interface file is opened once and re-read with pread(); a file
+ * the group does not have (controller not enabled, root group) stays
+ * closed and its figures are left out. Limits are re-read every sample
+ * since they can be changed while the group runs.
+ */
+typedef struct {
+    char path[CGROUP_PATH_LENGTH];              // Group path shown in the section
+    char file_path[CGROUP_FILES][PATH_MAX];     // Paths the readers were opened from
+    proc_file_t file[CGROUP_FILES];
+    int open[CGROUP_FILES];
+    CgroupAncestor *ancestors;                  // Ancestors that set a limit file, nearest first
+    int ancestor_count;
+    uint64_t host_memory;                       // Physical memory (bytes)
+    int host_cpus;                              // Online CPUs
+    uint64_t last_ns;                           // CLOCK_MONOTONIC time of the previous sample (0: none)
+} CgroupMonitor;
+
+/**
+ * Find the cgroup v2 mount
+ * @param mount Output mount point (PATH_MAX bytes)
+ * @param root Output hierarchy path mounted there (PATH_MAX bytes)
+ * @return 0 on success, -1 if no cgroup2 file system is mounted
+ */
+int cgroupFindMount(char *mount, char *root) {
+    FILE *fp = fopen("/proc/self/mountinfo", "r");
+    char line[PATH_MAX * 2 + 256];
+    int found = -1;
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    // "42 32 0:38 / /sys/fs/cgroup/unified rw,relatime - cgroup2 cgroup2 rw"
+    while (found != 0 && fgets(line, sizeof(line), fp) != NULL) {
+        if (strstr(line, " - cgroup2 ") != NULL &&
+            sscanf(line, "%*s %*s %*s %4095s %4095s", root, mount) == 2) {
+            found = 0;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+/**
+ * Path of the monitor's own group in the cgroup v2 hierarchy
+ * @param path Output path
+ * @param size Path capacity
+ * @return 0 on success, -1 if the process has no cgroup v2 membership
+ */
+static int findOwnCgroup(char *path, size_t size) {
+    FILE *fp = fopen("/proc/self/cgroup", "r");
+    char line[PATH_MAX + 16];
+    int found = -1;
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    // The unified hierarchy is the "0::" entry
+    while (found != 0 && fgets(line, sizeof(line), fp) != NULL) {
+        if (strncmp(line, "0::", 3) == 0) {
+            line[strcspn(line, "\n")] = '\0';
+            snprintf(path, size, "%s", line + 3);
+            found = 0;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+/**
+ * Resolve the directory of the group to report on
+ * @param monitor Source state (path is filled)
+ * @param dir Output directory
+ * @return 0 on success, -1 if the group cannot be found
+ */
+static int resolveCgroupDir(CgroupMonitor *monitor, char dir[PATH_MAX]) {
+    char mount[PATH_MAX] = "";
+    char root[PATH_MAX] = "/";
+    char group[PATH_MAX];
+    struct stat st;
+    int mounted = cgroupFindMount(mount, root) == 0;
+
+    // An explicit directory is used as given
+    if (cgroup_path != NULL && cgroup_path[0] == '/' &&
+        stat(cgroup_path, &st) == 0 && S_ISDIR(st.st_mode)) {
+        size_t len = strlen(mount);
+        snprintf(dir, PATH_MAX, "%s", cgroup_path);
+        snprintf(monitor->path, sizeof(monitor->path), "%s",
+                 mounted && strncmp(cgroup_path, mount, len) == 0 && cgroup_path[len] == '/' ?
+                 cgroup_path + len : cgroup_path);
+        return 0;
+    }
+    if (!mounted) {
+        return -1;
+    }
+
+    if (cgroup_path != NULL) {
+        snprintf(group, sizeof(group), "%s%s", cgroup_path[0] == '/' ? "" : "/", cgroup_path);
+    } else if (findOwnCgroup(group, sizeof(group)) != 0) {
+        return -1;
+    }
+    if (snprintf(monitor->path, sizeof(monitor->path), "%s", group) >= (int)sizeof(monitor->path)) {
+        return -1;
+    }
+
+    // A mount of a subgroup (no cgroup namespace) shows paths from the real root
+    size_t root_len = strcmp(root, "/") == 0 ? 0 : strlen(root);
+    const char *relative = group;
+    if (root_len > 0 && strncmp(group, root, root_len) == 0) {
+        relative = group + root_len;
+    }
+    int len = snprintf(dir, PATH_MAX, "%s%s", mount, relative);
+    while (len > 1 && dir[len - 1] == '/') {
+        dir[--len] = '\0';
+    }
+    return stat(dir, &st) == 0 && S_ISDIR(st.st_mode) ? 0 : -1;
+}
+
+/**
+ * Open the limit files of every ancestor of a group
+ *
+ * Walks up one directory at a time while the parent is still a cgroup
+ * directory (it has cgroup.controllers), so the walk ends at the root of
+ * the mounted hierarchy. The root group has no limit files and ancestors
+ * without either file are not kept.
+ *
+ * @param monitor Source state
+ * @param dir Directory of the group
+ */
+static void openCgroupAncestors(CgroupMonitor *monitor, const char *dir) {
+    char parent[PATH_MAX];
+    char probe[PATH_MAX];
+    int count = 0;
+    int kept = 0;
+
+    snprintf(parent, sizeof(parent), "%s", dir);
+    for (;;) {
+        char *slash = strrchr(parent, '/');
+        if (slash == NULL || slash == parent) {
+            break;
+        }
+        *slash = '\0';
+        if (snprintf(probe, sizeof(probe), "%s/cgroup.controllers", parent) >= (int)sizeof(probe) ||
+            access(probe, F_OK) != 0) {
+            break;
+        }
+
+        CgroupAncestor *grown = realloc(monitor->ancestors, (size_t)(count + 1) * sizeof(CgroupAncestor));
+        if (grown == NULL) {
+            break;
+        }
+        monitor->ancestors = grown;
+        if (snprintf(grown[count].memory_path, PATH_MAX, "%s/memory.max", parent) >= PATH_MAX ||
+            snprintf(grown[count].cpu_path, PATH_MAX, "%s/cpu.max", parent) >= PATH_MAX) {
+            break;
+        }
+        count++;
+    }
+
+    // Open once the array no longer moves: readers keep a pointer to their path
+    for (int a = 0; a < count; a++) {
+        CgroupAncestor *ancestor = &monitor->ancestors[kept];
+        if (kept != a) {
+            memcpy(ancestor, &monitor->ancestors[a], sizeof(*ancestor));
+        }
+        ancestor->has_memory_max = proc_file_open(&ancestor->memory_max, ancestor->memory_path) == 0;
+        ancestor->has_cpu_max = proc_file_open(&ancestor->cpu_max, ancestor->cpu_path) == 0;
+        if (ancestor->has_memory_max || ancestor->has_cpu_max) {
+            kept++;
+        }
+    }
+    monitor->ancestor_count = kept;
+}
+
+/**
+ * Read a single-value interface file ("1234" or "max")
+ * @param file Open reader
+ * @param value Output value
+ * @return 1 for a number, 0 for "max", -1 if the file could not be read
+ */
+static int readLimitValue(proc_file_t *file, uint64_t *value) {
+    if (proc_file_read(file) <= 0) {
+        return -1;
+    }
+    const char *p = file->buf;
+    if (strncmp(p, "max", 3) == 0) {
+        return 0;
+    }
+    return proc_scan_u64(p, value) != NULL ? 1 : -1;
+}
+
+/**
+ * Read a single-value interface file of the group
+ * @param monitor Source state
+ * @param f File index
+ * @param value Output value
+ * @return 1 for a number, 0 for "max", -1 if the file could not be read
+ */
+static int readCgroupValue(CgroupMonitor *monitor, int f, uint64_t *value) {
+    return monitor->open[f] ? readLimitValue(&monitor->file[f], value) : -1;
+}
+
+/**
+ * Read a cpu.max file ("max 100000" or "<quota> <period>")
+ * @param file Open reader
+ * @param cores Output quota in cores
+ * @return 1 if a quota is set, 0 otherwise
+ */
+static int readCpuQuota(proc_file_t *file, float *cores) {
+    uint64_t quota, period;
+
+    if (proc_file_read(file) <= 0) {
+        return 0;
+    }
+    const char *p = proc_scan_u64(file->buf, &quota);
+    if (p == NULL || proc_scan_u64(p, &period) == NULL || period == 0) {
+        return 0;
+    }
+    *cores = (float)quota / (float)period;
+    return 1;
+}
+
+/**
+ * Find a key of a "key value" interface file
+ * @param buf File contents
+ * @param key Key followed by a space ("anon ")
+ * @param key_len Length of key
+ * @param value Output value (untouched if the key is missing)
+ */
+static void scanCgroupKey(const char *buf, const char *key, size_t key_len, uint64_t *value) {
+    for (const char *p = buf; *p != '\0'; p = proc_next_line(p)) {
+        if (strncmp(p, key, key_len) == 0) {
+            proc_scan_u64(p + key_len, value);
+            return;
+        }
+    }
+}
+
+#define CGROUP_KEY(buf, key, value) scanCgroupKey((buf), key " ", sizeof(key), (value))
+
+/**
+ * Count the CPUs of a cpuset list ("0-3,6")
+ * @param list List text
+ * @return CPU count (0 for an empty or malformed list)
+ */
+static int countCpuList(const char *list) {
+    int count = 0;
+    uint64_t first, last;
+    const char *p = list;
+
+    while ((p = proc_scan_u64(p, &first)) != NULL) {
+        last = first;
+        if (*p == '-' && (p = proc_scan_u64(p + 1, &last)) == NULL) {
+            return 0;
+        }
+        if (last >= first) {
+            count += (int)(last - first + 1);
+        }
+        if (*p != ',') {
+            break;
+        }
+        p++;
+    }
+    return count;
+}
+
+/**
+ * Current CLOCK_MONOTONIC time
+ * @return Nanoseconds
+ */
+static uint64_t cgroupClockNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Memory figures of the group
+ * @param monitor Source state
+ * @param sample Section being filled
+ */
+static void collectCgroupMemory(CgroupMonitor *monitor, CgroupSample *sample) {
+    uint64_t max = 0;
+    uint64_t inactive_file = 0;
+    uint64_t kernel_stack = 0;
+    uint64_t slab = 0;
+
+    sample->has_memory = readCgroupValue(monitor, CGROUP_MEMORY_CURRENT, &sample->memory_current) > 0;
+    if (!sample->has_memory) {
+        return;
+    }
+
+    // The tightest memory.max of the group and its ancestors applies;
+    // a limit above physical memory limits nothing
+    sample->memory_limit = monitor->host_memory;
+    if (readCgroupValue(monitor, CGROUP_MEMORY_MAX, &max) > 0 && max < sample->memory_limit) {
+        sample->memory_limit = max;
+    }
+    for (int a = 0; a < monitor->ancestor_count; a++) {
+        CgroupAncestor *ancestor = &monitor->ancestors[a];
+        if (ancestor->has_memory_max && readLimitValue(&ancestor->memory_max, &max) > 0 &&
+            max < sample->memory_limit) {
+            sample->memory_limit = max;
+        }
+    }
+    sample->memory_limited = sample->memory_limit < monitor->host_memory;
+
+    sample->memory_anon = sample->memory_file = sample->memory_kernel = 0;
+    if (monitor->open[CGROUP_MEMORY_STAT] && proc_file_read(&monitor->file[CGROUP_MEMORY_STAT]) > 0) {
+        const char *buf = monitor->file[CGROUP_MEMORY_STAT].buf;
+        CGROUP_KEY(buf, "anon", &sample->memory_anon);
+        CGROUP_KEY(buf, "file", &sample->memory_file);
+        CGROUP_KEY(buf, "inactive_file", &inactive_file);
+        CGROUP_KEY(buf, "kernel", &sample->memory_kernel);
+        if (sample->memory_kernel == 0) {
+            // Kernels before 5.18 have no "kernel" total
+            CGROUP_KEY(buf, "kernel_stack", &kernel_stack);
+            CGROUP_KEY(buf, "slab", &slab);
+            sample->memory_kernel = kernel_stack + slab;
+        }
+    }
+
+    sample->working_set = sample->memory_current > inactive_file ?
+                          sample->memory_current - inactive_file : 0;
+    sample->memory_percent = sample->memory_limit > 0 ?
+                             (float)((double)sample->working_set * 100.0 / sample->memory_limit) : 0.0f;
+}
+
+/**
+ * CPU figures of the group
+ * @param monitor Source state
+ * @param sample Section being filled (still holds the previous counters)
+ * @param interval_ns Time since the previous sample (0: first sample)
+ */
+static void collectCgroupCpu(CgroupMonitor *monitor, CgroupSample *sample, uint64_t interval_ns) {
+    uint64_t last_usage = sample->usage_usec;
+    uint64_t last_user = sample->user_usec;
+    uint64_t last_periods = sample->nr_periods;
+    uint64_t last_throttled = sample->nr_throttled;
+    int had_cpu = sample->has_cpu;
+
+    sample->has_cpu = monitor->open[CGROUP_CPU_STAT] && proc_file_read(&monitor->file[CGROUP_CPU_STAT]) > 0;
+    if (!sample->has_cpu) {
+        return;
+    }
+
+    // "usage_usec 123\nuser_usec 100\nsystem_usec 23\n..." (throttling keys only with the cpu controller)
+    const char *buf = monitor->file[CGROUP_CPU_STAT].buf;
+    CGROUP_KEY(buf, "usage_usec", &sample->usage_usec);
+    CGROUP_KEY(buf, "user_usec", &sample->user_usec);
+    CGROUP_KEY(buf, "system_usec", &sample->system_usec);
+    CGROUP_KEY(buf, "nr_periods", &sample->nr_periods);
+    CGROUP_KEY(buf, "nr_throttled", &sample->nr_throttled);
+    CGROUP_KEY(buf, "throttled_usec", &sample->throttled_usec);
+
+    // Cores the group may use: the host, narrowed by its cpuset (already
+    // intersected with the ancestors' by the kernel), then by the tightest
+    // quota of the group and its ancestors
+    float quota;
+    sample->cpu_limit = (float)monitor->host_cpus;
+    sample->cpu_limited = 0;
+    if (monitor->open[CGROUP_CPUSET] && proc_file_read(&monitor->file[CGROUP_CPUSET]) > 0) {
+        int cpus = countCpuList(monitor->file[CGROUP_CPUSET].buf);
+        if (cpus > 0 && cpus < monitor->host_cpus) {
+            sample->cpu_limit = (float)cpus;
+            sample->cpu_limited = 1;
+        }
+    }
+    if (monitor->open[CGROUP_CPU_MAX] && readCpuQuota(&monitor->file[CGROUP_CPU_MAX], &quota) &&
+        quota < sample->cpu_limit) {
+        sample->cpu_limit = quota;
+        sample->cpu_limited = 1;
+    }
+    for (int a = 0; a < monitor->ancestor_count; a++) {
+        CgroupAncestor *ancestor = &monitor->ancestors[a];
+        if (ancestor->has_cpu_max && readCpuQuota(&ancestor->cpu_max, &quota) &&
+            quota < sample->cpu_limit) {
+            sample->cpu_limit = quota;
+            sample->cpu_limited = 1;
+        }
+    }
+
+    sample->cpu_cores = sample->cpu_percent = sample->user_percent = sample->throttled_percent = 0.0f;
+    if (!had_cpu || interval_ns == 0 || sample->usage_usec < last_usage) {
+        return;
+    }
+
+    uint64_t usage = sample->usage_usec - last_usage;
+    uint64_t user = sample->user_usec >= last_user ? sample->user_usec - last_user : 0;
+    sample->cpu_cores = (float)(usage * 1000.0 / interval_ns);
+    sample->cpu_percent = sample->cpu_limit > 0.0f ? sample->cpu_cores * 100.0f / sample->cpu_limit : 0.0f;
+    sample->user_percent = usage > 0 ? sample->cpu_percent * (float)user / (float)usage : 0.0f;
+    if (sample->nr_periods > last_periods && sample->nr_throttled >= last_throttled) {
+        sample->throttled_percent = (float)(sample->nr_throttled - last_throttled) * 100.0f /
+                                    (float)(sample->nr_periods - last_periods);
+    }
+}
+
+/**
+ * Cgroup source: sample the group
+ * @param state Source state
+ * @param snapshot Snapshot being assembled
+ * @return 0 on success, -1 if nothing could be read
+ */
+static int cgroupSourceCollect(void *state, SystemSnapshot *snapshot) {
+    CgroupMonitor *monitor = state;
+    CgroupSample *sample = &snapshot->cgroup;
+    uint64_t now_ns = cgroupClockNs();
+    uint64_t interval_ns = monitor->last_ns != 0 ? now_ns - monitor->last_ns : 0;
+
+    monitor->last_ns = now_ns;
+    memcpy(sample->path, monitor->path, sizeof(sample->path));
+    sample->interval_ns = interval_ns;
+
+    collectCgroupMemory(monitor, sample);
+    collectCgroupCpu(monitor, sample, interval_ns);
+    return sample->has_memory || sample->has_cpu ? 0 : -1;
+}
+
+/**
+ * Cgroup source: find the group and open its interface files
+ * @param state Output state
+ * @return 0 on success, -1 without cgroup v2
+ */
+static int cgroupSourceInit(void **state) {
+    CgroupMonitor *monitor = calloc(1, sizeof(*monitor));
+    char dir[PATH_MAX];
+    struct sysinfo info;
+    int opened = 0;
+
+    if (monitor == NULL) {
+        return -1;
+    }
+    if (resolveCgroupDir(monitor, dir) != 0) {
+        LOG_WARNING(SYS_MON_ERR_PLATFORM, "cgroup %s not found in a cgroup v2 hierarchy",
+                    cgroup_path != NULL ? cgroup_path : "of this process");
+        free(monitor);
+        return -1;
+    }
+
+    monitor->host_cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (sysinfo(&info) == 0) {
+        monitor->host_memory = (uint64_t)info.totalram * info.mem_unit;
+    }
+
+    for (int f = 0; f < CGROUP_FILES; f++) {
+        int len = snprintf(monitor->file_path[f], sizeof(monitor->file_path[f]), "%s/%s", dir, cgroup_files[f]);
+        monitor->open[f] = len < (int)sizeof(monitor->file_path[f]) &&
+                           proc_file_open(&monitor->file[f], monitor->file_path[f]) == 0;
+        opened += monitor->open[f];
+    }
+    if (opened == 0) {
+        LOG_WARNING(SYS_MON_ERR_IO, "No memory or cpu interface files in %s", dir);
+        free(monitor);
+        return -1;
+    }
+    openCgroupAncestors(monitor, dir);
+    *state = monitor;
+    return 0;
+}
+
+/**
+ * Cgroup source: close the interface files
+ * @param state Source state
+ */
+static void cgroupSourceTeardown(void *state) {
+    CgroupMonitor *monitor = state;
+
+    for (int f = 0; f < CGROUP_FILES; f++) {
+        if (monitor->open[f]) {
+            proc_file_close(&monitor->file[f]);
+        }
+    }
+    for (int a = 0; a < monitor->ancestor_count; a++) {
+        if (monitor->ancestors[a].has_memory_max) {
+            proc_file_close(&monitor->ancestors[a].memory_max);
+        }
+        if (monitor->ancestors[a].has_cpu_max) {
+            proc_file_close(&monitor->ancestors[a].cpu_max);
+        }
+    }
+    free(monitor->ancestors);
+    free(monitor);
+}
+#else
+/**
+ * Find the cgroup v2 mount: cgroups are Linux-only
+ * @param mount Unused
+ * @param root Unused
+ * @return -1
+ */
+int cgroupFindMount(char *mount, char *root) {
+    (void)mount;
+    (void)root;
+    return -1;
+}
+
+/**
+ * Cgroup source: cgroups are Linux-only
+ * @param state Unused
+ * @return -1
+ */
+static int cgroupSourceInit(void **state) {
+    (void)state;
+    return -1;
+}
+
+/**
+ * Cgroup source: never called without init
+ * @param state Unused
+ * @param snapshot Unused
+ * @return -1
+ */
+static int cgroupSourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    (void)snapshot;
+    return -1;
+}
+
+/**
+ * Cgroup source: nothing to release
+ * @param state Unused
+ */
+static void cgroupSourceTeardown(void *state) {
+    (void)state;
+}
+#endif
+
+/**
+ * Cgroup source: description
+ * @return Static string
+ */
+static const char *cgroupSourceDescribe(void) {
+    return "cgroup v2 memory and cpu accounting (memory.*, cpu.*, cpuset.cpus.effective)";
+}
+
+const MetricSource cgroupMetricSource = {
+    .name = "cgroup",
+    .section = METRIC_CGROUP,
+    .period_ms = 0,
+    .init = cgroupSourceInit,
+    .collect = cgroupSourceCollect,
+    .teardown = cgroupSourceTeardown,
+    .describe = cgroupSourceDescribe
+};
+
+/**
+ * Cgroup sample formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatCgroupSample(const CgroupSample *sample, char *buffer, size_t size) {
+    const double MB = 1024.0 * 1024.0;
+    size_t used = 0;
+    int lines = 0;
+    int len;
+
+    len = snprintf(buffer, size, "Group: %s\n", sample->path);
+    if (len < 0 || (size_t)len >= size) {
+        return 0;
+    }
+    used = (size_t)len;
+    lines++;
+
+    if (sample->has_memory) {
+        len = snprintf(buffer + used, size - used,
+                       "Memory: %.1f MB of %.1f MB%s (%.1f%%) working set, %.1f MB charged"
+                       " (anon %.1f, file %.1f, kernel %.1f)\n",
+                       sample->working_set / MB, sample->memory_limit / MB,
+                       sample->memory_limited ? " limit" : " host, no limit", sample->memory_percent,
+                       sample->memory_current / MB, sample->memory_anon / MB,
+                       sample->memory_file / MB, sample->memory_kernel / MB);
+    } else {
+        len = snprintf(buffer + used, size - used, "Memory: not accounted for this group\n");
+    }
+    if (len < 0 || (size_t)len >= size - used) {
+        buffer[used] = '\0';
+        return lines;
+    }
+    used += (size_t)len;
+    lines++;
+
+    if (sample->has_cpu) {
+        len = snprintf(buffer + used, size - used,
+                       "CPU: %.2f of %.2f cores%s (%.1f%%, user %.1f%%), throttled in %.1f%% of periods\n",
+                       sample->cpu_cores, sample->cpu_limit,
+                       sample->cpu_limited ? " allowed" : " on the host, no limit",
+                       sample->cpu_percent, sample->user_percent, sample->throttled_percent);
+    } else {
+        len = snprintf(buffer + used, size - used, "CPU: not accounted for this group\n");
+    }
+    if (len < 0 || (size_t)len >= size - used) {
+        buffer[used] = '\0';
+        return lines;
+    }
+    return lines + 1;
+}
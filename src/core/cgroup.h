@@ -0,0 +1,91 @@
+#ifndef CGROUP_H
+#define CGROUP_H
+
+#include "../utils/common.h"
+#include <stdint.h>
+
+// Cgroup path length kept in the section, including the NUL
+#define CGROUP_PATH_LENGTH 256
+
+// Text buffer for the formatted cgroup section
+#define CGROUP_TEXT_BUFFER 768
+
+/**
+ * Cgroup section: CPU and memory of one cgroup v2 group against its effective limits
+ *
+ * Host figures (sysinfo, /proc/meminfo, /proc/stat) describe the whole
+ * machine; inside a container the limits that matter are the tightest
+ * memory.max and cpu.max of the group and its ancestors, and the group's
+ * effective cpuset. Where none is set, the host's memory or online CPUs
+ * take their place, so the percentages are always against what the group
+ * can actually use.
+ */
+typedef struct {
+    char path[CGROUP_PATH_LENGTH];  // Group path in the cgroup v2 hierarchy ("/" for the root)
+    uint64_t interval_ns;       // Time since the previous sample
+
+    // Memory (bytes)
+    int32_t has_memory;         // memory.current is readable (not on the root group)
+    int32_t memory_limited;     // memory.max of the group or an ancestor is below host memory
+    uint64_t memory_current;    // Charged to the group, page cache included
+    uint64_t memory_limit;      // Tightest memory.max, or host memory without a limit
+    uint64_t memory_anon;       // memory.stat anon
+    uint64_t memory_file;       // memory.stat file (page cache)
+    uint64_t memory_kernel;     // memory.stat kernel (or kernel_stack + slab on older kernels)
+    uint64_t working_set;       // current - inactive_file: what reclaim cannot easily take back
+    float memory_percent;       // Working set against the limit (%)
+
+    // CPU
+    int32_t has_cpu;            // cpu.stat is readable
+    int32_t cpu_limited;        // cpu.max quota or a cpuset narrower than the host
+    float cpu_limit;            // Cores the group may use
+    float cpu_cores;            // Cores used over the interval
+    float cpu_percent;          // cpu_cores against cpu_limit (%)
+    float user_percent;         // User share of cpu_percent
+    float throttled_percent;    // Share of the quota periods in which the group was throttled
+    uint64_t usage_usec;        // Cumulative cpu.stat counters
+    uint64_t user_usec;
+    uint64_t system_usec;
+    uint64_t nr_periods;
+    uint64_t nr_throttled;
+    uint64_t throttled_usec;
+} CgroupSample;
+
+/**
+ * Select the cgroup the cgroup source reports on
+ *
+ * Must be called before the collector engine starts.
+ *
+ * @param path Group directory, absolute or relative to the cgroup v2
+ *             mount (NULL: the monitor's own group from /proc/self/cgroup)
+ */
+void cgroupSetPath(const char *path);
+
+/**
+ * Find the cgroup v2 mount
+ *
+ * Reads /proc/self/mountinfo; on hybrid hosts the v2 hierarchy is often
+ * mounted below /sys/fs/cgroup (e.g. /sys/fs/cgroup/unified).
+ *
+ * @param mount Output mount point (PATH_MAX bytes)
+ * @param root Output hierarchy path mounted there, "/" unless a subgroup was mounted (PATH_MAX bytes)
+ * @return 0 on success, -1 if no cgroup2 file system is mounted
+ */
+int cgroupFindMount(char *mount, char *root);
+
+/**
+ * Cgroup sample formatting function
+ *
+ * Formats one memory line and one CPU line.
+ *
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatCgroupSample(const CgroupSample *sample, char *buffer, size_t size);
+
+// Cgroup section title
+#define CGROUP_INFO_TITLE "### Cgroup ### (usage against the group's effective limits)"
+
+#endif // CGROUP_H
@@ -0,0 +1,722 @@
+#include "cgroup_tree.h"
+#include "cgroup.h"
+#include "metric_source.h"
+#include "../utils/error.h"
+#include "../utils/trace.h"
+
+#ifdef __linux__
+#include "../platform/proc_file.h"
+#include <dirent.h>
+#include <limits.h>
+#include <sys/inotify.h>
+
+// Watched on every group directory: child groups created and removed, and
+// kernfs change notifications of its files, of which only cgroup.events
+// is used. cgroupfs keeps the link count of a removed directory, so the
+// removal shows up as IN_DELETE on the parent, not as IN_DELETE_SELF.
+#define CGROUP_TREE_WATCH (IN_CREATE | IN_DELETE | IN_MODIFY | IN_ONLYDIR)
+
+// inotify reads per sample; a burst beyond this waits for the next sample
+#define CGROUP_TREE_EVENT_READS 16
+
+// Read buffer for one small interface file
+#define CGROUP_TREE_FILE_BUFFER 512
+
+static const char *const cgroup_tree_pressures[CGROUP_TREE_PRESSURES] = {
+    "cpu.pressure", "memory.pressure", "io.pressure"
+};
+
+/**
+ * One group directory
+ */
+typedef struct {
+    char *path;                 // Absolute directory (NULL: free slot)
+    int parent;                 // Parent slot (-1 for the root)
+    int depth;                  // 0 for the root
+    int wd;                     // inotify watch (-1: none)
+    int populated;              // From cgroup.events (the root is always populated)
+    uint64_t usage_usec;        // cpu.stat usage_usec at read_ns
+    uint64_t read_ns;           // CLOCK_MONOTONIC time of the last read (0: never read)
+    float cpu_cores;            // Cores used between the last two reads
+    uint64_t memory_current;
+    float pressure[CGROUP_TREE_PRESSURES];
+} CgroupNode;
+
+/**
+ * Cgroup tree source state
+ *
+ * The hierarchy is walked once at start. After that one inotify watch per
+ * group directory reports new child groups, removed groups, and changes
+ * of cgroup.events, so the tree is kept current without re-walking it.
+ * Each sample reads the files of at most CGROUP_TREE_READ_BUDGET groups,
+ * round-robin, and skips groups without processes: their counters do not
+ * move. Rates are computed per group from its own read times, so a group
+ * read every few samples still gets a correct figure. Nothing is kept
+ * open per group, so thousands of groups cost no descriptors.
+ */
+typedef struct {
+    char mount[PATH_MAX];       // cgroup v2 mount point (the root group)
+    size_t mount_len;
+    int inotify_fd;
+    CgroupNode *nodes;
+    int count;                  // Slots in use or freed
+    int capacity;
+    int live;                   // Groups known
+    int cursor;                 // Next slot to read
+    int *watch_index;           // Slot + 1 per bucket, keyed by watch descriptor (0: empty)
+    uint32_t watch_mask;        // Bucket count - 1 (power of two)
+    int created;                // Since the previous sample
+    int removed;
+    int rescan;                 // Events were lost: walk the hierarchy again
+    int watch_warned;
+} CgroupTreeMonitor;
+
+/**
+ * Current CLOCK_MONOTONIC time
+ * @return Nanoseconds
+ */
+static uint64_t cgroupTreeClockNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Read a small interface file of a group
+ * @param dir Group directory
+ * @param name File name
+ * @param buf Output buffer (NUL-terminated)
+ * @param size Buffer size
+ * @return 0 on success, -1 on failure
+ */
+static int readGroupFile(const char *dir, const char *name, char *buf, size_t size) {
+    char path[PATH_MAX];
+    ssize_t n;
+
+    if (snprintf(path, sizeof(path), "%s/%s", dir, name) >= (int)sizeof(path)) {
+        return -1;
+    }
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    do {
+        n = read(fd, buf, size - 1);
+    } while (n < 0 && errno == EINTR);
+    close(fd);
+    if (n <= 0) {
+        return -1;
+    }
+    buf[n] = '\0';
+    return 0;
+}
+
+/**
+ * Slot of a watch descriptor
+ * @return Slot, or -1 if unknown
+ */
+static int findWatch(const CgroupTreeMonitor *monitor, int wd) {
+    for (uint32_t b = (uint32_t)wd & monitor->watch_mask; monitor->watch_index[b] != 0;
+         b = (b + 1) & monitor->watch_mask) {
+        if (monitor->nodes[monitor->watch_index[b] - 1].wd == wd) {
+            return monitor->watch_index[b] - 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Index a slot by its watch descriptor
+ */
+static void insertWatch(CgroupTreeMonitor *monitor, int slot) {
+    uint32_t b = (uint32_t)monitor->nodes[slot].wd & monitor->watch_mask;
+    while (monitor->watch_index[b] != 0) {
+        b = (b + 1) & monitor->watch_mask;
+    }
+    monitor->watch_index[b] = slot + 1;
+}
+
+/**
+ * Remove a watch descriptor from the index (backward-shift deletion)
+ */
+static void eraseWatch(CgroupTreeMonitor *monitor, int wd) {
+    uint32_t mask = monitor->watch_mask;
+    uint32_t b = (uint32_t)wd & mask;
+
+    while (monitor->watch_index[b] != 0 && monitor->nodes[monitor->watch_index[b] - 1].wd != wd) {
+        b = (b + 1) & mask;
+    }
+    if (monitor->watch_index[b] == 0) {
+        return;
+    }
+
+    // Pull back later entries of the run that may no longer be reachable
+    uint32_t hole = b;
+    for (uint32_t next = (b + 1) & mask; monitor->watch_index[next] != 0; next = (next + 1) & mask) {
+        uint32_t home = (uint32_t)monitor->nodes[monitor->watch_index[next] - 1].wd & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            monitor->watch_index[hole] = monitor->watch_index[next];
+            hole = next;
+        }
+    }
+    monitor->watch_index[hole] = 0;
+}
+
+/**
+ * Grow the slot array and the watch index together
+ * @return 0 on success, -1 on allocation failure
+ */
+static int growNodes(CgroupTreeMonitor *monitor) {
+    int capacity = monitor->capacity > 0 ? monitor->capacity * 2 : 256;
+    uint32_t buckets = (uint32_t)capacity * 2;
+    CgroupNode *nodes = realloc(monitor->nodes, (size_t)capacity * sizeof(*nodes));
+    if (nodes == NULL) {
+        return -1;
+    }
+    monitor->nodes = nodes;
+
+    int *index = calloc(buckets, sizeof(*index));
+    if (index == NULL) {
+        return -1;
+    }
+    free(monitor->watch_index);
+    monitor->watch_index = index;
+    monitor->watch_mask = buckets - 1;
+    monitor->capacity = capacity;
+
+    for (int i = 0; i < monitor->count; i++) {
+        if (monitor->nodes[i].path != NULL && monitor->nodes[i].wd >= 0) {
+            insertWatch(monitor, i);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Whether a group has live processes
+ * @param path Group directory
+ * @return 1 if populated (or unknown), 0 if empty
+ */
+static int readPopulated(const char *path) {
+    char buf[CGROUP_TREE_FILE_BUFFER];
+    uint64_t populated = 1;
+
+    // "populated 1\nfrozen 0\n"
+    if (readGroupFile(path, "cgroup.events", buf, sizeof(buf)) == 0 &&
+        strncmp(buf, "populated ", 10) == 0) {
+        proc_scan_u64(buf + 10, &populated);
+    }
+    return populated != 0;
+}
+
+/**
+ * Add a group and watch its directory
+ * @param monitor Source state
+ * @param path Group directory
+ * @param parent Parent slot (-1 for the root)
+ * @return New slot, or -1 on failure
+ */
+static int addGroup(CgroupTreeMonitor *monitor, const char *path, int parent) {
+    int slot = -1;
+
+    // Reuse a freed slot before growing
+    if (monitor->live < monitor->count) {
+        for (int i = 0; i < monitor->count; i++) {
+            if (monitor->nodes[i].path == NULL) {
+                slot = i;
+                break;
+            }
+        }
+    }
+    if (slot < 0) {
+        if (monitor->count == monitor->capacity && growNodes(monitor) != 0) {
+            return -1;
+        }
+        slot = monitor->count++;
+    }
+
+    CgroupNode *node = &monitor->nodes[slot];
+    memset(node, 0, sizeof(*node));
+    node->path = strdup(path);
+    if (node->path == NULL) {
+        return -1;
+    }
+    node->parent = parent;
+    node->depth = parent >= 0 ? monitor->nodes[parent].depth + 1 : 0;
+    node->populated = parent < 0 || readPopulated(path);
+
+    node->wd = inotify_add_watch(monitor->inotify_fd, path, CGROUP_TREE_WATCH);
+    if (node->wd >= 0) {
+        // The same directory watched twice returns its existing descriptor
+        int known = findWatch(monitor, node->wd);
+        if (known >= 0) {
+            free(node->path);
+            node->path = NULL;
+            return known;
+        }
+        insertWatch(monitor, slot);
+    } else if (!monitor->watch_warned) {
+        LOG_WARNING(SYS_MON_ERR_SYSTEM, "inotify watch on %s failed (%s); groups created below it will not be seen",
+                    path, strerror(errno));
+        monitor->watch_warned = 1;
+    }
+    monitor->live++;
+    return slot;
+}
+
+/**
+ * Forget a group
+ * @param monitor Source state
+ * @param slot Group slot
+ */
+static void removeGroup(CgroupTreeMonitor *monitor, int slot) {
+    CgroupNode *node = &monitor->nodes[slot];
+
+    if (node->wd >= 0) {
+        eraseWatch(monitor, node->wd);
+    }
+    free(node->path);
+    node->path = NULL;
+    monitor->live--;
+}
+
+/**
+ * Find a direct child group by name
+ * @param monitor Source state
+ * @param slot Parent slot
+ * @param name Child directory name
+ * @return Child slot, or -1 if unknown
+ */
+static int findChild(const CgroupTreeMonitor *monitor, int slot, const char *name) {
+    size_t len = strlen(monitor->nodes[slot].path);
+
+    for (int i = 0; i < monitor->count; i++) {
+        const CgroupNode *node = &monitor->nodes[i];
+        if (node->path != NULL && node->parent == slot && node->path[len] == '/' &&
+            strcmp(node->path + len + 1, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Add the groups below a group, recursively
+ * @param monitor Source state
+ * @param slot Group whose directory is walked
+ */
+static void walkGroup(CgroupTreeMonitor *monitor, int slot) {
+    char path[PATH_MAX];
+    DIR *dir = opendir(monitor->nodes[slot].path);
+    struct dirent *entry;
+
+    if (dir == NULL) {
+        return;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_type != DT_DIR || entry->d_name[0] == '.') {
+            continue;
+        }
+        if (snprintf(path, sizeof(path), "%s/%s", monitor->nodes[slot].path, entry->d_name) >= (int)sizeof(path)) {
+            continue;
+        }
+        int child = addGroup(monitor, path, slot);
+        if (child >= 0 && monitor->nodes[child].parent == slot) {
+            walkGroup(monitor, child);
+        }
+    }
+    closedir(dir);
+}
+
+/**
+ * Drop every group and walk the hierarchy from the root again
+ * @param monitor Source state
+ * @return 0 on success, -1 if the root could not be added
+ */
+static int rebuildTree(CgroupTreeMonitor *monitor) {
+    for (int i = 0; i < monitor->count; i++) {
+        if (monitor->nodes[i].path != NULL) {
+            if (monitor->nodes[i].wd >= 0) {
+                inotify_rm_watch(monitor->inotify_fd, monitor->nodes[i].wd);
+            }
+            removeGroup(monitor, i);
+        }
+    }
+    monitor->count = 0;
+    monitor->cursor = 0;
+    if (monitor->watch_index != NULL) {
+        memset(monitor->watch_index, 0, (monitor->watch_mask + 1) * sizeof(*monitor->watch_index));
+    }
+
+    int root = addGroup(monitor, monitor->mount, -1);
+    if (root < 0) {
+        return -1;
+    }
+    walkGroup(monitor, root);
+    return 0;
+}
+
+/**
+ * Apply the pending inotify events
+ * @param monitor Source state
+ */
+static void drainGroupEvents(CgroupTreeMonitor *monitor) {
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    char path[PATH_MAX];
+
+    for (int reads = 0; reads < CGROUP_TREE_EVENT_READS; reads++) {
+        ssize_t n = read(monitor->inotify_fd, buf, sizeof(buf));
+        if (n <= 0) {
+            break;      // EAGAIN: nothing pending
+        }
+
+        for (char *p = buf; p < buf + n; ) {
+            const struct inotify_event *event = (const struct inotify_event *)p;
+            p += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                monitor->rescan = 1;
+                continue;
+            }
+            int slot = findWatch(monitor, event->wd);
+            if (slot < 0) {
+                continue;
+            }
+
+            if (event->mask & IN_IGNORED) {
+                // The watch is gone (the mount went away): stop tracking the group
+                eraseWatch(monitor, event->wd);
+                monitor->nodes[slot].wd = -1;
+                removeGroup(monitor, slot);
+                monitor->removed++;
+            } else if ((event->mask & (IN_DELETE | IN_ISDIR)) == (IN_DELETE | IN_ISDIR) && event->len > 0) {
+                // Groups can only be removed once they have no children
+                int child = findChild(monitor, slot, event->name);
+                if (child >= 0) {
+                    if (monitor->nodes[child].wd >= 0) {
+                        inotify_rm_watch(monitor->inotify_fd, monitor->nodes[child].wd);
+                    }
+                    removeGroup(monitor, child);
+                    monitor->removed++;
+                }
+            } else if ((event->mask & (IN_CREATE | IN_ISDIR)) == (IN_CREATE | IN_ISDIR) && event->len > 0) {
+                if (snprintf(path, sizeof(path), "%s/%s", monitor->nodes[slot].path, event->name) < (int)sizeof(path)) {
+                    int live = monitor->live;
+                    int child = addGroup(monitor, path, slot);
+                    if (child >= 0 && monitor->nodes[child].parent == slot) {
+                        // Its own children may predate the watch
+                        walkGroup(monitor, child);
+                        monitor->created += monitor->live - live;
+                    }
+                }
+            } else if ((event->mask & IN_MODIFY) && event->len > 0 &&
+                       strcmp(event->name, "cgroup.events") == 0) {
+                CgroupNode *node = &monitor->nodes[slot];
+                node->populated = readPopulated(node->path);
+                if (!node->populated) {
+                    node->cpu_cores = 0.0f;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Read the figures of one group
+ * @param node Group to read
+ * @param now_ns Current time
+ */
+static void readGroup(CgroupNode *node, uint64_t now_ns) {
+    char buf[CGROUP_TREE_FILE_BUFFER];
+    uint64_t value;
+
+    // "usage_usec 123\n..."
+    if (readGroupFile(node->path, "cpu.stat", buf, sizeof(buf)) == 0 &&
+        strncmp(buf, "usage_usec ", 11) == 0 && proc_scan_u64(buf + 11, &value) != NULL) {
+        if (node->read_ns != 0 && value >= node->usage_usec && now_ns > node->read_ns) {
+            node->cpu_cores = (float)((value - node->usage_usec) * 1000.0 / (now_ns - node->read_ns));
+        }
+        node->usage_usec = value;
+        node->read_ns = now_ns;
+    }
+
+    if (readGroupFile(node->path, "memory.current", buf, sizeof(buf)) == 0 &&
+        proc_scan_u64(buf, &value) != NULL) {
+        node->memory_current = value;
+    }
+
+    // "some avg10=1.87 avg60=..."
+    for (int r = 0; r < CGROUP_TREE_PRESSURES; r++) {
+        uint64_t whole, hundredths;
+        const char *p;
+        node->pressure[r] = 0.0f;
+        if (readGroupFile(node->path, cgroup_tree_pressures[r], buf, sizeof(buf)) == 0 &&
+            strncmp(buf, "some avg10=", 11) == 0 &&
+            (p = proc_scan_u64(buf + 11, &whole)) != NULL && *p == '.' &&
+            proc_scan_u64(p + 1, &hundredths) != NULL) {
+            node->pressure[r] = (float)whole + (float)hundredths / 100.0f;
+        }
+    }
+}
+
+/**
+ * Whether a group ranks above another (more CPU, then more memory)
+ */
+static int groupBusier(const CgroupNode *a, const CgroupNode *b) {
+    return a->cpu_cores > b->cpu_cores ||
+           (a->cpu_cores == b->cpu_cores && a->memory_current > b->memory_current);
+}
+
+/**
+ * Compare two paths in tree order: a group sorts right before its children
+ */
+static int compareTreePaths(const char *a, const char *b) {
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    int ca = *a == '/' ? 1 : (unsigned char)*a;
+    int cb = *b == '/' ? 1 : (unsigned char)*b;
+    return ca - cb;
+}
+
+// Monitor being sorted (qsort has no context argument)
+static const CgroupTreeMonitor *sorting_monitor;
+
+/**
+ * Order slots by tree position
+ */
+static int compareTreeSlots(const void *a, const void *b) {
+    return compareTreePaths(sorting_monitor->nodes[*(const int *)a].path,
+                            sorting_monitor->nodes[*(const int *)b].path);
+}
+
+/**
+ * Cgroup tree source: apply events, read a budget of groups and list the busiest
+ * @param state Source state
+ * @param snapshot Snapshot being assembled
+ * @return 0 on success, -1 if the tree is empty
+ */
+static int cgroupTreeSourceCollect(void *state, SystemSnapshot *snapshot) {
+    CgroupTreeMonitor *monitor = state;
+    CgroupTreeSample *sample = &snapshot->cgroup_tree;
+    uint64_t now_ns = cgroupTreeClockNs();
+    int top[CGROUP_TREE_TOP_COUNT];
+    int ranked = 0;
+
+    drainGroupEvents(monitor);
+    if (monitor->rescan) {
+        LOG_WARNING(SYS_MON_ERR_SYSTEM, "cgroup events were lost, walking %s again", monitor->mount);
+        monitor->rescan = 0;
+        if (rebuildTree(monitor) != 0) {
+            return -1;
+        }
+    }
+
+    memset(sample, 0, sizeof(*sample));
+    sample->created = monitor->created;
+    sample->removed = monitor->removed;
+    monitor->created = monitor->removed = 0;
+
+    // Refresh up to the budget, round-robin; empty groups are read once
+    for (int visited = 0; visited < monitor->count && sample->read < CGROUP_TREE_READ_BUDGET; visited++) {
+        CgroupNode *node = &monitor->nodes[monitor->cursor];
+        monitor->cursor = (monitor->cursor + 1) % monitor->count;
+        if (node->path != NULL && (node->populated || node->read_ns == 0)) {
+            readGroup(node, now_ns);
+            sample->read++;
+        }
+    }
+
+    // Rank every known group on its latest figures
+    for (int i = 0; i < monitor->count; i++) {
+        const CgroupNode *node = &monitor->nodes[i];
+        if (node->path == NULL) {
+            continue;
+        }
+        sample->groups++;
+        sample->populated += node->populated;
+
+        int slot = ranked;
+        if (slot == CGROUP_TREE_TOP_COUNT) {
+            if (!groupBusier(node, &monitor->nodes[top[slot - 1]])) {
+                continue;
+            }
+            slot--;
+        } else {
+            ranked++;
+        }
+        while (slot > 0 && groupBusier(node, &monitor->nodes[top[slot - 1]])) {
+            top[slot] = top[slot - 1];
+            slot--;
+        }
+        top[slot] = i;
+    }
+
+    // List the selection in tree order
+    sorting_monitor = monitor;
+    qsort(top, (size_t)ranked, sizeof(int), compareTreeSlots);
+    for (int i = 0; i < ranked; i++) {
+        const CgroupNode *node = &monitor->nodes[top[i]];
+        CgroupTreeEntry *entry = &sample->top[i];
+        const char *relative = node->path + monitor->mount_len;
+        size_t len = strlen(relative);
+
+        if (len == 0) {
+            relative = "/";
+            len = 1;
+        }
+        if (len >= sizeof(entry->path)) {
+            // Keep the tail, which names the group
+            snprintf(entry->path, sizeof(entry->path), "...%s", relative + len - (sizeof(entry->path) - 4));
+        } else {
+            memcpy(entry->path, relative, len + 1);
+        }
+        entry->depth = node->depth;
+        entry->populated = node->populated;
+        entry->cpu_cores = node->cpu_cores;
+        entry->memory_current = node->memory_current;
+        memcpy(entry->pressure, node->pressure, sizeof(entry->pressure));
+    }
+    sample->count = ranked;
+
+    TRACE_DEBUG("Cgroup tree: %d groups, %d read, +%d -%d", sample->groups, sample->read,
+                sample->created, sample->removed);
+    return sample->groups > 0 ? 0 : -1;
+}
+
+/**
+ * Cgroup tree source: walk the hierarchy and set up the watches
+ * @param state Output state
+ * @return 0 on success, -1 without cgroup v2
+ */
+static int cgroupTreeSourceInit(void **state) {
+    CgroupTreeMonitor *monitor = calloc(1, sizeof(*monitor));
+    char root[PATH_MAX];
+
+    if (monitor == NULL) {
+        return -1;
+    }
+    if (cgroupFindMount(monitor->mount, root) != 0) {
+        LOG_WARNING(SYS_MON_ERR_PLATFORM, "No cgroup v2 hierarchy mounted");
+        free(monitor);
+        return -1;
+    }
+    monitor->mount_len = strlen(monitor->mount);
+    monitor->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (monitor->inotify_fd < 0 || growNodes(monitor) != 0 || rebuildTree(monitor) != 0) {
+        if (monitor->inotify_fd >= 0) {
+            close(monitor->inotify_fd);
+        }
+        free(monitor->nodes);
+        free(monitor->watch_index);
+        free(monitor);
+        return -1;
+    }
+    monitor->created = 0;
+    *state = monitor;
+    return 0;
+}
+
+/**
+ * Cgroup tree source: drop the watches and the tree
+ * @param state Source state
+ */
+static void cgroupTreeSourceTeardown(void *state) {
+    CgroupTreeMonitor *monitor = state;
+
+    close(monitor->inotify_fd);
+    for (int i = 0; i < monitor->count; i++) {
+        free(monitor->nodes[i].path);
+    }
+    free(monitor->nodes);
+    free(monitor->watch_index);
+    free(monitor);
+}
+#else
+/**
+ * Cgroup tree source: cgroups are Linux-only
+ * @param state Unused
+ * @return -1
+ */
+static int cgroupTreeSourceInit(void **state) {
+    (void)state;
+    return -1;
+}
+
+/**
+ * Cgroup tree source: never called without init
+ * @param state Unused
+ * @param snapshot Unused
+ * @return -1
+ */
+static int cgroupTreeSourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    (void)snapshot;
+    return -1;
+}
+
+/**
+ * Cgroup tree source: nothing to release
+ * @param state Unused
+ */
+static void cgroupTreeSourceTeardown(void *state) {
+    (void)state;
+}
+#endif
+
+/**
+ * Cgroup tree source: description
+ * @return Static string
+ */
+static const char *cgroupTreeSourceDescribe(void) {
+    return "cgroup v2 hierarchy (inotify discovery, budgeted per-group reads)";
+}
+
+const MetricSource cgroupTreeMetricSource = {
+    .name = "cgroup-tree",
+    .section = METRIC_CGROUP_TREE,
+    .period_ms = 0,
+    .init = cgroupTreeSourceInit,
+    .collect = cgroupTreeSourceCollect,
+    .teardown = cgroupTreeSourceTeardown,
+    .describe = cgroupTreeSourceDescribe
+};
+
+/**
+ * Cgroup tree sample formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatCgroupTree(const CgroupTreeSample *sample, char *buffer, size_t size) {
+    size_t used = 0;
+    int lines = 0;
+    int len;
+
+    len = snprintf(buffer, size, "%d groups, %d populated, %d read this sample (+%d -%d)\n",
+                   sample->groups, sample->populated, sample->read, sample->created, sample->removed);
+    if (len < 0 || (size_t)len >= size) {
+        return 0;
+    }
+    used = (size_t)len;
+    lines++;
+
+    for (int i = 0; i < sample->count; i++) {
+        const CgroupTreeEntry *entry = &sample->top[i];
+        int indent = entry->depth < 8 ? entry->depth * 2 : 16;
+        len = snprintf(buffer + used, size - used, "%*s%-*s %6.2f %9.1f | %6.2f %6.2f %6.2f%s\n",
+                       indent, "", 48 - indent > 8 ? 48 - indent : 8, entry->path,
+                       entry->cpu_cores, entry->memory_current / (1024.0 * 1024.0),
+                       entry->pressure[0], entry->pressure[1], entry->pressure[2],
+                       entry->populated ? "" : " (empty)");
+        if (len < 0 || (size_t)len >= size - used) {
+            buffer[used] = '\0';
+            break;
+        }
+        used += (size_t)len;
+        lines++;
+    }
+    return lines;
+}
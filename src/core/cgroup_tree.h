@@ -0,0 +1,67 @@
+#ifndef CGROUP_TREE_H
+#define CGROUP_TREE_H
+
+#include "../utils/common.h"
+#include <stdint.h>
+
+// Groups kept in the cgroup tree section
+#define CGROUP_TREE_TOP_COUNT 24
+
+// Group path length kept per entry, including the NUL (longer paths keep their tail)
+#define CGROUP_TREE_PATH_LENGTH 96
+
+// Groups whose files are read per sample; the rest wait for their turn
+#define CGROUP_TREE_READ_BUDGET 256
+
+// Text buffer for the formatted cgroup tree section
+#define CGROUP_TREE_TEXT_BUFFER 4096
+
+/**
+ * Pressure resources reported per group (cpu.pressure, memory.pressure, io.pressure)
+ */
+#define CGROUP_TREE_PRESSURES 3
+
+/**
+ * One group of the cgroup tree section
+ */
+typedef struct {
+    char path[CGROUP_TREE_PATH_LENGTH];     // Path below the hierarchy root ("/" for the root)
+    int32_t depth;                          // 0 for the root
+    int32_t populated;                      // Has live processes (cgroup.events)
+    float cpu_cores;                        // Cores used since the group's previous read
+    uint64_t memory_current;                // Bytes charged (0 for the root group)
+    float pressure[CGROUP_TREE_PRESSURES];  // "some" avg10 of cpu, memory and io (%)
+} CgroupTreeEntry;
+
+/**
+ * Cgroup tree section: every group of the cgroup v2 hierarchy
+ *
+ * The busiest groups by CPU (then memory) are listed in tree order, so a
+ * group appears right after its parent when both are listed.
+ */
+typedef struct {
+    int32_t groups;             // Groups known
+    int32_t populated;          // Groups with live processes
+    int32_t read;               // Groups whose files were read this sample
+    int32_t created;            // Groups discovered since the previous sample
+    int32_t removed;            // Groups removed since the previous sample
+    int32_t count;              // Entries in top
+    CgroupTreeEntry top[CGROUP_TREE_TOP_COUNT];
+} CgroupTreeSample;
+
+/**
+ * Cgroup tree sample formatting function
+ *
+ * Formats a summary line followed by one indented line per listed group.
+ *
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatCgroupTree(const CgroupTreeSample *sample, char *buffer, size_t size);
+
+// Cgroup tree section title
+#define CGROUP_TREE_TITLE "### Cgroup tree ### (Group cores memMB | some avg10 % cpu mem io)"
+
+#endif // CGROUP_TREE_H
@@ -0,0 +1,305 @@
+#include "collector.h"
+#include "../utils/error.h"
+
+/**
+ * Collect every source that is due at this tick
+ * @param engine Collector engine
+ * @param elapsed_ms Time of this tick relative to the epoch
+ */
+static void collectBatch(CollectorEngine *engine, uint64_t elapsed_ms) {
+    SystemSnapshot *snapshot = &engine->working;
+
+    snapshot->updated = 0;
+    for (int i = 0; i < engine->source_count; i++) {
+        const MetricSource *source = engine->sources[i];
+        if (elapsed_ms < engine->next_due_ms[i]) {
+            continue;
+        }
+
+        if (source->collect(engine->state[i], snapshot) == 0) {
+            snapshot->updated |= 1u << source->section;
+        }
+
+        // Keep periodic sources on their own grid even after a missed tick
+        do {
+            engine->next_due_ms[i] += (uint64_t)source->period_ms;
+        } while (source->period_ms > 0 && engine->next_due_ms[i] <= elapsed_ms);
+    }
+}
+
+/**
+ * Have the scheduler watch the event descriptors of the enabled sources
+ * @param engine Collector engine
+ * @param sched Sampling scheduler
+ * @param watch_source Output: source index of each watch slot
+ */
+static void watchSourceEvents(CollectorEngine *engine, Scheduler *sched, int *watch_source) {
+    for (int i = 0; i < engine->source_count; i++) {
+        const MetricSource *source = engine->sources[i];
+        int fds[SCHEDULER_MAX_WATCH];
+        if (source->event_fds == NULL) {
+            continue;
+        }
+
+        int count = source->event_fds(engine->state[i], fds, SCHEDULER_MAX_WATCH - sched->watch_count);
+        for (int j = 0; j < count; j++) {
+            int slot = schedulerWatch(sched, fds[j], POLLPRI);
+            if (slot >= 0) {
+                watch_source[slot] = i;
+            }
+        }
+    }
+}
+
+/**
+ * Collect the sources whose event descriptors signalled during the last wait
+ * Sources already collected in this snapshot are only flagged.
+ * @param engine Collector engine
+ * @param sched Sampling scheduler
+ * @param watch_source Source index of each watch slot
+ */
+static void collectSignalled(CollectorEngine *engine, Scheduler *sched, const int *watch_source) {
+    SystemSnapshot *snapshot = &engine->working;
+    unsigned int pending = 0;   // Source indices
+
+    for (int w = 0; w < sched->watch_count; w++) {
+        short revents = sched->watch[w].revents;
+        if (revents & (POLLERR | POLLNVAL)) {
+            // A broken descriptor would wake the thread forever: stop watching it
+            LOG_WARNING(SYS_MON_ERR_SYSTEM, "Metric source '%s' event descriptor failed, no longer watched",
+                        engine->sources[watch_source[w]]->name);
+            sched->watch[w].fd = -1;
+        } else if (revents & POLLPRI) {
+            pending |= 1u << watch_source[w];
+        }
+    }
+
+    for (int i = 0; i < engine->source_count; i++) {
+        const MetricSource *source = engine->sources[i];
+        unsigned int bit = 1u << source->section;
+        if (!(pending & (1u << i))) {
+            continue;
+        }
+
+        if (!(snapshot->updated & bit) && source->collect(engine->state[i], snapshot) == 0) {
+            snapshot->updated |= bit;
+        }
+        snapshot->signalled |= bit;
+    }
+}
+
+/**
+ * Sampling thread
+ * @param arg Collector engine
+ * @return NULL
+ */
+static void *samplingThread(void *arg) {
+    CollectorEngine *engine = arg;
+    Scheduler sched;
+    int watch_source[SCHEDULER_MAX_WATCH];
+    int produced = 0;
+
+    if (schedulerInit(&sched, &engine->epoch, engine->interval_ms, engine->stop_pipe[0]) != 0) {
+        LOG_ERROR(SYS_MON_ERR_SYSTEM, "Failed to create sampling timer: %s", strerror(errno));
+        spsc_ring_close(&engine->ring);
+        return NULL;
+    }
+    watchSourceEvents(engine, &sched, watch_source);
+
+    while (engine->samples <= 0 || produced < engine->samples) {
+        int missed = schedulerWait(&sched);
+        if ((missed < 0 && missed != SCHEDULER_EVENT) || engine->stop) {
+            break;
+        }
+
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        SystemSnapshot *snapshot = &engine->working;
+        int between_ticks = missed == SCHEDULER_EVENT;
+        if (between_ticks) {
+            snapshot->updated = 0;
+            missed = 0;
+        } else {
+            collectBatch(engine, sched.ticks * (uint64_t)engine->interval_ms);
+            produced++;
+        }
+        snapshot->signalled = 0;
+        collectSignalled(engine, &sched, watch_source);
+        if (between_ticks && snapshot->updated == 0) {
+            continue;
+        }
+
+        snapshot->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+        snapshot->tick = sched.ticks;
+        snapshot->missed = missed;
+        snapshot->between_ticks = between_ticks;
+
+        // A full ring drops the snapshot rather than stalling sampling
+        spsc_ring_push(&engine->ring, snapshot);
+    }
+
+    engine->missed = sched.missed;
+    schedulerClose(&sched);
+    spsc_ring_close(&engine->ring);
+    return NULL;
+}
+
+/**
+ * Initialize the enabled sources
+ * @param engine Engine being started
+ */
+static void initSources(CollectorEngine *engine) {
+    int count = metricSourceCount();
+
+    for (int i = 0; i < count; i++) {
+        const MetricSource *source = metricSourceAt(i);
+        if (!(engine->mask & (1u << source->section))) {
+            continue;
+        }
+
+        void *state = NULL;
+        if (source->init != NULL && source->init(&state) != 0) {
+            LOG_WARNING(SYS_MON_ERR_SYSTEM, "Metric source '%s' failed to initialize, skipping",
+                        source->name);
+            continue;
+        }
+
+        int slot = engine->source_count++;
+        engine->sources[slot] = source;
+        engine->state[slot] = state;
+        engine->next_due_ms[slot] = 0;
+        LOG_DEBUG(SYS_MON_SUCCESS, "Metric source '%s': %s", source->name,
+                  source->describe != NULL ? source->describe() : "");
+    }
+}
+
+/**
+ * Start the collector engine
+ * @param engine Engine to start
+ * @param samples Number of ticks to sample (<= 0: unbounded)
+ * @param interval_ms Sampling interval (milliseconds)
+ * @param mask Sections to collect
+ * @return STATUS_SUCCESS, or an error status
+ */
+int collectorStart(CollectorEngine *engine, int samples, int interval_ms, unsigned int mask) {
+    memset(engine, 0, sizeof(*engine));
+    engine->samples = samples;
+    engine->interval_ms = interval_ms;
+    engine->mask = mask;
+    engine->stop_pipe[0] = engine->stop_pipe[1] = -1;
+
+    if (pipe(engine->stop_pipe) != 0) {
+        LOG_ERROR(SYS_MON_ERR_PIPE, "Failed to create stop pipe: %s", strerror(errno));
+        return STATUS_ERROR_PIPE;
+    }
+    fcntl(engine->stop_pipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(engine->stop_pipe[1], F_SETFD, FD_CLOEXEC);
+
+    if (spsc_ring_create(&engine->ring, sizeof(SystemSnapshot), SNAPSHOT_RING_CAPACITY) != 0) {
+        LOG_ERROR(SYS_MON_ERR_SYSTEM, "Failed to create snapshot ring: %s", strerror(errno));
+        collectorStop(engine);
+        return STATUS_ERROR_MEMORY;
+    }
+
+    // Source init takes the baselines (e.g. CPU counters) at tick 0
+    initSources(engine);
+    clock_gettime(CLOCK_MONOTONIC, &engine->epoch);
+
+    // The sampling thread inherits this mask: keep terminal signals on the display thread
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTSTP);
+    sigaddset(&blocked, SIGCONT);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+
+    int status = STATUS_SUCCESS;
+    if (pthread_create(&engine->thread, NULL, samplingThread, engine) != 0) {
+        LOG_ERROR(SYS_MON_ERR_SYSTEM, "Failed to create sampling thread");
+        status = STATUS_ERROR_FORK;
+    } else {
+        engine->started = 1;
+    }
+
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (status != STATUS_SUCCESS) {
+        collectorStop(engine);
+    }
+    return status;
+}
+
+/**
+ * Receive the next snapshot
+ * @param engine Running engine
+ * @param snapshot Output snapshot
+ * @return 0 on success, -1 if the engine has finished or was stopped
+ */
+int collectorReceive(CollectorEngine *engine, SystemSnapshot *snapshot) {
+    for (;;) {
+        if (spsc_ring_pop(&engine->ring, snapshot) == 0) {
+            return 0;
+        }
+        if (engine->stop || spsc_ring_finished(&engine->ring)) {
+            return -1;
+        }
+        spsc_ring_wait(&engine->ring, -1);
+    }
+}
+
+/**
+ * Make a blocked collectorReceive return -1
+ * @param engine Running engine
+ */
+void collectorInterrupt(CollectorEngine *engine) {
+    engine->stop = 1;
+    if (engine->ring.hdr != NULL) {
+        spsc_ring_wake(&engine->ring);
+    }
+}
+
+/**
+ * Stop the collector engine, join its thread and tear down its sources
+ * @param engine Engine to stop
+ */
+void collectorStop(CollectorEngine *engine) {
+    collectorInterrupt(engine);
+
+    // Closing the write end makes the read end readable for the scheduler
+    if (engine->stop_pipe[1] >= 0) {
+        close(engine->stop_pipe[1]);
+        engine->stop_pipe[1] = -1;
+    }
+
+    if (engine->started) {
+        pthread_join(engine->thread, NULL);
+        engine->started = 0;
+    }
+
+    for (int i = 0; i < engine->source_count; i++) {
+        if (engine->sources[i]->teardown != NULL) {
+            engine->sources[i]->teardown(engine->state[i]);
+        }
+    }
+    engine->source_count = 0;
+
+    if (engine->missed > 0) {
+        LOG_WARNING(SYS_MON_ERR_SYSTEM, "Sampling missed %llu ticks (collection overran the interval)",
+                    (unsigned long long)engine->missed);
+    }
+
+    if (engine->ring.hdr != NULL) {
+        uint64_t dropped = atomic_load(&engine->ring.hdr->dropped);
+        if (dropped > 0) {
+            LOG_WARNING(SYS_MON_ERR_SYSTEM, "Dropped %llu snapshots (display too slow)",
+                        (unsigned long long)dropped);
+        }
+        spsc_ring_destroy(&engine->ring);
+    }
+
+    if (engine->stop_pipe[0] >= 0) {
+        close(engine->stop_pipe[0]);
+        engine->stop_pipe[0] = -1;
+    }
+}
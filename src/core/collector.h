@@ -0,0 +1,90 @@
+#ifndef COLLECTOR_H
+#define COLLECTOR_H
+
+#include "common.h"
+#include "spsc_ring.h"
+#include "scheduler.h"
+#include "snapshot.h"
+#include "metric_source.h"
+#include <pthread.h>
+
+// Number of snapshots the ring can hold
+#define SNAPSHOT_RING_CAPACITY 32
+
+/**
+ * Collector engine
+ *
+ * Runs one sampling thread inside the monitor process. On every tick it
+ * calls all due metric sources in one batch, stamps the assembled
+ * snapshot and publishes it into a single-producer/single-consumer ring.
+ * When a source's event descriptor signals between ticks, that source
+ * alone is collected and published right away.
+ */
+typedef struct {
+    pthread_t thread;
+    int started;                // Whether the thread was created
+    unsigned int mask;          // Enabled sections (COLLECT_* flags)
+    int samples;                // Ticks to sample (<= 0: until stopped)
+    int interval_ms;            // Sampling interval in milliseconds
+    struct timespec epoch;      // Tick 0
+    _Atomic int stop;           // Stop request
+    int stop_pipe[2];           // Read end becomes readable on stop
+    uint64_t missed;            // Missed ticks
+
+    int source_count;                               // Enabled sources
+    const MetricSource *sources[MAX_METRIC_SOURCES];
+    void *state[MAX_METRIC_SOURCES];                // Per-source state from init
+    uint64_t next_due_ms[MAX_METRIC_SOURCES];       // Next collection, ms after epoch
+
+    SystemSnapshot working;     // Snapshot being assembled (sampling thread only)
+    spsc_ring_t ring;           // Published snapshots, drained by the display
+} CollectorEngine;
+
+/**
+ * Start the collector engine
+ *
+ * Initializes every registered source whose section is selected in mask,
+ * then starts the sampling thread. Ticks fall on an absolute schedule, so
+ * sections sampled in the same batch share one timestamp. The sampling
+ * thread blocks SIGINT, SIGTSTP and SIGCONT so that those signals reach the
+ * display thread.
+ *
+ * @param engine Engine to start
+ * @param samples Number of ticks to sample (<= 0: unbounded)
+ * @param interval_ms Sampling interval (milliseconds)
+ * @param mask Sections to collect (COLLECT_* flags)
+ * @return STATUS_SUCCESS, or an error status
+ */
+int collectorStart(CollectorEngine *engine, int samples, int interval_ms, unsigned int mask);
+
+/**
+ * Receive the next snapshot
+ *
+ * Blocks until the ring has a snapshot. Must only be called from one
+ * consumer thread.
+ *
+ * @param engine Running engine
+ * @param snapshot Output snapshot
+ * @return 0 on success, -1 if the engine has finished or was stopped
+ */
+int collectorReceive(CollectorEngine *engine, SystemSnapshot *snapshot);
+
+/**
+ * Make a blocked collectorReceive return -1
+ *
+ * Safe to call from any thread. The sampling thread keeps running until
+ * collectorStop; call this first when the consumer runs on another thread,
+ * then join the consumer before stopping the engine.
+ *
+ * @param engine Running engine
+ */
+void collectorInterrupt(CollectorEngine *engine);
+
+/**
+ * Stop the collector engine, join its thread and tear down its sources
+ *
+ * @param engine Engine to stop
+ */
+void collectorStop(CollectorEngine *engine);
+
+#endif // COLLECTOR_H
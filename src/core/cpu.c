@@ -1,37 +1,272 @@
 #include "cpu.h"
+#include "metric_source.h"
 #include "../platform/platform.h"
 #include "../utils/error.h"
-#include <signal.h>
+#include "../utils/trace.h"
 
-// Global variables for storing previous CPU statistics
-static unsigned long prev_cpu_usage[7] = {0};
-static int first_run = 1;
+// sysinfo() load averages are fixed point with this many fraction bits
+#ifndef SI_LOAD_SHIFT
+#define SI_LOAD_SHIFT 16
+#endif
 
 /**
- * Function to collect CPU information and send through pipe
- * @param pipe_fd Pipe file descriptor array
+ * CPU source state
+ *
+ * Two counter blocks are used in turn: one holds the reading that ends the
+ * previous interval, the other receives the new one. Both share a single
+ * /proc/stat reader, handed over to whichever block is being filled.
  */
-void storeCPUInfo(int pipe_fd[2]) {
-    unsigned long cpu_usage[7] = {0};
+typedef struct {
+    cpu_counters_t samples[2];  // Alternating counter blocks
+    int current;                // Block holding the previous reading
+    int has_previous;           // samples[current] is valid
+    uint64_t read_ns;           // CLOCK_MONOTONIC time of the previous reading
+} CPUSourceState;
+
+/**
+ * Current CLOCK_MONOTONIC time
+ * @return Nanoseconds
+ */
+static uint64_t cpuClockNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Per-second rate of a cumulative counter
+ * @param curr Counter now
+ * @param prev Counter at the start of the interval
+ * @param seconds Interval length
+ * @return Rate, 0 if the counter went backwards
+ */
+static float counterRate(uint64_t curr, uint64_t prev, double seconds) {
+    return curr >= prev ? (float)((double)(curr - prev) / seconds) : 0.0f;
+}
+
+/**
+ * Convert one set of counter deltas into busy and per-field percentages
+ * @param delta Per-field tick deltas
+ * @param share Output per-field percentages
+ * @return Busy percentage
+ */
+static double deltaToShares(const uint64_t delta[CPU_STAT_FIELDS], double share[CPU_STAT_FIELDS]) {
+    uint64_t total = 0;
     
-    // Get CPU statistics using platform-independent function
-    get_cpu_stats(cpu_usage);
+    // Guest time is already part of user/nice
+    for (int f = 0; f < CPU_FIELD_GUEST; f++) {
+        total += delta[f];
+    }
     
-    // Debug output: Log CPU statistics values
-    printf("CPU Raw Data: User=%lu Nice=%lu System=%lu Idle=%lu\n",
-           cpu_usage[0], cpu_usage[1], cpu_usage[2], cpu_usage[3]);
+    if (total == 0) {
+        for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+            share[f] = 0.0;
+        }
+        return 0.0;
+    }
     
-    // Send information through pipe
-    ssize_t bytes_written = write(pipe_fd[1], &cpu_usage, sizeof(cpu_usage));
-    if (bytes_written == -1) {
-        perror("Error writing to pipe from storeCPUInfo");
-        kill(getpid(), SIGTERM);
-        kill(getppid(), SIGTERM);
-        close(pipe_fd[1]);
-        exit(EXIT_FAILURE);
+    for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+        share[f] = (double)delta[f] * 100.0 / total;
     }
     
-    printf("CPU statistics data transmitted: %zd bytes\n", bytes_written);
+    uint64_t idle = delta[CPU_FIELD_IDLE] + delta[CPU_FIELD_IOWAIT];
+    return (double)(total - idle) * 100.0 / total;
+}
+
+/**
+ * Per-core usage over the interval between two readings
+ *
+ * Both blocks are sorted by core id, so cores are matched with a single
+ * merge walk; hot-plugged cores start without a baseline.
+ *
+ * @param prev Reading at the start of the interval, or NULL without one
+ * @param curr Reading at the end of the interval
+ * @param cores Output per-core usage
+ */
+static void computeCoreUsage(const cpu_counters_t *prev, const cpu_counters_t *curr, CPUCoreSample *cores) {
+    uint64_t delta[CPU_STAT_FIELDS];
+    double share[CPU_STAT_FIELDS];
+    int count = curr->count < CPU_MAX_CORES ? curr->count : CPU_MAX_CORES;
+    int p = 0;
+    
+    cores->busiest = -1;
+    cores->busiest_iowait = 0.0f;
+    cores->busiest_steal = 0.0f;
+    for (int c = 0; c < count; c++) {
+        int id = curr->core_id[c];
+        int matched = 0;
+        
+        if (prev != NULL) {
+            while (p < prev->count && prev->core_id[p] < id) {
+                p++;
+            }
+            matched = p < prev->count && prev->core_id[p] == id;
+        }
+        
+        for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+            uint64_t now = curr->ticks[f][c];
+            delta[f] = matched && now >= prev->ticks[f][p] ? now - prev->ticks[f][p] : 0;
+        }
+        
+        cores->id[c] = id;
+        cores->usage[c] = (float)deltaToShares(delta, share);
+        if (cores->busiest < 0 || cores->usage[c] > cores->usage[cores->busiest]) {
+            cores->busiest = c;
+            cores->busiest_iowait = (float)share[CPU_FIELD_IOWAIT];
+            cores->busiest_steal = (float)share[CPU_FIELD_STEAL];
+        }
+    }
+    cores->count = count;
+}
+
+/**
+ * Scheduler activity over the interval between two readings
+ * @param prev Reading at the start of the interval, or NULL without one
+ * @param curr Reading at the end of the interval
+ * @param seconds Interval length
+ * @param activity Output activity
+ */
+static void computeActivity(const cpu_counters_t *prev, const cpu_counters_t *curr,
+                            double seconds, CPUActivity *activity) {
+    struct sysinfo info;
+
+    memset(activity, 0, sizeof(*activity));
+    if (curr->has_activity) {
+        activity->valid = 1;
+        activity->procs_running = (uint32_t)curr->activity.procs_running;
+        activity->procs_blocked = (uint32_t)curr->activity.procs_blocked;
+        if (prev != NULL && prev->has_activity && seconds > 0.0) {
+            activity->ctxt_rate = counterRate(curr->activity.ctxt, prev->activity.ctxt, seconds);
+            activity->intr_rate = counterRate(curr->activity.intr, prev->activity.intr, seconds);
+            activity->fork_rate = counterRate(curr->activity.processes, prev->activity.processes, seconds);
+        }
+    }
+
+    // One syscall; /proc/loadavg would need another file read
+    if (sysinfo(&info) == 0) {
+        for (int i = 0; i < 3; i++) {
+            activity->load[i] = (float)info.loads[i] / (float)(1 << SI_LOAD_SHIFT);
+        }
+        activity->tasks = info.procs;
+    }
+}
+
+/**
+ * CPU source: take the baseline reading for the first interval
+ * @param state Output state (last reading)
+ * @return 0 on success, -1 on failure
+ */
+static int cpuSourceInit(void **state) {
+    CPUSourceState *source = calloc(1, sizeof(*source));
+
+    if (source == NULL) {
+        return -1;
+    }
+    source->has_previous = get_cpu_core_stats(&source->samples[0]) >= 0;
+    source->read_ns = cpuClockNs();
+    *state = source;
+    return 0;
+}
+
+/**
+ * CPU source: read every cpu line and the activity lines once, and derive
+ * the aggregate counters, per-core usage and activity of the interval
+ * @param state Last reading
+ * @param snapshot Snapshot being assembled
+ * @return 0
+ */
+static int cpuSourceCollect(void *state, SystemSnapshot *snapshot) {
+    CPUSourceState *source = state;
+    CPUSample *cpu = &snapshot->cpu;
+    cpu_counters_t *prev = &source->samples[source->current];
+    cpu_counters_t *curr = &source->samples[source->current ^ 1];
+    uint64_t now_ns;
+
+    // Both blocks share one reader: hand it over to the block being filled
+    if (curr->source == NULL) {
+        curr->source = prev->source;
+        prev->source = NULL;
+    }
+
+    if (get_cpu_core_stats(curr) < 0) {
+        // Keep the previous reading as the baseline of the next interval
+        memset(cpu, 0, sizeof(*cpu));
+        cpu->cores.busiest = -1;
+        return 0;
+    }
+    now_ns = cpuClockNs();
+    if (!source->has_previous) {
+        prev = NULL;
+    }
+
+    for (int i = 0; i < 7; i++) {
+        cpu->curr[i] = (unsigned long)curr->total[i];
+        cpu->prev[i] = prev != NULL ? (unsigned long)prev->total[i] : cpu->curr[i];
+    }
+    TRACE_DEBUG("CPU Raw Data: User=%lu Nice=%lu System=%lu Idle=%lu",
+                cpu->curr[0], cpu->curr[1], cpu->curr[2], cpu->curr[3]);
+
+    computeCoreUsage(prev, curr, &cpu->cores);
+    computeActivity(prev, curr, (double)(now_ns - source->read_ns) / 1e9, &cpu->activity);
+
+    source->current ^= 1;
+    source->has_previous = 1;
+    source->read_ns = now_ns;
+    return 0;
+}
+
+/**
+ * CPU source: release state
+ * @param state Last reading
+ */
+static void cpuSourceTeardown(void *state) {
+    CPUSourceState *source = state;
+
+    cpu_counters_free(&source->samples[0]);
+    cpu_counters_free(&source->samples[1]);
+    free(source);
+}
+
+/**
+ * CPU source: description
+ * @return Static string
+ */
+static const char *cpuSourceDescribe(void) {
+    return "aggregate and per-core CPU time counters and scheduler activity (/proc/stat, sysinfo)";
+}
+
+const MetricSource cpuMetricSource = {
+    .name = "cpu",
+    .section = METRIC_CPU,
+    .period_ms = 0,
+    .init = cpuSourceInit,
+    .collect = cpuSourceCollect,
+    .teardown = cpuSourceTeardown,
+    .describe = cpuSourceDescribe
+};
+
+/**
+ * Format scheduler activity
+ * @param activity Activity to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written (0 without activity)
+ */
+int formatCPUActivity(const CPUActivity *activity, char *buffer, size_t size) {
+    if (!activity->valid) {
+        if (size > 0) {
+            buffer[0] = '\0';
+        }
+        return 0;
+    }
+
+    snprintf(buffer, size,
+             "load average: %.2f %.2f %.2f | running %u, blocked %u, tasks %u\n"
+             "context switches %.0f/s, interrupts %.0f/s, forks %.1f/s\n",
+             activity->load[0], activity->load[1], activity->load[2],
+             activity->procs_running, activity->procs_blocked, activity->tasks,
+             activity->ctxt_rate, activity->intr_rate, activity->fork_rate);
+    return 2;
 }
 
 /**
@@ -41,124 +276,125 @@ void storeCPUInfo(int pipe_fd[2]) {
  * @return CPU usage percentage
  */
 double calculateCPUUsage(unsigned long prevCpuUsage[7], unsigned long currCpuUsage[7]) {
-    // Check if this is the first run
-    if (first_run) {
-        // Store previous values
-        for (int i = 0; i < 7; i++) {
-            prev_cpu_usage[i] = prevCpuUsage[i];
-        }
-        first_run = 0;
-        
-        // On initial execution, the difference between current and previous values is minimal
-        // Calculate using only current values (usage vs idle)
-        unsigned long total = currCpuUsage[0] + currCpuUsage[1] + 
-                            currCpuUsage[2] + currCpuUsage[3];
-        
-        if (total == 0) return 0.0;
-        
-        double idle_percent = (double)currCpuUsage[3] * 100.0 / total;
-        double cpu_usage = 100.0 - idle_percent;
-        
-        printf("First CPU calculation (direct method): %.2f%%\n", cpu_usage);
-        return cpu_usage;
-    }
-    
-    // Previous CPU times
-    unsigned long prevUser = prevCpuUsage[0];
-    unsigned long prevNice = prevCpuUsage[1];
-    unsigned long prevSystem = prevCpuUsage[2];
-    unsigned long prevIdle = prevCpuUsage[3];
-    
-    // Current CPU times
-    unsigned long currUser = currCpuUsage[0];
-    unsigned long currNice = currCpuUsage[1];
-    unsigned long currSystem = currCpuUsage[2];
-    unsigned long currIdle = currCpuUsage[3];
-    
-    // Calculate current total CPU time
-    unsigned long currTotal = currUser + currNice + currSystem + currIdle;
+    unsigned long diff[7];
+    unsigned long totalDiff = 0;
+    unsigned long currTotal = 0;
     
-    // Debug: print raw values
-    printf("Previous CPU: User=%lu, Nice=%lu, System=%lu, Idle=%lu\n", 
-           prevUser, prevNice, prevSystem, prevIdle);
-    printf("Current CPU: User=%lu, Nice=%lu, System=%lu, Idle=%lu\n", 
-           currUser, currNice, currSystem, currIdle);
+    TRACE_DEBUG("Previous CPU: User=%lu, Nice=%lu, System=%lu, Idle=%lu, IOWait=%lu",
+                prevCpuUsage[0], prevCpuUsage[1], prevCpuUsage[2], prevCpuUsage[3], prevCpuUsage[4]);
+    TRACE_DEBUG("Current CPU: User=%lu, Nice=%lu, System=%lu, Idle=%lu, IOWait=%lu",
+                currCpuUsage[0], currCpuUsage[1], currCpuUsage[2], currCpuUsage[3], currCpuUsage[4]);
     
-    // Previous and current total CPU time
-    unsigned long prevTotal = prevUser + prevNice + prevSystem + prevIdle;
-    (void)prevTotal; // 의도적으로 사용하지 않음을 표시
-    
-    // Calculate CPU time differences
-    unsigned long userDiff = 0;
-    unsigned long niceDiff = 0;
-    unsigned long systemDiff = 0;
-    unsigned long idleDiff = 0;
-    
-    // Check if current value is greater than or equal to previous value (rare cases of inversion)
-    if (currUser >= prevUser) userDiff = currUser - prevUser;
-    if (currNice >= prevNice) niceDiff = currNice - prevNice;
-    if (currSystem >= prevSystem) systemDiff = currSystem - prevSystem;
-    if (currIdle >= prevIdle) idleDiff = currIdle - prevIdle;
+    // Calculate CPU time differences over all fields
+    // (a counter that went backwards is treated as no change)
+    for (int i = 0; i < 7; i++) {
+        diff[i] = currCpuUsage[i] >= prevCpuUsage[i] ? currCpuUsage[i] - prevCpuUsage[i] : 0;
+        totalDiff += diff[i];
+        currTotal += currCpuUsage[i];
+    }
     
-    // Total CPU time difference over interval
-    unsigned long totalDiff = userDiff + niceDiff + systemDiff + idleDiff;
+    // Time spent idle, including time idle while waiting for I/O
+    unsigned long idleDiff = diff[3] + diff[4];
     
-    // Debug: print differences
-    printf("CPU Differences: User=%lu, System=%lu, Idle=%lu, Total=%lu\n",
-           userDiff, systemDiff, idleDiff, totalDiff);
+    TRACE_DEBUG("CPU Differences: User=%lu, System=%lu, Idle=%lu, IOWait=%lu, IRQ=%lu, Total=%lu",
+                diff[0], diff[2], diff[3], diff[4], diff[5], totalDiff);
     
     // Prevent division by zero
     if (totalDiff == 0) {
-        printf("No CPU time difference. Using direct calculation.\n");
+        TRACE_INFO("No CPU time difference. Using direct calculation.");
         
         // Calculate percentage using current CPU statistics (calculate idle ratio to total, then subtract from 100%)
         if (currTotal == 0) return 0.0;
         
-        double idle_percent = (double)currIdle * 100.0 / currTotal;
+        double idle_percent = (double)(currCpuUsage[3] + currCpuUsage[4]) * 100.0 / currTotal;
         double cpu_usage = 100.0 - idle_percent;
         
-        printf("Directly calculated CPU usage: %.2f%%\n", cpu_usage);
+        TRACE_INFO("Directly calculated CPU usage: %.2f%%", cpu_usage);
         return cpu_usage;
     }
     
     // Calculate actual CPU usage (non-idle time / total time)
     double nonIdlePercent = (double)(totalDiff - idleDiff) * 100.0 / totalDiff;
     
-    // Range validation (0-100%)
-    if (nonIdlePercent < 0.0) {
-        printf("Warning: CPU usage is negative (%.2f%%). Adjusting to 0%%.\n", nonIdlePercent);
-        nonIdlePercent = 0.0;
-    } else if (nonIdlePercent > 100.0) {
-        printf("Warning: CPU usage exceeds 100%% (%.2f%%). Adjusting to 100%%.\n", nonIdlePercent);
-        nonIdlePercent = 100.0;
+    TRACE_INFO("Final CPU usage: %.2f%%", nonIdlePercent);
+    return nonIdlePercent;
+}
+
+/**
+ * Format per-core usage, eight cores per line
+ * @param cores Per-core usage from a snapshot
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines formatted
+ */
+int formatPerCoreUsage(const CPUCoreSample *cores, char *buffer, size_t size) {
+    size_t len = 0;
+    int lines = 0;
+    
+    buffer[0] = '\0';
+    if (cores->busiest >= 0) {
+        int b = cores->busiest;
+        len += snprintf(buffer, size, "busiest core: cpu%d %.1f%% (iowait %.1f%% steal %.1f%%)\n",
+                        cores->id[b], cores->usage[b], cores->busiest_iowait, cores->busiest_steal);
+        lines++;
     }
     
-    // Update previous values (for next calculation)
-    for (int i = 0; i < 7; i++) {
-        prev_cpu_usage[i] = currCpuUsage[i];
+    for (int c = 0; c < cores->count && len < size; c++) {
+        len += snprintf(buffer + len, size - len, "cpu%-3d %5.1f%%%s",
+                        cores->id[c], cores->usage[c],
+                        (c % 8 == 7 || c == cores->count - 1) ? "\n" : "  ");
+        if (c % 8 == 7 || c == cores->count - 1) {
+            lines++;
+        }
     }
     
-    printf("Final CPU usage: %.2f%%\n", nonIdlePercent);
-    return nonIdlePercent;
+    return lines;
 }
 
 /**
- * Print CPU core count
+ * Benchmark CPU statistics collection
+ * @param iterations Number of samples to take
+ * @return Average time per sample in nanoseconds
  */
-void printCPUCores(void) {
-    int num_cpu = sysconf(_SC_NPROCESSORS_ONLN);
-    printf("Number of CPU cores: %d\n", num_cpu);
+double benchmarkCPUStats(int iterations) {
+    unsigned long cpu_usage[7];
+    struct timespec start, end;
+    
+    if (iterations <= 0) {
+        return 0.0;
+    }
+    
+    // Warm up once so the persistent reader is opened outside the timed loop
+    get_cpu_stats(cpu_usage);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        get_cpu_stats(cpu_usage);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    
+    double elapsed_ns = (double)(end.tv_sec - start.tv_sec) * 1e9 +
+                        (double)(end.tv_nsec - start.tv_nsec);
+    return elapsed_ns / iterations;
 }
 
 /**
- * Set CPU usage graphics function
- * @param sequential Whether sequential mode is enabled
+ * CPU core count
+ * @return Online CPU cores
+ */
+int getCPUCores(void) {
+    return (int)sysconf(_SC_NPROCESSORS_ONLN);
+}
+
+/**
+ * Build the CPU usage graphics row of a sample
  * @param cpuArr CPU graphics array
  * @param curCpuUsage Current CPU usage
- * @param prevCpuUsage Pointer to previous CPU usage
+ * @param prevCpuUsage Pointer to previous CPU usage (updated)
  * @param sampleIndex Current sample index
+ * @return Length of the row
  */
-void setCPUGraphics(int sequential, char cpuArr[][MAX_CPU_BUFFER], float curCpuUsage, float *prevCpuUsage, int sampleIndex) {
+int buildCPUGraphics(char cpuArr[][MAX_CPU_BUFFER], float curCpuUsage, float *prevCpuUsage, int sampleIndex) {
     int default_num = 3; // Default number of bars
     int additionalBars; // Additional bars based on CPU usage
     
@@ -170,37 +406,26 @@ void setCPUGraphics(int sequential, char cpuArr[][MAX_CPU_BUFFER], float curCpuU
         additionalBars = (int)curCpuUsage - (int)(*prevCpuUsage);
     }
 
-    // Initialize string to hold CPU usage information
-    char cpuUsageStr[MAX_CPU_BUFFER] = "         "; // Include initial spacing
     default_num += additionalBars; // Update total number of bars
-    
-    // Add bars
-    for (int i = 0; i < default_num && i < (MAX_CPU_BUFFER - 50); i++) {
-        strcat(cpuUsageStr, "|");
+    if (default_num < 0) {
+        default_num = 0;
+    }
+    if (default_num > MAX_CPU_BUFFER - 50) {
+        default_num = MAX_CPU_BUFFER - 50;
     }
 
-    // Add CPU usage percentage
-    char usagePercent[50];
-    snprintf(usagePercent, sizeof(usagePercent), " %.2f%%", curCpuUsage);
-    strcat(cpuUsageStr, usagePercent);
-
-    // Store completed string in array
-    strncpy(cpuArr[sampleIndex], cpuUsageStr, MAX_CPU_BUFFER - 1);
-    cpuArr[sampleIndex][MAX_CPU_BUFFER - 1] = '\0'; // Ensure string is properly terminated
-
-    // Adjust output based on sequential mode
-    if (sequential) {
-        // In sequential mode, print CPU usage info up to current index
-        for (int j = 0; j <= sampleIndex; j++) {
-            printf("%s\n", cpuArr[j]);
-        }
-    } else {
-        // In non-sequential mode, print all CPU usage info up to current index
-        for (int k = 0; k <= sampleIndex; k++) {
-            printf("%s\n", cpuArr[k]);
-        }
+    // Initial spacing and bars are filled in place, then the percentage is appended
+    char *row = cpuArr[sampleIndex];
+    const int indent = 9;
+    memset(row, ' ', indent);
+    memset(row + indent, '|', default_num);
+    int len = indent + default_num;
+    int tail = snprintf(row + len, MAX_CPU_BUFFER - len, " %.2f%%", curCpuUsage);
+    if (tail > 0) {
+        len += tail < MAX_CPU_BUFFER - len ? tail : MAX_CPU_BUFFER - len - 1;
     }
 
     // Update previous CPU usage with current usage
     *prevCpuUsage = curCpuUsage;
-} 
\ No newline at end of file
+    return len;
+}
@@ -2,22 +2,74 @@
 #define CPU_H
 
 #include "common.h"
+#include "platform.h"
+
+#define CPU_CORE_TEXT_BUFFER 8192   // 코어별 사용률 텍스트 버퍼 크기
+#define CPU_ACTIVITY_TEXT_BUFFER 256  // 스케줄러 활동 텍스트 버퍼 크기
+#define CPU_MAX_CORES 256              // 스냅샷에 담는 최대 코어 수
+
+/**
+ * 스케줄러 활동 및 부하 정보
+ * 
+ * CPU 카운터와 같은 /proc/stat 읽기에서 얻습니다. 비율은 CPU 구간 기준이며
+ * 실행/대기 태스크 수와 부하 평균은 수집 시점의 값입니다.
+ */
+typedef struct {
+    int32_t valid;              // 활동 카운터를 읽었는지 여부
+    uint32_t procs_running;     // 실행 가능한 태스크 수
+    uint32_t procs_blocked;     // I/O 대기로 블록된 태스크 수
+    uint32_t tasks;             // 전체 태스크 수 (sysinfo procs)
+    float load[3];              // 1, 5, 15분 부하 평균
+    float ctxt_rate;            // 초당 컨텍스트 스위치
+    float intr_rate;            // 초당 인터럽트
+    float fork_rate;            // 초당 생성된 태스크
+} CPUActivity;
+
+/**
+ * 코어별 사용률
+ * 
+ * 집계 카운터와 같은 /proc/stat 읽기에서 CPU 소스가 계산합니다. 코어는
+ * cpuN 번호로 이전 구간과 매칭되므로 코어가 추가되거나 제거되어도 안전하며,
+ * 새로 켜진 코어는 다음 구간부터 사용률이 잡힙니다.
+ */
+typedef struct {
+    int32_t count;                  // 코어 수 (최대 CPU_MAX_CORES)
+    int32_t busiest;                // 가장 바쁜 코어 슬롯 (-1: 없음)
+    float busiest_iowait;           // 가장 바쁜 코어의 iowait 비율 (%)
+    float busiest_steal;            // 가장 바쁜 코어의 steal 비율 (%)
+    int32_t id[CPU_MAX_CORES];      // 슬롯별 cpuN 번호
+    float usage[CPU_MAX_CORES];     // 코어별 사용률 (%)
+} CPUCoreSample;
+
+/**
+ * 코어별 사용률 포맷 함수
+ * 
+ * @param cores 스냅샷의 코어별 사용률
+ * @param buffer 출력 버퍼 (CPU_CORE_TEXT_BUFFER 권장)
+ * @param size 버퍼 크기
+ * @return 포맷한 줄 수
+ */
+int formatPerCoreUsage(const CPUCoreSample *cores, char *buffer, size_t size);
 
 /**
- * CPU 정보 수집 및 저장 함수
+ * 스케줄러 활동 포맷 함수
  * 
- * 현재 시스템의 CPU 사용량 정보를 수집하여 파이프를 통해 전송합니다.
- * 이 함수는 자식 프로세스에서 호출되며 주기적으로 CPU 상태를 모니터링합니다.
+ * 부하 평균과 실행/대기 태스크 수, 초당 컨텍스트 스위치/인터럽트/태스크 생성
+ * 수를 두 줄로 포맷합니다.
  * 
- * @param pipe_fd CPU 정보를 전송할 파이프 파일 디스크립터
+ * @param activity 포맷할 활동 정보
+ * @param buffer 출력 버퍼 (CPU_ACTIVITY_TEXT_BUFFER 권장)
+ * @param size 버퍼 크기
+ * @return 포맷한 줄 수 (활동 정보가 없으면 0)
  */
-void storeCPUInfo(int pipe_fd[2]);
+int formatCPUActivity(const CPUActivity *activity, char *buffer, size_t size);
 
 /**
  * CPU 사용량 계산 함수
  * 
  * 이전 CPU 상태와 현재 CPU 상태를 비교하여 CPU 사용률을 계산합니다.
- * 사용자 모드, 시스템 모드, 유휴 등 다양한 CPU 상태를 고려하여 계산합니다.
+ * iowait는 유휴 시간으로, irq/softirq는 사용 시간으로 계산합니다.
+ * 상태를 저장하지 않으므로 여러 호출자가 동시에 사용할 수 있습니다.
  * 
  * @param prevCpuUsage 이전 CPU 상태 배열 (사용자, nice, 시스템, 유휴, iowait, irq, softirq)
  * @param currCpuUsage 현재 CPU 상태 배열 (사용자, nice, 시스템, 유휴, iowait, irq, softirq)
@@ -34,13 +86,28 @@ double calculateCPUUsage(unsigned long prevCpuUsage[7], unsigned long currCpuUsa
  */
 int getCPUCores(void);
 
-// CPU 코어 개수 출력 함수
-void printCPUCores(void);
-
-// CPU 사용량 그래픽 설정 함수
-void setCPUGraphics(int sequential, char cpuArr[][MAX_CPU_BUFFER], float curCpuUsage, float *prevCpuUsage, int sampleIndex);
+/**
+ * CPU 통계 수집 벤치마크 함수
+ * 
+ * get_cpu_stats를 반복 호출하여 샘플 한 번에 걸리는 평균 시간을 측정합니다.
+ * 
+ * @param iterations 반복 횟수
+ * @return 샘플당 평균 소요 시간 (나노초)
+ */
+double benchmarkCPUStats(int iterations);
 
-// CPU 정보 수집 및 표시 함수
-void printCPUInfoAndGraphics(int cpuPFD[2], int cpuCFD[2], int sequential, int index, int graphics);
+/**
+ * CPU 사용량 그래픽 생성 함수
+ * 
+ * 현재 샘플의 그래픽 행을 cpuArr에 저장만 하고 출력하지 않습니다.
+ * 막대는 memset으로 채우므로 막대 길이에 비례하는 시간만 걸립니다.
+ * 
+ * @param cpuArr CPU 그래픽 배열
+ * @param curCpuUsage 현재 CPU 사용률
+ * @param prevCpuUsage 이전 CPU 사용률 (갱신됨)
+ * @param sampleIndex 현재 샘플 인덱스
+ * @return 행의 길이
+ */
+int buildCPUGraphics(char cpuArr[][MAX_CPU_BUFFER], float curCpuUsage, float *prevCpuUsage, int sampleIndex);
 
 #endif // CPU_H 
\ No newline at end of file
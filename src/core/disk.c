@@ -0,0 +1,445 @@
+#include "disk.h"
+#include "metric_source.h"
+#include "../utils/trace.h"
+
+#ifdef __linux__
+#include "../platform/proc_file.h"
+
+// Block device majors that never reach storage (loop, RAM disk)
+#define DISK_LOOP_MAJOR 7
+#define DISK_RAM_MAJOR 1
+
+// Fields after the device name read from each line
+#define DISK_FIELDS 11
+
+// Bytes per diskstats sector (always 512, whatever the device block size)
+#define DISK_SECTOR_BYTES 512.0
+
+/**
+ * Counters kept per device
+ */
+enum {
+    DISK_READS,
+    DISK_READ_SECTORS,
+    DISK_READ_MS,
+    DISK_WRITES,
+    DISK_WRITE_SECTORS,
+    DISK_WRITE_MS,
+    DISK_IO_MS,
+    DISK_COUNTERS
+};
+
+// Position of each counter among the fields after the device name
+static const unsigned char disk_fields[DISK_COUNTERS] = { 0, 2, 3, 4, 6, 7, 9 };
+
+/**
+ * Counters of one /proc/diskstats line between samples
+ */
+typedef struct {
+    uint32_t dev;               // major << 20 | minor
+    int tracked;                // Whole disk (partitions, loop and RAM devices are skipped)
+    int line;                   // Line of the last read it appeared on
+    uint32_t generation;        // Last read it appeared in
+    uint64_t counters[DISK_COUNTERS];
+    char name[DISK_NAME_LENGTH];
+} DiskDevice;
+
+/**
+ * Disk source state
+ *
+ * Devices are kept in the order /proc/diskstats lists them, so each line
+ * is matched by comparing it with the next expected slot; the array is
+ * only searched, and then re-sorted, when devices come or go. Whether a
+ * device is a whole disk is decided once, when it first appears.
+ */
+typedef struct {
+    proc_file_t file;
+    DiskDevice *devices;
+    int count;
+    int capacity;
+    uint32_t generation;
+    uint64_t last_ns;           // CLOCK_MONOTONIC time of the previous read
+} DiskMonitor;
+
+/**
+ * Whether a device is a whole disk worth reporting
+ * @param major Device major number
+ * @param name Kernel device name
+ * @return Non-zero for whole disks, 0 for partitions, loop and RAM devices
+ */
+static int isWholeDisk(uint64_t major, const char *name) {
+    char path[96];
+
+    if (major == DISK_LOOP_MAJOR || major == DISK_RAM_MAJOR) {
+        return 0;
+    }
+
+    // sysfs spells '/' in device names ("cciss/c0d0") as '!'
+    int len = snprintf(path, sizeof(path), "/sys/class/block/%s", name);
+    for (int i = (int)sizeof("/sys/class/block/") - 1; i < len && path[i] != '\0'; i++) {
+        if (path[i] == '/') {
+            path[i] = '!';
+        }
+    }
+    strncat(path, "/partition", sizeof(path) - strlen(path) - 1);
+    return access(path, F_OK) != 0;
+}
+
+/**
+ * Find a device out of order, or add it
+ * @param monitor Source state
+ * @param dev Device number key
+ * @param major Device major number
+ * @param name Device name (not terminated)
+ * @param name_len Name length
+ * @param fresh Output: 1 if the device was just added
+ * @return Device index, or -1 on allocation failure
+ */
+static int findDiskDevice(DiskMonitor *monitor, uint32_t dev, uint64_t major,
+                          const char *name, size_t name_len, int *fresh) {
+    *fresh = 0;
+    for (int i = 0; i < monitor->count; i++) {
+        if (monitor->devices[i].dev == dev) {
+            return i;
+        }
+    }
+
+    if (monitor->count == monitor->capacity) {
+        int capacity = monitor->capacity > 0 ? monitor->capacity * 2 : 32;
+        DiskDevice *devices = realloc(monitor->devices, (size_t)capacity * sizeof(*devices));
+        if (devices == NULL) {
+            return -1;
+        }
+        monitor->devices = devices;
+        monitor->capacity = capacity;
+    }
+
+    DiskDevice *device = &monitor->devices[monitor->count];
+    memset(device, 0, sizeof(*device));
+    device->dev = dev;
+    if (name_len >= DISK_NAME_LENGTH) {
+        name_len = DISK_NAME_LENGTH - 1;
+    }
+    memcpy(device->name, name, name_len);
+    device->name[name_len] = '\0';
+    device->tracked = isWholeDisk(major, device->name);
+    *fresh = 1;
+    return monitor->count++;
+}
+
+/**
+ * Order devices by the line they last appeared on
+ */
+static int compareDiskLine(const void *a, const void *b) {
+    const DiskDevice *left = a;
+    const DiskDevice *right = b;
+    return (left->line > right->line) - (left->line < right->line);
+}
+
+/**
+ * Drop devices missing from the last read and restore the file order
+ * @param monitor Source state
+ */
+static void reorderDiskDevices(DiskMonitor *monitor) {
+    int kept = 0;
+
+    for (int i = 0; i < monitor->count; i++) {
+        if (monitor->devices[i].generation == monitor->generation) {
+            monitor->devices[kept++] = monitor->devices[i];
+        }
+    }
+    monitor->count = kept;
+    qsort(monitor->devices, (size_t)kept, sizeof(DiskDevice), compareDiskLine);
+}
+
+/**
+ * Insert a device into the ranking if it is busy enough
+ * @param sample Section being filled (top kept sorted, busiest first)
+ * @param entry Device rates
+ */
+static void rankDisk(DiskSample *sample, const DiskEntry *entry) {
+    float iops = entry->read_iops + entry->write_iops;
+    int slot = sample->count;
+
+    if (slot == DISK_TOP_COUNT) {
+        const DiskEntry *last = &sample->top[DISK_TOP_COUNT - 1];
+        if (entry->util_percent < last->util_percent ||
+            (entry->util_percent == last->util_percent && iops <= last->read_iops + last->write_iops)) {
+            return;
+        }
+        slot--;
+    } else {
+        sample->count++;
+    }
+
+    while (slot > 0) {
+        const DiskEntry *above = &sample->top[slot - 1];
+        if (above->util_percent > entry->util_percent ||
+            (above->util_percent == entry->util_percent && above->read_iops + above->write_iops >= iops)) {
+            break;
+        }
+        sample->top[slot] = *above;
+        slot--;
+    }
+    sample->top[slot] = *entry;
+}
+
+/**
+ * Rates of one device over the interval
+ * @param device Device holding the previous counters
+ * @param now Current counters
+ * @param seconds Interval length
+ * @param entry Output rates
+ */
+static void measureDisk(const DiskDevice *device, const uint64_t *now, double seconds, DiskEntry *entry) {
+    uint64_t delta[DISK_COUNTERS];
+
+    // A counter that went backwards was reset (device re-created): count nothing
+    for (int c = 0; c < DISK_COUNTERS; c++) {
+        delta[c] = now[c] >= device->counters[c] ? now[c] - device->counters[c] : 0;
+    }
+
+    uint64_t ios = delta[DISK_READS] + delta[DISK_WRITES];
+    memcpy(entry->name, device->name, sizeof(entry->name));
+    entry->read_iops = (float)(delta[DISK_READS] / seconds);
+    entry->write_iops = (float)(delta[DISK_WRITES] / seconds);
+    entry->read_bytes = delta[DISK_READ_SECTORS] * DISK_SECTOR_BYTES / seconds;
+    entry->write_bytes = delta[DISK_WRITE_SECTORS] * DISK_SECTOR_BYTES / seconds;
+    entry->await_ms = ios > 0 ? (float)(delta[DISK_READ_MS] + delta[DISK_WRITE_MS]) / (float)ios : 0.0f;
+    entry->util_percent = (float)(delta[DISK_IO_MS] / (seconds * 10.0));
+    if (entry->util_percent > 100.0f) {
+        entry->util_percent = 100.0f;
+    }
+}
+
+/**
+ * Current CLOCK_MONOTONIC time
+ * @return Nanoseconds
+ */
+static uint64_t diskClockNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Read /proc/diskstats once and rate every whole disk against the previous read
+ * @param monitor Source state
+ * @param sample Output section
+ * @return 0 on success, -1 if the file could not be read
+ */
+static int scanDiskStats(DiskMonitor *monitor, DiskSample *sample) {
+    uint64_t now_ns = diskClockNs();
+    double seconds = monitor->last_ns != 0 ? (now_ns - monitor->last_ns) / 1e9 : 0.0;
+    int expected = 0;       // Slot the next line should match
+    int reordered = 0;
+    int line = 0;
+
+    if (proc_file_read(&monitor->file) <= 0) {
+        return -1;
+    }
+    monitor->generation++;
+    monitor->last_ns = now_ns;
+
+    memset(sample, 0, sizeof(*sample));
+    sample->interval_ns = (uint64_t)(seconds * 1e9);
+
+    // "   8       0 sda 6471 3969 1242802 5875 4266 2917 140960 1262 0 1720 7291 ..."
+    for (const char *p = monitor->file.buf; *p != '\0'; p = proc_next_line(p), line++) {
+        uint64_t major, minor;
+        const char *q = proc_scan_u64(p, &major);
+        if (q == NULL || (q = proc_scan_u64(q, &minor)) == NULL) {
+            continue;
+        }
+        const char *name = proc_skip_blanks(q);
+        q = name;
+        while (*q != ' ' && *q != '\n' && *q != '\0') {
+            q++;
+        }
+
+        uint32_t dev = (uint32_t)(major << 20 | minor);
+        int fresh = 0;
+        int index = expected;
+        if (index >= monitor->count || monitor->devices[index].dev != dev) {
+            index = findDiskDevice(monitor, dev, major, name, (size_t)(q - name), &fresh);
+            if (index < 0) {
+                continue;
+            }
+            reordered = 1;
+        }
+        expected = index + 1;
+
+        DiskDevice *device = &monitor->devices[index];
+        device->generation = monitor->generation;
+        device->line = line;
+        if (!device->tracked) {
+            continue;
+        }
+
+        uint64_t fields[DISK_FIELDS];
+        uint64_t now[DISK_COUNTERS];
+        int parsed = 0;
+        while (parsed < DISK_FIELDS && (q = proc_scan_u64(q, &fields[parsed])) != NULL) {
+            parsed++;
+        }
+        if (parsed < DISK_FIELDS) {
+            continue;
+        }
+        for (int c = 0; c < DISK_COUNTERS; c++) {
+            now[c] = fields[disk_fields[c]];
+        }
+
+        sample->devices++;
+        if (!fresh && seconds > 0.0) {
+            DiskEntry entry;
+            measureDisk(device, now, seconds, &entry);
+            sample->total_iops += entry.read_iops + entry.write_iops;
+            sample->total_read_bytes += entry.read_bytes;
+            sample->total_write_bytes += entry.write_bytes;
+            if (entry.util_percent > sample->busiest_util) {
+                sample->busiest_util = entry.util_percent;
+            }
+            rankDisk(sample, &entry);
+        }
+        memcpy(device->counters, now, sizeof(now));
+    }
+
+    if (reordered || line < monitor->count) {
+        reorderDiskDevices(monitor);
+    }
+
+    TRACE_DEBUG("Disk scan: %d lines, %d devices, %d slots", line, sample->devices, monitor->count);
+    return 0;
+}
+
+/**
+ * Disk source: open /proc/diskstats and take the baseline counters
+ * @param state Output state
+ * @return 0 on success, -1 on failure
+ */
+static int diskSourceInit(void **state) {
+    DiskMonitor *monitor = calloc(1, sizeof(*monitor));
+    DiskSample baseline;
+
+    if (monitor == NULL) {
+        return -1;
+    }
+    if (proc_file_open(&monitor->file, "/proc/diskstats") != 0 ||
+        scanDiskStats(monitor, &baseline) != 0) {
+        proc_file_close(&monitor->file);
+        free(monitor->devices);
+        free(monitor);
+        return -1;
+    }
+    *state = monitor;
+    return 0;
+}
+
+/**
+ * Disk source: rate the devices since the last read
+ * @param state Source state
+ * @param snapshot Snapshot being assembled
+ * @return 0 on success, -1 if /proc/diskstats could not be read
+ */
+static int diskSourceCollect(void *state, SystemSnapshot *snapshot) {
+    return scanDiskStats(state, &snapshot->disks);
+}
+
+/**
+ * Disk source: release state
+ * @param state Source state
+ */
+static void diskSourceTeardown(void *state) {
+    DiskMonitor *monitor = state;
+
+    proc_file_close(&monitor->file);
+    free(monitor->devices);
+    free(monitor);
+}
+#else
+/**
+ * Disk source: block device counters are only read from procfs
+ * @param state Unused
+ * @return -1
+ */
+static int diskSourceInit(void **state) {
+    (void)state;
+    return -1;
+}
+
+/**
+ * Disk source: never called without init
+ * @param state Unused
+ * @param snapshot Unused
+ * @return -1
+ */
+static int diskSourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    (void)snapshot;
+    return -1;
+}
+
+/**
+ * Disk source: nothing to release
+ * @param state Unused
+ */
+static void diskSourceTeardown(void *state) {
+    (void)state;
+}
+#endif
+
+/**
+ * Disk source: description
+ * @return Static string
+ */
+static const char *diskSourceDescribe(void) {
+    return "whole block devices (/proc/diskstats)";
+}
+
+const MetricSource diskMetricSource = {
+    .name = "disks",
+    .section = METRIC_DISKS,
+    .period_ms = 0,
+    .init = diskSourceInit,
+    .collect = diskSourceCollect,
+    .teardown = diskSourceTeardown,
+    .describe = diskSourceDescribe
+};
+
+/**
+ * Disk sample formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatDiskSample(const DiskSample *sample, char *buffer, size_t size) {
+    const double MB = 1024.0 * 1024.0;
+    size_t used = 0;
+    int lines = 0;
+    int len;
+
+    len = snprintf(buffer, size, "%d devices, %.0f IOPS, read %.2f MB/s, write %.2f MB/s\n",
+                   sample->devices, sample->total_iops,
+                   sample->total_read_bytes / MB, sample->total_write_bytes / MB);
+    if (len < 0 || (size_t)len >= size) {
+        return 0;
+    }
+    used = (size_t)len;
+    lines++;
+
+    for (int i = 0; i < sample->count; i++) {
+        const DiskEntry *entry = &sample->top[i];
+        len = snprintf(buffer + used, size - used, "%-12s %8.1f %8.1f %8.2f %8.2f %8.2f %6.1f%%\n",
+                       entry->name, entry->read_iops, entry->write_iops,
+                       entry->read_bytes / MB, entry->write_bytes / MB,
+                       entry->await_ms, entry->util_percent);
+        if (len < 0 || (size_t)len >= size - used) {
+            buffer[used] = '\0';
+            break;
+        }
+        used += (size_t)len;
+        lines++;
+    }
+    return lines;
+}
@@ -0,0 +1,63 @@
+#ifndef DISK_H
+#define DISK_H
+
+#include "../utils/common.h"
+#include <stdint.h>
+
+// Devices kept in the disks section
+#define DISK_TOP_COUNT 16
+
+// Device name length, including the NUL
+#define DISK_NAME_LENGTH 32
+
+// Text buffer for the formatted disks section
+#define DISK_TEXT_BUFFER 2048
+
+/**
+ * One block device of the disks section
+ *
+ * Rates are averages over the interval since the previous sample.
+ */
+typedef struct {
+    char name[DISK_NAME_LENGTH];
+    float read_iops;            // Reads completed per second
+    float write_iops;           // Writes completed per second
+    float await_ms;             // Average time per completed I/O, queueing included
+    float util_percent;         // Share of the interval with I/O in flight
+    double read_bytes;          // Bytes read per second
+    double write_bytes;         // Bytes written per second
+} DiskEntry;
+
+/**
+ * Disks section: whole block devices from /proc/diskstats
+ *
+ * Partitions, loop and RAM devices are left out: their I/O is already
+ * counted on the device below them, or never reaches storage.
+ */
+typedef struct {
+    uint64_t interval_ns;       // Time since the previous sample
+    int32_t devices;            // Devices tracked
+    int32_t count;              // Entries in top
+    float total_iops;           // Reads and writes per second, all devices
+    float busiest_util;         // Highest utilization of any device (%)
+    double total_read_bytes;    // Bytes read per second, all devices
+    double total_write_bytes;   // Bytes written per second, all devices
+    DiskEntry top[DISK_TOP_COUNT];  // Busiest first
+} DiskSample;
+
+/**
+ * Disk sample formatting function
+ *
+ * Formats a summary line followed by one line per listed device.
+ *
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatDiskSample(const DiskSample *sample, char *buffer, size_t size);
+
+// Disks section title
+#define DISK_INFO_TITLE "### Disks ### (Device r/s w/s rMB/s wMB/s await-ms util%)"
+
+#endif // DISK_H
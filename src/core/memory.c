@@ -1,143 +1,282 @@
 #include "memory.h"
+#include "metric_source.h"
 #include "../platform/platform.h"
+#include "../utils/error.h"
 #include <signal.h>
 #include <math.h>
+#include <stddef.h>
+#include <pthread.h>
 
+#ifdef __linux__
+#include "../platform/proc_file.h"
+#endif
+
+// Bytes per GB used for display
+#define BYTES_PER_GB (1024.0 * 1024.0 * 1024.0)
+
+#ifdef __linux__
 /**
- * Function to collect memory information and send through pipe
- * @param tdelay Sampling interval (seconds)
- * @param samples Number of samples to collect
- * @param memFD Pipe file descriptor for sending memory information
+ * /proc/meminfo key table
+ * Values are in kB unless scaled is 0 (HugePages_* page counts).
  */
-void storeMemoryInfo(int tdelay, int samples, int *memFD) {
-    for (int i = 0; i < samples; i++) {
-        char memBuffer[MAX_MEMORY_BUFFER] = {0};
-        struct sysinfo sys_info;
-        
-        if (sysinfo(&sys_info) != 0) {
-            perror("Error getting system info");
-            snprintf(memBuffer, sizeof(memBuffer), "Error getting system info");
-        } else {
-            double phys_total_gb = (double)sys_info.totalram / (1024 * 1024 * 1024); 
-            double phys_free_gb = (double)sys_info.freeram / (1024 * 1024 * 1024);
-            double phys_used_gb = phys_total_gb - phys_free_gb;
-            double swap_total_gb = (double)sys_info.totalswap / (1024 * 1024 * 1024);
-            double swap_free_gb = (double)sys_info.freeswap / (1024 * 1024 * 1024);
-
-            double virtual_used_gb = phys_used_gb + (swap_total_gb - swap_free_gb);
-            double virtual_total_gb = phys_total_gb + swap_total_gb;
-            
-            snprintf(memBuffer, sizeof(memBuffer), "%.2f GB / %.2f GB  -- %.2f GB / %.2f GB",
-                    phys_used_gb, phys_total_gb, virtual_used_gb, virtual_total_gb);
+typedef struct {
+    const char *key;
+    unsigned char len;
+    unsigned char scaled;
+    unsigned short offset;
+} MemInfoKey;
+
+#define MEMINFO_KEY(name, field, kb) { name, sizeof(name) - 1, kb, offsetof(MemInfo, field) }
+
+static const MemInfoKey meminfo_keys[] = {
+    MEMINFO_KEY("MemTotal", mem_total, 1),
+    MEMINFO_KEY("MemFree", mem_free, 1),
+    MEMINFO_KEY("MemAvailable", mem_available, 1),
+    MEMINFO_KEY("Buffers", buffers, 1),
+    MEMINFO_KEY("Cached", cached, 1),
+    MEMINFO_KEY("Shmem", shmem, 1),
+    MEMINFO_KEY("SReclaimable", sreclaimable, 1),
+    MEMINFO_KEY("Dirty", dirty, 1),
+    MEMINFO_KEY("Writeback", writeback, 1),
+    MEMINFO_KEY("AnonPages", anon_pages, 1),
+    MEMINFO_KEY("SwapTotal", swap_total, 1),
+    MEMINFO_KEY("SwapFree", swap_free, 1),
+    MEMINFO_KEY("HugePages_Total", hugepages_total, 0),
+    MEMINFO_KEY("HugePages_Free", hugepages_free, 0),
+    MEMINFO_KEY("HugePages_Rsvd", hugepages_rsvd, 0),
+    MEMINFO_KEY("HugePages_Surp", hugepages_surp, 0),
+    MEMINFO_KEY("Hugepagesize", hugepage_size, 1),
+};
+
+#define MEMINFO_KEY_COUNT (sizeof(meminfo_keys) / sizeof(meminfo_keys[0]))
+
+// Persistent /proc/meminfo reader, shared by the collector and GUI threads
+static proc_file_t meminfo_file = { .fd = -1 };
+static pthread_mutex_t meminfo_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Find the table entry for a key
+ * Only entries with the same first letter and length are compared.
+ * @param key Start of the key
+ * @param len Key length
+ * @return Matching entry, or NULL for keys we do not track
+ */
+static const MemInfoKey *lookupMemInfoKey(const char *key, size_t len) {
+    for (size_t k = 0; k < MEMINFO_KEY_COUNT; k++) {
+        const MemInfoKey *entry = &meminfo_keys[k];
+        if (entry->len == len && entry->key[0] == key[0] && memcmp(entry->key, key, len) == 0) {
+            return entry;
         }
+    }
+    return NULL;
+}
 
-        // Safe pipe writing - including null terminator
-        size_t len = strlen(memBuffer) + 1;
-        
-        // Send buffer length first
-        if (write(memFD[1], &len, sizeof(len)) == -1) {
-            perror("Error writing length to pipe");
-            kill(getpid(), SIGTERM);
-            return;
+/**
+ * Parse /proc/meminfo content in a single pass
+ * @param text NUL-terminated file content
+ * @param info Output counters
+ * @return Non-zero if MemAvailable was present
+ */
+static int parseMemInfo(const char *text, MemInfo *info) {
+    int have_available = 0;
+    const char *p = text;
+
+    while (*p != '\0') {
+        const char *colon = p;
+        while (*colon != ':' && *colon != '\n' && *colon != '\0') {
+            colon++;
         }
-        
-        // Then send buffer contents
-        if (write(memFD[1], memBuffer, len) == -1) {
-            perror("Error writing data to pipe");
-            kill(getpid(), SIGTERM);
-            return;
+
+        if (*colon == ':') {
+            const MemInfoKey *entry = lookupMemInfoKey(p, (size_t)(colon - p));
+            uint64_t value;
+            if (entry != NULL && proc_scan_u64(colon + 1, &value) != NULL) {
+                *(uint64_t *)((char *)info + entry->offset) = entry->scaled ? value * 1024 : value;
+                if (entry->offset == offsetof(MemInfo, mem_available)) {
+                    have_available = 1;
+                }
+            }
         }
 
-        sleep(tdelay);
+        p = proc_next_line(colon);
     }
+
+    return have_available;
 }
+#endif
 
 /**
- * Memory information output function
- * @param sequential Whether sequential mode is enabled
- * @param samples Number of samples to collect
- * @param memArr Memory information array
- * @param iteration Current iteration index
- * @param memFD Memory pipe file descriptor (unused)
+ * Memory counters collection function
+ * @param info Output counters
+ * @return 0 on success, -1 on failure
+ */
+int readMemInfo(MemInfo *info) {
+    memset(info, 0, sizeof(*info));
+
+#ifdef __linux__
+    pthread_mutex_lock(&meminfo_lock);
+    int ok = (meminfo_file.fd >= 0 || proc_file_open(&meminfo_file, "/proc/meminfo") == 0) &&
+             proc_file_read(&meminfo_file) > 0;
+    int have_available = ok ? parseMemInfo(meminfo_file.buf, info) : 0;
+    pthread_mutex_unlock(&meminfo_lock);
+
+    if (ok) {
+        // Kernels before 3.14 lack MemAvailable: approximate it
+        if (!have_available) {
+            info->mem_available = info->mem_free + info->buffers + info->cached;
+        }
+        return 0;
+    }
+#endif
+
+    // Fallback: sysinfo() has no page-cache breakdown, so available = free
+    struct sysinfo sys_info;
+    if (sysinfo(&sys_info) != 0) {
+        return -1;
+    }
+
+    uint64_t unit = sys_info.mem_unit ? sys_info.mem_unit : 1;
+    info->mem_total = (uint64_t)sys_info.totalram * unit;
+    info->mem_free = (uint64_t)sys_info.freeram * unit;
+    info->mem_available = info->mem_free;
+    info->buffers = (uint64_t)sys_info.bufferram * unit;
+    info->shmem = (uint64_t)sys_info.sharedram * unit;
+    info->swap_total = (uint64_t)sys_info.totalswap * unit;
+    info->swap_free = (uint64_t)sys_info.freeswap * unit;
+    return 0;
+}
+
+/**
+ * Function to collect memory information into a binary record
+ * @param sample Output record
+ * @return 0 on success, -1 on failure
  */
-void printMemoryInfo(int sequential, int samples, char memArr[][MAX_MEMORY_BUFFER], int iteration, int memFD[2]) {
-    (void)memFD; // Suppress unused parameter warning
+int storeMemoryInfo(MemorySample *sample) {
+    MemInfo info;
+    struct timespec now;
     
-    printf("### Memory ### (Phys.Used/Tot -- Virtual Used/Tot)\n");
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sample->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
     
-    if (sequential) {
-        for (int k = 0; k < samples; k++) {
-            if (k == iteration) {
-                printf("%s\n", memArr[k]);
-            } else {
-                printf("\n");
-            }
-        }
-    } else {
-        for (int j = 0; j <= iteration; j++) {
-            printf("%s\n", memArr[j]);
-        }
+    if (readMemInfo(&info) != 0) {
+        LOG_ERROR(SYS_MON_ERR_IO, "Failed to read memory information");
+        sample->phys_total = sample->phys_available = 0;
+        sample->swap_total = sample->swap_free = 0;
+        return -1;
+    }
+    
+    sample->phys_total = info.mem_total;
+    sample->phys_available = info.mem_available;
+    sample->swap_total = info.swap_total;
+    sample->swap_free = info.swap_free;
+    return 0;
+}
+
+/**
+ * Memory source: fill the memory section
+ * @param state Unused
+ * @param snapshot Snapshot being assembled
+ * @return 0 on success, -1 on failure
+ */
+static int memorySourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    return storeMemoryInfo(&snapshot->memory);
+}
+
+/**
+ * Memory source: description
+ * @return Static string
+ */
+static const char *memorySourceDescribe(void) {
+    return "physical and swap memory (/proc/meminfo)";
+}
+
+const MetricSource memoryMetricSource = {
+    .name = "memory",
+    .section = METRIC_MEMORY,
+    .period_ms = 0,
+    .collect = memorySourceCollect,
+    .describe = memorySourceDescribe
+};
+
+/**
+ * Virtual memory usage of a sample
+ * @param sample Record to evaluate
+ * @return Physical plus swap usage (GB)
+ */
+double memorySampleVirtualUsedGB(const MemorySample *sample) {
+    uint64_t used = (sample->phys_total - sample->phys_available) +
+                    (sample->swap_total - sample->swap_free);
+    return (double)used / BYTES_PER_GB;
+}
+
+/**
+ * Memory sample formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ */
+void formatMemorySample(const MemorySample *sample, char *buffer, size_t size) {
+    if (sample->phys_total == 0) {
+        snprintf(buffer, size, "Error getting system info");
+        return;
     }
+    
+    double phys_total_gb = (double)sample->phys_total / BYTES_PER_GB;
+    double phys_used_gb = (double)(sample->phys_total - sample->phys_available) / BYTES_PER_GB;
+    double virtual_total_gb = (double)(sample->phys_total + sample->swap_total) / BYTES_PER_GB;
+    
+    snprintf(buffer, size, "%.2f GB / %.2f GB  -- %.2f GB / %.2f GB",
+            phys_used_gb, phys_total_gb, memorySampleVirtualUsedGB(sample), virtual_total_gb);
 }
 
 /**
  * Memory graphics creation function
+ * Appends the change graphic to the sample's row in one pass: the symbols
+ * are filled in place instead of being appended one at a time.
  * @param virtual_used_gb Virtual memory usage (GB)
  * @param prev_used_gb Pointer to previous virtual memory usage (GB)
  * @param memArr Memory information array
  * @param iteration Current iteration index
+ * @return Length of the row
  */
-void createMemoryGraphics(double virtual_used_gb, double *prev_used_gb, char memArr[][MAX_MEMORY_BUFFER], int iteration) {
+int createMemoryGraphics(double virtual_used_gb, double *prev_used_gb, char memArr[][MAX_MEMORY_BUFFER], int iteration) {
     double difference = virtual_used_gb - *prev_used_gb;
-    char graphicsStr[MAX_MEMORY_BUFFER] = "\0 ";
-    char infoStr[100]; // Buffer for formatted information
+    char *row = memArr[iteration];
+    size_t len = strlen(row);
+    size_t room = MAX_MEMORY_BUFFER - len;
+    int tail;
+    
+    *prev_used_gb = virtual_used_gb;  // Previous usage for the next call
+    if (room < 2) {
+        return (int)len;
+    }
     
     // Default representation for first sample or minimal change
     if (iteration == 0 || fabs(difference) < 0.01) {
-        snprintf(graphicsStr, sizeof(graphicsStr), "|%s %.2f (%.2f)", 
-                difference >= 0 ? "o" : "@", difference, virtual_used_gb);
+        tail = snprintf(row + len, room, "|%s %.2f (%.2f)",
+                        difference >= 0 ? "o" : "@", difference, virtual_used_gb);
     } else {
         // Prepare graphics based on magnitude and direction of change
         char changeSymbol = difference < 0 ? ':' : '#';
-        int symbolsCount = (int)(fabs(difference) * 100); // Convert change to symbol count
-
-        // Add base bar
-        strcat(graphicsStr, "|");
-        // Add additional symbols based on change magnitude
-        size_t remaining = sizeof(graphicsStr) - strlen(graphicsStr) - 50;
-        for (int j = 0; j < symbolsCount && (size_t)j < remaining; ++j) {
-            strncat(graphicsStr, &changeSymbol, 1);
+        size_t symbolsCount = (size_t)(fabs(difference) * 100); // Convert change to symbol count
+        
+        // Keep room for the bar ends and the figures
+        size_t limit = room > 50 ? room - 50 : 0;
+        if (symbolsCount > limit) {
+            symbolsCount = limit;
         }
-        // Add closing symbol
-        strcat(graphicsStr, difference < 0 ? "@" : "*");
         
-        // Format and add difference and usage
-        snprintf(infoStr, sizeof(infoStr), " %.2f (%.2f)", difference, virtual_used_gb);
-        strncat(graphicsStr, infoStr, sizeof(graphicsStr) - strlen(graphicsStr) - 1);
+        // Base bar, symbols based on change magnitude, then the closing symbol and figures
+        row[len++] = '|';
+        memset(row + len, changeSymbol, symbolsCount);
+        len += symbolsCount;
+        room = MAX_MEMORY_BUFFER - len;
+        tail = snprintf(row + len, room, "%s %.2f (%.2f)",
+                        difference < 0 ? "@" : "*", difference, virtual_used_gb);
     }
-    
-    // Ensure buffer limits are not exceeded
-    strcat(memArr[iteration], graphicsStr);
-    memArr[iteration][MAX_MEMORY_BUFFER - 1] = '\0'; // Ensure string is properly terminated
-
-    // Update previous usage for next call
-    *prev_used_gb = virtual_used_gb;
-}
-
-/**
- * Virtual memory usage calculation function
- * @return Virtual memory usage (GB)
- */
-double getVirtualMemoryUsage(void) {
-    return calculate_memory_usage();
-}
-
-/**
- * Reserve space function
- * @param samples Number of lines to reserve
- */
-void reserveSpace(int samples) {
-    for (int i = 0; i < samples + 1; i++) {
-        printf("\n");
+    if (tail > 0) {
+        len += (size_t)tail < room ? (size_t)tail : room - 1;
     }
-} 
\ No newline at end of file
+    return (int)len;
+}
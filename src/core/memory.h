@@ -2,36 +2,106 @@
 #define MEMORY_H
 
 #include "../utils/common.h"
+#include <stdint.h>
 
 /**
- * Memory information collection and storage function
+ * Parsed memory counters
+ *
+ * Filled from /proc/meminfo in a single pass on Linux, or from sysinfo()
+ * elsewhere. Sizes are in bytes; HugePages_* fields are page counts.
+ */
+typedef struct {
+    uint64_t mem_total;         // MemTotal
+    uint64_t mem_free;          // MemFree
+    uint64_t mem_available;     // MemAvailable (estimated on kernels without it)
+    uint64_t buffers;           // Buffers
+    uint64_t cached;            // Cached
+    uint64_t shmem;             // Shmem
+    uint64_t sreclaimable;      // SReclaimable
+    uint64_t dirty;             // Dirty
+    uint64_t writeback;         // Writeback
+    uint64_t anon_pages;        // AnonPages
+    uint64_t swap_total;        // SwapTotal
+    uint64_t swap_free;         // SwapFree
+    uint64_t hugepages_total;   // HugePages_Total (pages)
+    uint64_t hugepages_free;    // HugePages_Free (pages)
+    uint64_t hugepages_rsvd;    // HugePages_Rsvd (pages)
+    uint64_t hugepages_surp;    // HugePages_Surp (pages)
+    uint64_t hugepage_size;     // Hugepagesize
+} MemInfo;
+
+/**
+ * Memory counters collection function
  * 
- * Collects current system memory usage information and sends it through a pipe.
- * This function is called from a child process to periodically monitor memory status.
+ * Reads all MemInfo fields in one pass. "Used" memory throughout the
+ * monitor is mem_total - mem_available; see memInfoUsed().
+ * Safe to call from several threads.
  * 
- * @param tdelay Sampling interval (seconds)
- * @param samples Number of samples to collect
- * @param memFD Pipe file descriptor for sending memory information
+ * @param info Output counters
+ * @return 0 on success, -1 on failure
  */
-void storeMemoryInfo(int tdelay, int samples, int *memFD);
+int readMemInfo(MemInfo *info);
 
-// Memory information output function
-void printMemoryInfo(int sequential, int samples, char memArr[][MAX_MEMORY_BUFFER], int iteration, int memFD[2]);
+/**
+ * Used physical memory
+ * 
+ * @param info Parsed counters
+ * @return MemTotal - MemAvailable (bytes)
+ */
+static inline uint64_t memInfoUsed(const MemInfo *info) {
+    return info->mem_total > info->mem_available ? info->mem_total - info->mem_available : 0;
+}
+
+/**
+ * Memory sample record
+ *
+ * Raw byte counts taken at one instant. The collector stores numbers only;
+ * renderers convert and format them when they print. All fields are 64-bit,
+ * so the record has no padding and can be copied or written out as is.
+ */
+typedef struct {
+    uint64_t timestamp_ns;      // CLOCK_MONOTONIC time of the sample
+    uint64_t phys_total;        // Total physical memory (bytes)
+    uint64_t phys_available;    // Available physical memory (bytes)
+    uint64_t swap_total;        // Total swap (bytes)
+    uint64_t swap_free;         // Free swap (bytes)
+} MemorySample;
 
-// Memory graphics creation function
-void createMemoryGraphics(double virtual_used_gb, double *prev_used_gb, char memArr[][MAX_MEMORY_BUFFER], int iteration);
+/**
+ * Memory information collection function
+ * 
+ * Collects current system memory usage into a binary record.
+ * This function is called from the memory collector thread once per sampling interval.
+ * 
+ * @param sample Output record
+ * @return 0 on success, -1 on failure
+ */
+int storeMemoryInfo(MemorySample *sample);
 
 /**
- * Virtual memory usage return function
+ * Memory sample formatting function
  * 
- * Calculates and returns the current system's virtual memory usage in GB.
+ * Formats a record as "phys used / total -- virtual used / total" in GB.
  * 
- * @return Virtual memory usage (GB)
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
  */
-double getVirtualMemoryUsage(void);
+void formatMemorySample(const MemorySample *sample, char *buffer, size_t size);
+
+/**
+ * Virtual memory usage of a sample
+ * 
+ * @param sample Record to evaluate
+ * @return Physical plus swap usage (GB)
+ */
+double memorySampleVirtualUsedGB(const MemorySample *sample);
+
+// Memory section title
+#define MEMORY_INFO_TITLE "### Memory ### (Phys.Used/Tot -- Virtual Used/Tot)"
 
-// Reserve empty space function
-void reserveSpace(int samples);
+// Memory graphics creation function (returns the row length)
+int createMemoryGraphics(double virtual_used_gb, double *prev_used_gb, char memArr[][MAX_MEMORY_BUFFER], int iteration);
 
 /**
  * Physical memory usage return function
@@ -0,0 +1,70 @@
+#include "metric_source.h"
+#include <pthread.h>
+
+static const MetricSource *registry[MAX_METRIC_SOURCES];
+static int registry_count = 0;
+static pthread_once_t builtins_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Add a source without triggering built-in registration
+ * @param source Source to add
+ * @return 0 on success, -1 if the registry is full or the section is taken
+ */
+static int addSource(const MetricSource *source) {
+    if (registry_count == MAX_METRIC_SOURCES || source->collect == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < registry_count; i++) {
+        if (registry[i]->section == source->section) {
+            return -1;
+        }
+    }
+
+    registry[registry_count++] = source;
+    return 0;
+}
+
+/**
+ * Register the sources shipped with the monitor
+ */
+static void registerBuiltins(void) {
+    addSource(&cpuMetricSource);
+    addSource(&memoryMetricSource);
+    addSource(&userMetricSource);
+    addSource(&systemMetricSource);
+    addSource(&processMetricSource);
+    addSource(&pressureMetricSource);
+    addSource(&diskMetricSource);
+    addSource(&netMetricSource);
+    addSource(&cgroupMetricSource);
+    addSource(&cgroupTreeMetricSource);
+}
+
+/**
+ * Register a metric source
+ * @param source Source to add
+ * @return 0 on success, -1 if the registry is full or the section is taken
+ */
+int metricRegister(const MetricSource *source) {
+    pthread_once(&builtins_once, registerBuiltins);
+    return addSource(source);
+}
+
+/**
+ * Number of registered sources
+ * @return Source count
+ */
+int metricSourceCount(void) {
+    pthread_once(&builtins_once, registerBuiltins);
+    return registry_count;
+}
+
+/**
+ * Registered source by position
+ * @param index Position in registration order
+ * @return Source, or NULL if index is out of range
+ */
+const MetricSource *metricSourceAt(int index) {
+    pthread_once(&builtins_once, registerBuiltins);
+    return index >= 0 && index < registry_count ? registry[index] : NULL;
+}
@@ -0,0 +1,100 @@
+#ifndef METRIC_SOURCE_H
+#define METRIC_SOURCE_H
+
+#include "snapshot.h"
+
+// Maximum number of registered sources
+#define MAX_METRIC_SOURCES 16
+
+/**
+ * Metric source
+ *
+ * A collector plugged into the engine. On every tick the engine calls
+ * collect() for each enabled source that is due, all in one batch, and
+ * each source writes its own section of the shared snapshot. A source
+ * that can tell when it is worth sampling (e.g. a kernel trigger) also
+ * hands out event descriptors; the engine then collects it as soon as
+ * one signals, without waiting for the next tick.
+ */
+typedef struct {
+    const char *name;       // Short identifier ("cpu", "memory", ...)
+    MetricId section;       // Snapshot section this source fills
+    int period_ms;          // Minimum time between collections (0: every tick)
+
+    /**
+     * Prepare per-run state (optional)
+     * @param state Output state pointer passed to the other callbacks
+     * @return 0 on success, -1 on failure (the source is skipped)
+     */
+    int (*init)(void **state);
+
+    /**
+     * Write the source's section of the snapshot
+     * @param state State from init (NULL without init)
+     * @param snapshot Snapshot being assembled
+     * @return 0 on success, -1 if the section could not be refreshed
+     */
+    int (*collect)(void *state, SystemSnapshot *snapshot);
+
+    /**
+     * Release per-run state (optional)
+     * @param state State from init
+     */
+    void (*teardown)(void *state);
+
+    /**
+     * One-line description for logs and diagnostics
+     * @return Static string
+     */
+    const char *(*describe)(void);
+
+    /**
+     * Descriptors that signal an event worth sampling at once (optional)
+     * The engine polls them for POLLPRI between ticks.
+     * @param state State from init
+     * @param fds Output descriptors (owned by the source)
+     * @param max Capacity of fds
+     * @return Number of descriptors written
+     */
+    int (*event_fds)(void *state, int *fds, int max);
+} MetricSource;
+
+// Built-in sources, defined next to the code they sample
+extern const MetricSource cpuMetricSource;      // cpu.c
+extern const MetricSource memoryMetricSource;   // memory.c
+extern const MetricSource userMetricSource;     // user.c
+extern const MetricSource systemMetricSource;   // system.c
+extern const MetricSource processMetricSource;  // process.c
+extern const MetricSource pressureMetricSource; // pressure.c
+extern const MetricSource diskMetricSource;     // disk.c
+extern const MetricSource netMetricSource;      // net.c
+extern const MetricSource cgroupMetricSource;   // cgroup.c
+extern const MetricSource cgroupTreeMetricSource; // cgroup_tree.c
+
+/**
+ * Register a metric source
+ *
+ * Built-in sources are registered automatically. Extra sources must be
+ * registered before the engine starts.
+ *
+ * @param source Source to add (must stay valid for the program lifetime)
+ * @return 0 on success, -1 if the registry is full or the section is taken
+ */
+int metricRegister(const MetricSource *source);
+
+/**
+ * Number of registered sources
+ *
+ * @return Source count (built-ins included)
+ */
+int metricSourceCount(void);
+
+/**
+ * Registered source by position
+ *
+ * @param index Position in registration order
+ * @return Source, or NULL if index is out of range
+ */
+const MetricSource *metricSourceAt(int index);
+
+#endif // METRIC_SOURCE_H
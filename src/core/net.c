@@ -0,0 +1,496 @@
+#include "net.h"
+#include "metric_source.h"
+#include "../utils/trace.h"
+
+#ifdef __linux__
+#include "../platform/proc_file.h"
+
+// Fields after the interface name read from each line
+#define NET_FIELDS 12
+
+// Smallest name index (slots)
+#define NET_INDEX_MIN 64
+
+/**
+ * Counters kept per interface
+ */
+enum {
+    NET_RX_BYTES,
+    NET_RX_PACKETS,
+    NET_RX_ERRORS,
+    NET_RX_DROPS,
+    NET_TX_BYTES,
+    NET_TX_PACKETS,
+    NET_TX_ERRORS,
+    NET_TX_DROPS,
+    NET_COUNTERS
+};
+
+// Position of each counter among the fields after the interface name
+static const unsigned char net_fields[NET_COUNTERS] = { 0, 1, 2, 3, 8, 9, 10, 11 };
+
+/**
+ * Counters of one /proc/net/dev line between samples
+ */
+typedef struct {
+    char name[NET_NAME_LENGTH];
+    size_t name_len;
+    uint32_t hash;              // Hash of the name, kept for index rebuilds
+    int loopback;               // Left out of the totals
+    int line;                   // Line of the last read it appeared on
+    uint32_t generation;        // Last read it appeared in
+    uint64_t counters[NET_COUNTERS];
+} NetInterface;
+
+/**
+ * Network source state
+ *
+ * Interfaces are kept in the order /proc/net/dev lists them, so on a
+ * steady host each line matches the next expected slot and no name is
+ * hashed at all. Lines that do not match are looked up in a name index
+ * (open addressing over interface slots) that persists across reads; it
+ * is only rebuilt when the array grows or interfaces are removed.
+ */
+typedef struct {
+    proc_file_t file;
+    NetInterface *interfaces;
+    int count;
+    int capacity;
+    int32_t *index;             // Interface slot + 1 per bucket (0: empty)
+    uint32_t index_mask;        // Bucket count - 1 (power of two)
+    uint32_t generation;
+    uint64_t last_ns;           // CLOCK_MONOTONIC time of the previous read
+} NetMonitor;
+
+/**
+ * FNV-1a hash of an interface name
+ */
+static uint32_t netHash(const char *name, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Rebuild the name index for the current interfaces
+ * @param monitor Source state
+ * @return 0 on success, -1 on allocation failure
+ */
+static int rebuildNetIndex(NetMonitor *monitor) {
+    uint32_t buckets = NET_INDEX_MIN;
+
+    // At most half full, so probes stay short
+    while (buckets < (uint32_t)monitor->capacity * 2) {
+        buckets *= 2;
+    }
+    if (monitor->index == NULL || buckets != monitor->index_mask + 1) {
+        int32_t *index = realloc(monitor->index, buckets * sizeof(*index));
+        if (index == NULL) {
+            return -1;
+        }
+        monitor->index = index;
+        monitor->index_mask = buckets - 1;
+    }
+    memset(monitor->index, 0, buckets * sizeof(*monitor->index));
+
+    for (int i = 0; i < monitor->count; i++) {
+        uint32_t b = monitor->interfaces[i].hash & monitor->index_mask;
+        while (monitor->index[b] != 0) {
+            b = (b + 1) & monitor->index_mask;
+        }
+        monitor->index[b] = i + 1;
+    }
+    return 0;
+}
+
+/**
+ * Find an interface by name, or add it
+ * @param monitor Source state
+ * @param name Interface name (not terminated)
+ * @param name_len Name length
+ * @param fresh Output: 1 if the interface was just added
+ * @return Interface slot, or -1 on allocation failure
+ */
+static int findNetInterface(NetMonitor *monitor, const char *name, size_t name_len, int *fresh) {
+    uint32_t hash;
+    uint32_t b;
+
+    if (name_len >= NET_NAME_LENGTH) {
+        name_len = NET_NAME_LENGTH - 1;
+    }
+    hash = netHash(name, name_len);
+    *fresh = 0;
+
+    for (b = hash & monitor->index_mask; monitor->index[b] != 0; b = (b + 1) & monitor->index_mask) {
+        NetInterface *iface = &monitor->interfaces[monitor->index[b] - 1];
+        if (iface->hash == hash && iface->name_len == name_len &&
+            memcmp(iface->name, name, name_len) == 0) {
+            return monitor->index[b] - 1;
+        }
+    }
+
+    if (monitor->count == monitor->capacity) {
+        int capacity = monitor->capacity * 2;
+        NetInterface *interfaces = realloc(monitor->interfaces, (size_t)capacity * sizeof(*interfaces));
+        if (interfaces == NULL) {
+            return -1;
+        }
+        monitor->interfaces = interfaces;
+        monitor->capacity = capacity;
+        if (rebuildNetIndex(monitor) != 0) {
+            return -1;
+        }
+    }
+
+    // First empty bucket of the probe sequence
+    b = hash & monitor->index_mask;
+    while (monitor->index[b] != 0) {
+        b = (b + 1) & monitor->index_mask;
+    }
+
+    NetInterface *iface = &monitor->interfaces[monitor->count];
+    memset(iface, 0, sizeof(*iface));
+    memcpy(iface->name, name, name_len);
+    iface->name_len = name_len;
+    iface->hash = hash;
+    iface->loopback = name_len == 2 && memcmp(name, "lo", 2) == 0;
+    monitor->index[b] = ++monitor->count;
+    *fresh = 1;
+    return monitor->count - 1;
+}
+
+/**
+ * Order interfaces by the line they last appeared on
+ */
+static int compareNetLine(const void *a, const void *b) {
+    const NetInterface *left = a;
+    const NetInterface *right = b;
+    return (left->line > right->line) - (left->line < right->line);
+}
+
+/**
+ * Drop interfaces missing from the last read and restore the file order
+ * @param monitor Source state
+ * @return Number of interfaces dropped
+ */
+static int reorderNetInterfaces(NetMonitor *monitor) {
+    int kept = 0;
+    int dropped;
+
+    for (int i = 0; i < monitor->count; i++) {
+        if (monitor->interfaces[i].generation == monitor->generation) {
+            monitor->interfaces[kept++] = monitor->interfaces[i];
+        }
+    }
+    dropped = monitor->count - kept;
+    monitor->count = kept;
+    qsort(monitor->interfaces, (size_t)kept, sizeof(NetInterface), compareNetLine);
+    rebuildNetIndex(monitor);
+    return dropped;
+}
+
+/**
+ * Increase of a counter between two reads
+ * @param now Current value
+ * @param last Previous value
+ * @return Increase
+ */
+uint64_t netCounterDelta(uint64_t now, uint64_t last) {
+    if (now >= last) {
+        return now - last;
+    }
+    if (last > (UINT32_MAX >> 1) && last <= UINT32_MAX && now <= (UINT32_MAX >> 1)) {
+        return now + (UINT32_MAX - last) + 1;
+    }
+    return 0;
+}
+
+/**
+ * Insert an interface into the ranking if it is busy enough
+ * @param sample Section being filled (top kept sorted, busiest first)
+ * @param entry Interface rates
+ */
+static void rankNet(NetSample *sample, const NetEntry *entry) {
+    double bytes = entry->rx_bytes + entry->tx_bytes;
+    int slot = sample->count;
+
+    if (slot == NET_TOP_COUNT) {
+        const NetEntry *last = &sample->top[NET_TOP_COUNT - 1];
+        if (bytes <= last->rx_bytes + last->tx_bytes) {
+            return;
+        }
+        slot--;
+    } else {
+        sample->count++;
+    }
+
+    while (slot > 0 && sample->top[slot - 1].rx_bytes + sample->top[slot - 1].tx_bytes < bytes) {
+        sample->top[slot] = sample->top[slot - 1];
+        slot--;
+    }
+    sample->top[slot] = *entry;
+}
+
+/**
+ * Rates of one interface over the interval
+ * @param iface Interface holding the previous counters
+ * @param now Current counters
+ * @param seconds Interval length
+ * @param entry Output rates
+ */
+static void measureNet(const NetInterface *iface, const uint64_t *now, double seconds, NetEntry *entry) {
+    double rate[NET_COUNTERS];
+
+    for (int c = 0; c < NET_COUNTERS; c++) {
+        rate[c] = netCounterDelta(now[c], iface->counters[c]) / seconds;
+    }
+
+    memcpy(entry->name, iface->name, sizeof(entry->name));
+    entry->rx_bytes = rate[NET_RX_BYTES];
+    entry->tx_bytes = rate[NET_TX_BYTES];
+    entry->rx_packets = (float)rate[NET_RX_PACKETS];
+    entry->tx_packets = (float)rate[NET_TX_PACKETS];
+    entry->rx_drops = (float)rate[NET_RX_DROPS];
+    entry->tx_drops = (float)rate[NET_TX_DROPS];
+    entry->rx_errors = (float)rate[NET_RX_ERRORS];
+    entry->tx_errors = (float)rate[NET_TX_ERRORS];
+}
+
+/**
+ * Current CLOCK_MONOTONIC time
+ * @return Nanoseconds
+ */
+static uint64_t netClockNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Read /proc/net/dev once and rate every interface against the previous read
+ * @param monitor Source state
+ * @param sample Output section
+ * @return 0 on success, -1 if the file could not be read
+ */
+static int scanNetDev(NetMonitor *monitor, NetSample *sample) {
+    uint64_t now_ns = netClockNs();
+    double seconds = monitor->last_ns != 0 ? (now_ns - monitor->last_ns) / 1e9 : 0.0;
+    int expected = 0;       // Slot the next line should match
+    int reordered = 0;
+    int line = 0;
+
+    if (proc_file_read(&monitor->file) <= 0) {
+        return -1;
+    }
+    monitor->generation++;
+    monitor->last_ns = now_ns;
+
+    memset(sample, 0, sizeof(*sample));
+    sample->interval_ns = (uint64_t)(seconds * 1e9);
+
+    // "  eth0: 1276 18 0 0 0 0 0 0 1254 17 0 0 0 0 0 0" after two header lines
+    for (const char *p = monitor->file.buf; *p != '\0'; p = proc_next_line(p)) {
+        const char *name = proc_skip_blanks(p);
+        const char *q = name;
+        while (*q != ':' && *q != '\n' && *q != '\0') {
+            q++;
+        }
+        if (*q != ':') {
+            continue;
+        }
+
+        size_t name_len = (size_t)(q - name);
+        int fresh = 0;
+        int slot = expected;
+        if (slot >= monitor->count || monitor->interfaces[slot].name_len != name_len ||
+            memcmp(monitor->interfaces[slot].name, name, name_len) != 0) {
+            slot = findNetInterface(monitor, name, name_len, &fresh);
+            if (slot < 0) {
+                continue;
+            }
+            reordered = 1;
+        }
+        expected = slot + 1;
+
+        NetInterface *iface = &monitor->interfaces[slot];
+        iface->generation = monitor->generation;
+        iface->line = line++;
+
+        uint64_t fields[NET_FIELDS];
+        uint64_t now[NET_COUNTERS];
+        int parsed = 0;
+        q++;
+        while (parsed < NET_FIELDS && (q = proc_scan_u64(q, &fields[parsed])) != NULL) {
+            parsed++;
+        }
+        if (parsed < NET_FIELDS) {
+            continue;
+        }
+        for (int c = 0; c < NET_COUNTERS; c++) {
+            now[c] = fields[net_fields[c]];
+        }
+
+        sample->interfaces++;
+        if (fresh) {
+            sample->appeared += seconds > 0.0;
+        } else if (seconds > 0.0) {
+            NetEntry entry;
+            measureNet(iface, now, seconds, &entry);
+            if (!iface->loopback) {
+                sample->total_rx_bytes += entry.rx_bytes;
+                sample->total_tx_bytes += entry.tx_bytes;
+                sample->total_drops += entry.rx_drops + entry.tx_drops;
+                sample->total_errors += entry.rx_errors + entry.tx_errors;
+            }
+            rankNet(sample, &entry);
+        }
+        memcpy(iface->counters, now, sizeof(now));
+    }
+
+    if (reordered || line < monitor->count) {
+        sample->disappeared = reorderNetInterfaces(monitor);
+    }
+
+    TRACE_DEBUG("Network scan: %d interfaces, %d new, %d gone", sample->interfaces,
+                sample->appeared, sample->disappeared);
+    return 0;
+}
+
+/**
+ * Network source: open /proc/net/dev and take the baseline counters
+ * @param state Output state
+ * @return 0 on success, -1 on failure
+ */
+static int netSourceInit(void **state) {
+    NetMonitor *monitor = calloc(1, sizeof(*monitor));
+    NetSample baseline;
+
+    if (monitor == NULL) {
+        return -1;
+    }
+    monitor->capacity = NET_INDEX_MIN / 2;
+    monitor->interfaces = malloc((size_t)monitor->capacity * sizeof(*monitor->interfaces));
+    if (monitor->interfaces == NULL || rebuildNetIndex(monitor) != 0 ||
+        proc_file_open(&monitor->file, "/proc/net/dev") != 0 ||
+        scanNetDev(monitor, &baseline) != 0) {
+        proc_file_close(&monitor->file);
+        free(monitor->interfaces);
+        free(monitor->index);
+        free(monitor);
+        return -1;
+    }
+    *state = monitor;
+    return 0;
+}
+
+/**
+ * Network source: rate the interfaces since the last read
+ * @param state Source state
+ * @param snapshot Snapshot being assembled
+ * @return 0 on success, -1 if /proc/net/dev could not be read
+ */
+static int netSourceCollect(void *state, SystemSnapshot *snapshot) {
+    return scanNetDev(state, &snapshot->network);
+}
+
+/**
+ * Network source: release state
+ * @param state Source state
+ */
+static void netSourceTeardown(void *state) {
+    NetMonitor *monitor = state;
+
+    proc_file_close(&monitor->file);
+    free(monitor->interfaces);
+    free(monitor->index);
+    free(monitor);
+}
+#else
+/**
+ * Network source: interface counters are only read from procfs
+ * @param state Unused
+ * @return -1
+ */
+static int netSourceInit(void **state) {
+    (void)state;
+    return -1;
+}
+
+/**
+ * Network source: never called without init
+ * @param state Unused
+ * @param snapshot Unused
+ * @return -1
+ */
+static int netSourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    (void)snapshot;
+    return -1;
+}
+
+/**
+ * Network source: nothing to release
+ * @param state Unused
+ */
+static void netSourceTeardown(void *state) {
+    (void)state;
+}
+#endif
+
+/**
+ * Network source: description
+ * @return Static string
+ */
+static const char *netSourceDescribe(void) {
+    return "network interfaces (/proc/net/dev)";
+}
+
+const MetricSource netMetricSource = {
+    .name = "network",
+    .section = METRIC_NETWORK,
+    .period_ms = 0,
+    .init = netSourceInit,
+    .collect = netSourceCollect,
+    .teardown = netSourceTeardown,
+    .describe = netSourceDescribe
+};
+
+/**
+ * Network sample formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatNetSample(const NetSample *sample, char *buffer, size_t size) {
+    size_t used = 0;
+    int lines = 0;
+    int len;
+
+    len = snprintf(buffer, size, "%d interfaces (+%d -%d), rx %.1f KB/s, tx %.1f KB/s, %.1f drops/s, %.1f errors/s\n",
+                   sample->interfaces, sample->appeared, sample->disappeared,
+                   sample->total_rx_bytes / 1024.0, sample->total_tx_bytes / 1024.0,
+                   sample->total_drops, sample->total_errors);
+    if (len < 0 || (size_t)len >= size) {
+        return 0;
+    }
+    used = (size_t)len;
+    lines++;
+
+    for (int i = 0; i < sample->count; i++) {
+        const NetEntry *entry = &sample->top[i];
+        len = snprintf(buffer + used, size - used, "%-15s %10.1f %10.1f %9.1f %9.1f %7.1f %7.1f\n",
+                       entry->name, entry->rx_bytes / 1024.0, entry->tx_bytes / 1024.0,
+                       entry->rx_packets, entry->tx_packets,
+                       entry->rx_drops + entry->tx_drops, entry->rx_errors + entry->tx_errors);
+        if (len < 0 || (size_t)len >= size - used) {
+            buffer[used] = '\0';
+            break;
+        }
+        used += (size_t)len;
+        lines++;
+    }
+    return lines;
+}
@@ -0,0 +1,84 @@
+#ifndef NET_H
+#define NET_H
+
+#include "../utils/common.h"
+#include <stdint.h>
+
+// Interfaces kept in the network section
+#define NET_TOP_COUNT 16
+
+// Interface name length, including the NUL (IFNAMSIZ)
+#define NET_NAME_LENGTH 16
+
+// Text buffer for the formatted network section
+#define NET_TEXT_BUFFER 2048
+
+/**
+ * One network interface of the network section
+ *
+ * Rates are averages over the interval since the previous sample.
+ */
+typedef struct {
+    char name[NET_NAME_LENGTH];
+    double rx_bytes;            // Bytes received per second
+    double tx_bytes;            // Bytes sent per second
+    float rx_packets;           // Packets received per second
+    float tx_packets;           // Packets sent per second
+    float rx_drops;             // Received packets dropped per second
+    float tx_drops;             // Sent packets dropped per second
+    float rx_errors;            // Receive errors per second
+    float tx_errors;            // Transmit errors per second
+} NetEntry;
+
+/**
+ * Network section: interfaces from /proc/net/dev
+ *
+ * Totals leave out loopback, whose traffic never leaves the host.
+ */
+typedef struct {
+    uint64_t interval_ns;       // Time since the previous sample
+    int32_t interfaces;         // Interfaces listed
+    int32_t count;              // Entries in top
+    int32_t appeared;           // Interfaces new since the previous sample
+    int32_t disappeared;        // Interfaces gone since the previous sample
+    double total_rx_bytes;      // Bytes received per second, all interfaces
+    double total_tx_bytes;      // Bytes sent per second, all interfaces
+    float total_drops;          // Packets dropped per second, both directions
+    float total_errors;         // Errors per second, both directions
+    NetEntry top[NET_TOP_COUNT];    // Busiest first
+} NetSample;
+
+/**
+ * Network sample formatting function
+ *
+ * Formats a summary line followed by one line per listed interface.
+ *
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatNetSample(const NetSample *sample, char *buffer, size_t size);
+
+/**
+ * Increase of a counter between two reads
+ *
+ * A decrease normally means the counters were reset (driver reload, or
+ * the interface was recreated under the same name), and nothing is
+ * counted for that interval. Some drivers still keep 32-bit counters,
+ * which wrap at 2^32 on a busy link within seconds; a decrease is only
+ * taken as such a wrap when the previous value was in the upper half of
+ * the 32-bit range and the current one is in the lower half. Small
+ * counters (drops, errors, packets on a quiet link) that drop to a lower
+ * value are therefore never mistaken for a wrap of ~4.29e9.
+ *
+ * @param now Current value
+ * @param last Previous value
+ * @return Increase
+ */
+uint64_t netCounterDelta(uint64_t now, uint64_t last);
+
+// Network section title
+#define NET_INFO_TITLE "### Network ### (Interface rxKB/s txKB/s rxPkt/s txPkt/s drop/s err/s)"
+
+#endif // NET_H
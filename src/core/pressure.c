@@ -0,0 +1,372 @@
+#include "pressure.h"
+#include "metric_source.h"
+#include "../utils/error.h"
+
+// Scheduled period; the kernel recomputes the averages every 2 s
+#define PRESSURE_PERIOD_MS 2000
+
+// Stall threshold of the triggers (0: none), set before the engine starts
+static int pressure_stall_ms = PRESSURE_DEFAULT_STALL_MS;
+
+static const char *const pressure_names[PRESSURE_RESOURCES] = { "cpu", "memory", "io" };
+
+/**
+ * Set the trigger threshold of the pressure source
+ * @param stall_ms Stall threshold (0: no triggers)
+ */
+void pressureSetTrigger(int stall_ms) {
+    if (stall_ms < 0) {
+        stall_ms = 0;
+    }
+    pressure_stall_ms = stall_ms < PRESSURE_WINDOW_MS ? stall_ms : PRESSURE_WINDOW_MS;
+}
+
+/**
+ * Resource name
+ * @param resource Resource index
+ * @return Static string
+ */
+const char *pressureResourceName(PressureResource resource) {
+    return resource < PRESSURE_RESOURCES ? pressure_names[resource] : "?";
+}
+
+#ifdef __linux__
+#include "../platform/proc_file.h"
+
+// Read buffer; a pressure file is two short lines
+#define PRESSURE_READ_SIZE 256
+
+/**
+ * Pressure source state
+ *
+ * One descriptor per resource, kept open for the whole run. When the
+ * trigger is accepted the same descriptor carries it: the kernel flags it
+ * with POLLPRI once per window in which the stall threshold is crossed,
+ * and reading it with pread() still returns the current figures.
+ */
+typedef struct {
+    int fd[PRESSURE_RESOURCES];         // -1: resource not reported
+    int armed[PRESSURE_RESOURCES];      // Trigger installed on fd
+    uint64_t last_ns;                   // CLOCK_MONOTONIC time of the previous sample
+    char buf[PRESSURE_READ_SIZE];
+} PressureMonitor;
+
+/**
+ * Parse the fields of one "some" or "full" line
+ * @param p Position after the line label
+ * @param line Output figures (recent is not touched)
+ * @return 0 on success, -1 on malformed input
+ */
+static int parsePressureLine(const char *p, PressureLine *line) {
+    float *averages[3] = { &line->avg10, &line->avg60, &line->avg300 };
+    uint64_t whole, hundredths;
+
+    // "avg10=1.87 avg60=1.50 avg300=3.00 total=54936932"
+    for (int i = 0; i < 3; i++) {
+        p = strchr(p, '=');
+        if (p == NULL || (p = proc_scan_u64(p + 1, &whole)) == NULL || *p != '.' ||
+            (p = proc_scan_u64(p + 1, &hundredths)) == NULL) {
+            return -1;
+        }
+        *averages[i] = (float)whole + (float)hundredths / 100.0f;
+    }
+
+    p = strchr(p, '=');
+    if (p == NULL || proc_scan_u64(p + 1, &line->total_us) == NULL) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Read one resource
+ * @param monitor Source state
+ * @param resource Resource to read
+ * @param stat Output figures (recent is not touched)
+ * @return 0 on success, -1 on failure
+ */
+static int readPressure(PressureMonitor *monitor, int resource, PressureStat *stat) {
+    ssize_t n;
+
+    do {
+        n = pread(monitor->fd[resource], monitor->buf, sizeof(monitor->buf) - 1, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        return -1;
+    }
+    monitor->buf[n] = '\0';
+
+    // Kernels before 5.13 have no "full" line for cpu
+    memset(&stat->full, 0, sizeof(stat->full));
+    for (const char *p = monitor->buf; *p != '\0'; p = proc_next_line(p)) {
+        if (strncmp(p, "some ", 5) == 0) {
+            if (parsePressureLine(p + 5, &stat->some) != 0) {
+                return -1;
+            }
+        } else if (strncmp(p, "full ", 5) == 0) {
+            if (parsePressureLine(p + 5, &stat->full) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Install a trigger on an open pressure file
+ * @param fd Descriptor opened read-write
+ * @param stall_ms Stall threshold within PRESSURE_WINDOW_MS
+ * @return 0 on success, -1 if the kernel refused it
+ */
+static int armPressureTrigger(int fd, int stall_ms) {
+    char trigger[64];
+
+    // The kernel replaces the last byte written with a NUL: send it along
+    int len = snprintf(trigger, sizeof(trigger), "some %d %d",
+                       stall_ms * 1000, PRESSURE_WINDOW_MS * 1000);
+    return write(fd, trigger, (size_t)len + 1) == len + 1 ? 0 : -1;
+}
+
+/**
+ * Share of an interval spent stalled
+ * @param now Current total stall time (us)
+ * @param last Previous total stall time (us)
+ * @param interval_ns Interval length
+ * @return Percentage
+ */
+static float recentPressure(uint64_t now, uint64_t last, uint64_t interval_ns) {
+    if (interval_ns == 0 || now < last) {
+        return 0.0f;
+    }
+    float percent = (float)((now - last) * 1000.0 * 100.0 / interval_ns);
+    return percent < 100.0f ? percent : 100.0f;
+}
+
+/**
+ * Current CLOCK_MONOTONIC time
+ * @return Nanoseconds
+ */
+static uint64_t pressureClockNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Pressure source: sample every resource
+ * @param state Source state
+ * @param snapshot Snapshot being assembled
+ * @return 0 on success, -1 if no resource could be read
+ */
+static int pressureSourceCollect(void *state, SystemSnapshot *snapshot) {
+    PressureMonitor *monitor = state;
+    PressureSample *sample = &snapshot->pressure;
+    uint64_t now_ns = pressureClockNs();
+    int readable = 0;
+
+    sample->interval_ns = monitor->last_ns != 0 ? now_ns - monitor->last_ns : 0;
+    monitor->last_ns = now_ns;
+
+    for (int r = 0; r < PRESSURE_RESOURCES; r++) {
+        PressureStat *stat = &sample->resource[r];
+        uint64_t last_some = stat->some.total_us;
+        uint64_t last_full = stat->full.total_us;
+        int had_sample = stat->available;
+
+        stat->armed = monitor->armed[r];
+        stat->available = monitor->fd[r] >= 0 && readPressure(monitor, r, stat) == 0;
+        if (!stat->available) {
+            continue;
+        }
+        readable++;
+
+        // The snapshot section still holds the previous totals
+        uint64_t interval = had_sample ? sample->interval_ns : 0;
+        stat->some.recent = recentPressure(stat->some.total_us, last_some, interval);
+        stat->full.recent = recentPressure(stat->full.total_us, last_full, interval);
+    }
+    return readable > 0 ? 0 : -1;
+}
+
+/**
+ * Pressure source: open the pressure files and install the triggers
+ * @param state Output state
+ * @return 0 on success, -1 if the kernel does not report pressure
+ */
+static int pressureSourceInit(void **state) {
+    PressureMonitor *monitor = calloc(1, sizeof(*monitor));
+    char path[64];
+    int opened = 0;
+
+    if (monitor == NULL) {
+        return -1;
+    }
+
+    for (int r = 0; r < PRESSURE_RESOURCES; r++) {
+        snprintf(path, sizeof(path), "/proc/pressure/%s", pressure_names[r]);
+        monitor->fd[r] = -1;
+
+        // Triggers are written to the file; without write access only read it
+        if (pressure_stall_ms > 0) {
+            monitor->fd[r] = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        }
+        if (monitor->fd[r] < 0) {
+            monitor->fd[r] = open(path, O_RDONLY | O_CLOEXEC);
+        }
+        if (monitor->fd[r] < 0) {
+            continue;
+        }
+        opened++;
+
+        if (pressure_stall_ms > 0) {
+            monitor->armed[r] = armPressureTrigger(monitor->fd[r], pressure_stall_ms) == 0;
+            if (!monitor->armed[r]) {
+                LOG_WARNING(SYS_MON_ERR_IO, "PSI trigger on %s refused (%s), sampling it on schedule only",
+                            path, strerror(errno));
+            }
+        }
+    }
+
+    if (opened == 0) {
+        free(monitor);
+        return -1;
+    }
+    *state = monitor;
+    return 0;
+}
+
+/**
+ * Pressure source: descriptors carrying a trigger
+ * @param state Source state
+ * @param fds Output descriptors
+ * @param max Capacity of fds
+ * @return Number of descriptors written
+ */
+static int pressureSourceEventFds(void *state, int *fds, int max) {
+    PressureMonitor *monitor = state;
+    int count = 0;
+
+    for (int r = 0; r < PRESSURE_RESOURCES && count < max; r++) {
+        if (monitor->armed[r]) {
+            fds[count++] = monitor->fd[r];
+        }
+    }
+    return count;
+}
+
+/**
+ * Pressure source: close the files (and with them the triggers)
+ * @param state Source state
+ */
+static void pressureSourceTeardown(void *state) {
+    PressureMonitor *monitor = state;
+
+    for (int r = 0; r < PRESSURE_RESOURCES; r++) {
+        if (monitor->fd[r] >= 0) {
+            close(monitor->fd[r]);
+        }
+    }
+    free(monitor);
+}
+#else
+/**
+ * Pressure source: Pressure Stall Information is Linux-only
+ * @param state Unused
+ * @return -1
+ */
+static int pressureSourceInit(void **state) {
+    (void)state;
+    return -1;
+}
+
+/**
+ * Pressure source: never called without init
+ * @param state Unused
+ * @param snapshot Unused
+ * @return -1
+ */
+static int pressureSourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    (void)snapshot;
+    return -1;
+}
+
+/**
+ * Pressure source: no events without init
+ * @param state Unused
+ * @param fds Unused
+ * @param max Unused
+ * @return 0
+ */
+static int pressureSourceEventFds(void *state, int *fds, int max) {
+    (void)state;
+    (void)fds;
+    (void)max;
+    return 0;
+}
+
+/**
+ * Pressure source: nothing to release
+ * @param state Unused
+ */
+static void pressureSourceTeardown(void *state) {
+    (void)state;
+}
+#endif
+
+/**
+ * Pressure source: description
+ * @return Static string
+ */
+static const char *pressureSourceDescribe(void) {
+    return "pressure stall information (/proc/pressure/{cpu,memory,io}, poll() triggers)";
+}
+
+const MetricSource pressureMetricSource = {
+    .name = "pressure",
+    .section = METRIC_PRESSURE,
+    .period_ms = PRESSURE_PERIOD_MS,
+    .init = pressureSourceInit,
+    .collect = pressureSourceCollect,
+    .teardown = pressureSourceTeardown,
+    .describe = pressureSourceDescribe,
+    .event_fds = pressureSourceEventFds
+};
+
+/**
+ * Pressure sample formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatPressureSample(const PressureSample *sample, char *buffer, size_t size) {
+    size_t used = 0;
+    int lines = 0;
+
+    if (size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+
+    for (int r = 0; r < PRESSURE_RESOURCES; r++) {
+        const PressureStat *stat = &sample->resource[r];
+        if (!stat->available) {
+            continue;
+        }
+
+        int len = snprintf(buffer + used, size - used,
+                           "%-6s some %6.2f %6.2f %6.2f %6.2f | full %6.2f %6.2f %6.2f %6.2f%s\n",
+                           pressure_names[r],
+                           stat->some.avg10, stat->some.avg60, stat->some.avg300, stat->some.recent,
+                           stat->full.avg10, stat->full.avg60, stat->full.avg300, stat->full.recent,
+                           pressure_stall_ms > 0 && !stat->armed ? " (no trigger)" : "");
+        if (len < 0 || (size_t)len >= size - used) {
+            buffer[used] = '\0';
+            break;
+        }
+        used += (size_t)len;
+        lines++;
+    }
+    return lines;
+}
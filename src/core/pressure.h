@@ -0,0 +1,95 @@
+#ifndef PRESSURE_H
+#define PRESSURE_H
+
+#include "../utils/common.h"
+#include <stdint.h>
+
+// Text buffer for the formatted pressure section
+#define PRESSURE_TEXT_BUFFER 512
+
+// Default trigger threshold: stall time per window that wakes the monitor
+#define PRESSURE_DEFAULT_STALL_MS 100
+
+// Trigger window; unprivileged triggers need a multiple of 2 s
+#define PRESSURE_WINDOW_MS 2000
+
+/**
+ * Resources reported under /proc/pressure
+ */
+typedef enum {
+    PRESSURE_CPU = 0,
+    PRESSURE_MEMORY,
+    PRESSURE_IO,
+    PRESSURE_RESOURCES
+} PressureResource;
+
+/**
+ * One "some" or "full" line of a pressure file
+ */
+typedef struct {
+    float avg10;                // Share of wall time stalled, 10 s average (%)
+    float avg60;                // 60 s average (%)
+    float avg300;               // 300 s average (%)
+    float recent;               // Share of the time since the previous sample (%)
+    uint64_t total_us;          // Cumulative stall time
+} PressureLine;
+
+/**
+ * Pressure of one resource
+ */
+typedef struct {
+    int32_t available;          // The pressure file could be read
+    int32_t armed;              // A trigger is installed on it
+    PressureLine some;          // At least one task stalled
+    PressureLine full;          // Every non-idle task stalled at once
+} PressureStat;
+
+/**
+ * Pressure section: Pressure Stall Information for CPU, memory and I/O
+ *
+ * Utilization says how busy a resource is; pressure says how long tasks
+ * waited for it. recent is computed from the total counters over the
+ * time since the previous sample, which is short when a trigger fired.
+ */
+typedef struct {
+    uint64_t interval_ns;       // Time since the previous sample
+    PressureStat resource[PRESSURE_RESOURCES];
+} PressureSample;
+
+/**
+ * Set the trigger threshold of the pressure source
+ *
+ * A trigger wakes the monitor when tasks stall on a resource for at least
+ * stall_ms within PRESSURE_WINDOW_MS, so the pressure section is sampled
+ * at once instead of on its next period. Must be called before the
+ * collector engine starts.
+ *
+ * @param stall_ms Stall threshold (0: no triggers, sample on schedule only)
+ */
+void pressureSetTrigger(int stall_ms);
+
+/**
+ * Pressure sample formatting function
+ *
+ * Formats one line per available resource.
+ *
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatPressureSample(const PressureSample *sample, char *buffer, size_t size);
+
+/**
+ * Resource name
+ *
+ * @param resource Resource index
+ * @return "cpu", "memory" or "io"
+ */
+const char *pressureResourceName(PressureResource resource);
+
+// Pressure section titles
+#define PRESSURE_INFO_TITLE "### Pressure ### (some avg10 avg60 avg300 recent | full ..., %)"
+#define PRESSURE_TRIGGER_TITLE "### Pressure ### (trigger fired: some avg10 avg60 avg300 recent | full ..., %)"
+
+#endif // PRESSURE_H
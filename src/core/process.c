@@ -0,0 +1,688 @@
+#include "process.h"
+#include "metric_source.h"
+#include "../utils/error.h"
+#include "../utils/trace.h"
+
+#ifdef __linux__
+#include "../platform/proc_scan.h"
+#include "../platform/proc_file.h"
+#include "../utils/pid_table.h"
+
+// Processes the table is sized for before it first grows
+#define PROCESS_TABLE_INITIAL 1024
+
+// Descriptors left to the rest of the monitor when sizing the fd budget
+#define PROCESS_FD_RESERVE 256
+
+// Share of the soft descriptor limit (after the reserve) kept open on processes: 1/N
+#define PROCESS_FD_SHARE 2
+
+// Upper bound of the per-process descriptor budget
+#define PROCESS_FD_MAX 65536
+
+// Scans a smaps_rollup reading is reused for while RSS stays within 1/32 of it
+#define PROCESS_SMAPS_MAX_AGE 10
+
+/**
+ * Per-process history kept between scans
+ */
+typedef struct {
+    pid_key_t key;              // Must come first
+    uint64_t cpu_ns;            // CPU time at the previous scan
+    uint64_t rss_pages;         // Resident pages at the previous scan
+    int fd;                     // Kept-open stat (-1: none, stat is reopened)
+
+    // Last smaps_rollup reading
+    uint64_t smaps_rss_pages;   // rss_pages when it was taken (0: never)
+    uint32_t smaps_generation;  // Scan it was taken in
+    int smaps_ok;               // Whether it could be read
+    uint64_t pss_kb;
+    uint64_t swap_kb;
+} ProcessRow;
+
+/**
+ * Process source state
+ *
+ * Known processes are sampled through a descriptor kept open on their
+ * /proc/[pid]/stat: one pread() per process and scan, and no start time
+ * check, since a kept descriptor fails once its process is gone. CPU time
+ * is utime + stime, which covers every thread of the process; schedstat
+ * would be finer grained but only covers the thread-group leader, so a
+ * process whose work runs on other threads would rank at 0%. Only
+ * processes seen for the first time (or beyond the descriptor budget) pay
+ * for opening and parsing /proc/[pid]/stat. smaps_rollup, which walks
+ * every mapping of a process, is only read for the few processes with the
+ * largest RSS, and only when their RSS moved noticeably since the last
+ * reading.
+ *
+ * Known limitation: the kernel formats /proc/[pid]/stat on every read, so
+ * a scan costs roughly 6 us per process with a kept descriptor and 8-9 us
+ * without one (measured on a single vCPU: 10k processes in 60-100 ms).
+ * 20k processes therefore take well over 100 ms, not a few ms; reaching
+ * that would need a kernel interface that reports many tasks per call
+ * (e.g. taskstats over netlink), which this scanner does not use.
+ * The descriptor budget is also small by default: with the usual soft
+ * limit of 1024 open files, processFdBudget() keeps only
+ * (1024 - 256) / 2 = 384 descriptors, so on a 20k-process host almost
+ * every process still pays open + read + close on each scan unless
+ * RLIMIT_NOFILE is raised.
+ */
+typedef struct {
+    proc_scan_t scan;
+    pid_table_t table;
+    double ns_per_tick;         // 1e9 / sysconf(_SC_CLK_TCK)
+    uint64_t page_kb;           // Page size in kB
+    double ticks_per_second;
+    int fd_budget;              // Descriptors that may still be kept open
+    uint64_t last_ns;           // CLOCK_MONOTONIC time of the previous scan
+    uint64_t last_boot_ticks;   // CLOCK_BOOTTIME of the previous scan, in clock ticks
+} ProcessScanner;
+
+/**
+ * Fields of /proc/[pid]/stat used by the scanner
+ */
+typedef struct {
+    char state;
+    const char *comm;       // Points into the read buffer (not terminated)
+    size_t comm_len;
+    uint64_t ticks;         // utime + stime
+    int threads;
+    uint64_t starttime;
+    uint64_t rss_pages;
+} ProcessStat;
+
+/**
+ * Skip space-separated fields
+ * @param p Start of a field
+ * @param count Fields to skip
+ * @return Start of the field after them, or NULL at the end of the text
+ */
+static const char *skipStatFields(const char *p, int count) {
+    while (count-- > 0) {
+        while (*p != ' ' && *p != '\0') {
+            p++;
+        }
+        if (*p == '\0') {
+            return NULL;
+        }
+        p++;
+    }
+    return p;
+}
+
+/**
+ * Parse /proc/[pid]/stat
+ * The command name may contain spaces and parentheses, so fields are
+ * counted from the last ')'.
+ * @param text File content
+ * @param len Content length
+ * @param stat Output fields
+ * @return 0 on success, -1 if the content is malformed
+ */
+static int parseProcessStat(const char *text, size_t len, ProcessStat *stat) {
+    const char *open = memchr(text, '(', len);
+    const char *close = text + len;
+    uint64_t utime, stime, threads;
+
+    while (close > text && *close != ')') {
+        close--;
+    }
+    if (open == NULL || close <= open || close[1] != ' ') {
+        return -1;
+    }
+    stat->comm = open + 1;
+    stat->comm_len = (size_t)(close - open - 1);
+    stat->state = close[2];
+
+    // Fields 14-15 (utime, stime), 20 (num_threads), 22 (starttime) and
+    // 24 (rss); the state is field 3
+    const char *p = skipStatFields(close + 2, 11);
+    if (p == NULL || (p = proc_scan_u64(p, &utime)) == NULL ||
+        (p = proc_scan_u64(p, &stime)) == NULL ||
+        (p = skipStatFields(p + 1, 4)) == NULL ||
+        (p = proc_scan_u64(p, &threads)) == NULL ||
+        (p = skipStatFields(p + 1, 1)) == NULL ||
+        (p = proc_scan_u64(p, &stat->starttime)) == NULL ||
+        (p = skipStatFields(p + 1, 1)) == NULL ||
+        proc_scan_u64(p, &stat->rss_pages) == NULL) {
+        return -1;
+    }
+    stat->ticks = utime + stime;
+    stat->threads = (int)threads;
+    return 0;
+}
+
+/**
+ * Re-read the counters of a process through its kept descriptor
+ * @param scanner Source state
+ * @param row Row holding the descriptor
+ * @param cpu_ns Output CPU time of all threads (ns)
+ * @param rss_pages Output resident pages
+ * @return 0 on success, -1 if the process is gone
+ */
+static int readKeptCounters(ProcessScanner *scanner, const ProcessRow *row,
+                            uint64_t *cpu_ns, uint64_t *rss_pages) {
+    ProcessStat stat;
+    ssize_t len = proc_scan_pread(&scanner->scan, row->fd);
+
+    if (len <= 0 || parseProcessStat(scanner->scan.buf, (size_t)len, &stat) != 0) {
+        return -1;
+    }
+    *cpu_ns = (uint64_t)(stat.ticks * scanner->ns_per_tick);
+    *rss_pages = stat.rss_pages;
+    return 0;
+}
+
+/**
+ * Close the kept descriptor of a row (also the sweep's eviction callback)
+ * @param row Row being dropped or reset
+ * @param context Source state
+ */
+static void releaseProcessRow(void *row, void *context) {
+    ProcessRow *process = row;
+    ProcessScanner *scanner = context;
+
+    if (process->fd >= 0) {
+        close(process->fd);
+        process->fd = -1;
+        scanner->fd_budget++;
+    }
+}
+
+/**
+ * Open the descriptor a new row keeps for later scans, budget permitting
+ * @param scanner Source state
+ * @param row Fresh row (no descriptor yet)
+ * @param pid Process id
+ * @return 0 if the descriptor is open, -1 if the row must reopen stat
+ */
+static int keepProcessFiles(ProcessScanner *scanner, ProcessRow *row, int pid) {
+    if (scanner->fd_budget < 1) {
+        return -1;
+    }
+    row->fd = proc_scan_open_file(&scanner->scan, pid, "stat");
+    if (row->fd < 0) {
+        return -1;
+    }
+    scanner->fd_budget--;
+    return 0;
+}
+
+/**
+ * Sample the CPU time and RSS of one process found in /proc
+ * @param scanner Source state
+ * @param pid Process id
+ * @param used_ns Output: CPU time used since the previous scan (ns)
+ * @return The process row (valid until the next sample), or NULL if the process is gone
+ */
+static ProcessRow *sampleProcess(ProcessScanner *scanner, int pid, uint64_t *used_ns) {
+    ProcessRow *row = pid_table_find(&scanner->table, pid);
+    int replaced = 0;
+    uint64_t cpu_ns, rss_pages;
+
+    if (row != NULL && row->fd >= 0) {
+        if (readKeptCounters(scanner, row, &cpu_ns, &rss_pages) == 0) {
+            pid_table_keep(&scanner->table, row);
+            *used_ns = cpu_ns >= row->cpu_ns ? cpu_ns - row->cpu_ns : 0;
+            row->cpu_ns = cpu_ns;
+            row->rss_pages = rss_pages;
+            return row;
+        }
+
+        // The process behind the descriptors was reaped: the pid is reused
+        releaseProcessRow(row, scanner);
+        replaced = 1;
+    }
+
+    // Identify the process by its start time
+    ProcessStat stat;
+    ssize_t len = proc_scan_read(&scanner->scan, pid, "stat");
+    if (len <= 0 || parseProcessStat(scanner->scan.buf, (size_t)len, &stat) != 0) {
+        return NULL;  // Exited since the directory was read
+    }
+
+    int fresh;
+    row = pid_table_touch(&scanner->table, pid, stat.starttime, &fresh);
+    if (row == NULL) {
+        return NULL;
+    }
+    cpu_ns = (uint64_t)(stat.ticks * scanner->ns_per_tick);
+    row->rss_pages = stat.rss_pages;
+
+    if (!fresh && !replaced) {
+        *used_ns = cpu_ns >= row->cpu_ns ? cpu_ns - row->cpu_ns : 0;
+        row->cpu_ns = cpu_ns;
+        return row;
+    }
+
+    // A process started during the interval used all its time in it
+    int started_since = scanner->last_ns != 0 && stat.starttime >= scanner->last_boot_ticks;
+    *used_ns = started_since ? cpu_ns : 0;
+    row->cpu_ns = cpu_ns;
+    row->smaps_rss_pages = 0;
+
+    // Keep descriptors for the next scans; their counters are the baseline
+    row->fd = -1;
+    if (keepProcessFiles(scanner, row, pid) == 0) {
+        if (readKeptCounters(scanner, row, &cpu_ns, &rss_pages) == 0) {
+            row->cpu_ns = cpu_ns;
+            row->rss_pages = rss_pages;
+        } else {
+            releaseProcessRow(row, scanner);
+        }
+    }
+    return row;
+}
+
+/**
+ * Current time of a clock
+ * @param clock Clock to read
+ * @return Nanoseconds
+ */
+static uint64_t processClockNs(clockid_t clock) {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * Insert a process into the ranking if it is busy enough
+ * @param sample Section being filled (top kept sorted, highest first)
+ * @param pid Process id
+ * @param cpu_percent CPU usage over the interval (%)
+ */
+static void rankProcess(ProcessSample *sample, int pid, float cpu_percent) {
+    int slot = sample->count;
+
+    if (slot == PROCESS_TOP_COUNT) {
+        if (cpu_percent <= sample->top[PROCESS_TOP_COUNT - 1].cpu_percent) {
+            return;
+        }
+        slot--;
+    } else {
+        sample->count++;
+    }
+
+    while (slot > 0 && sample->top[slot - 1].cpu_percent < cpu_percent) {
+        sample->top[slot] = sample->top[slot - 1];
+        slot--;
+    }
+    sample->top[slot].pid = pid;
+    sample->top[slot].cpu_percent = cpu_percent;
+}
+
+/**
+ * Insert a process into the memory ranking if it is large enough
+ * @param sample Section being filled (memory_top kept sorted, largest first)
+ * @param pid Process id
+ * @param rss_kb Resident set size
+ */
+static void rankProcessMemory(ProcessSample *sample, int pid, uint64_t rss_kb) {
+    int slot = sample->memory_count;
+
+    if (rss_kb == 0) {
+        return;     // Kernel threads
+    }
+    if (slot == PROCESS_TOP_COUNT) {
+        if (rss_kb <= sample->memory_top[PROCESS_TOP_COUNT - 1].rss_kb) {
+            return;
+        }
+        slot--;
+    } else {
+        sample->memory_count++;
+    }
+
+    while (slot > 0 && sample->memory_top[slot - 1].rss_kb < rss_kb) {
+        sample->memory_top[slot] = sample->memory_top[slot - 1];
+        slot--;
+    }
+    sample->memory_top[slot].pid = pid;
+    sample->memory_top[slot].rss_kb = rss_kb;
+}
+
+/**
+ * Read PSS and swap from /proc/[pid]/smaps_rollup
+ * @param scanner Source state
+ * @param pid Process id
+ * @param pss_kb Output PSS
+ * @param swap_kb Output swap
+ * @return 0 on success, -1 if the file is missing or not readable
+ */
+static int readSmapsRollup(ProcessScanner *scanner, int pid, uint64_t *pss_kb, uint64_t *swap_kb) {
+    int found = 0;
+
+    if (proc_scan_read(&scanner->scan, pid, "smaps_rollup") <= 0) {
+        return -1;
+    }
+    for (const char *p = scanner->scan.buf; *p != '\0'; p = proc_next_line(p)) {
+        if (strncmp(p, "Pss:", 4) == 0 && proc_scan_u64(p + 4, pss_kb) != NULL) {
+            found |= 1;
+        } else if (strncmp(p, "Swap:", 5) == 0 && proc_scan_u64(p + 5, swap_kb) != NULL) {
+            found |= 2;
+        }
+    }
+    return found == 3 ? 0 : -1;
+}
+
+/**
+ * Fill in PSS and swap for a process of the memory ranking
+ * The last smaps_rollup reading of the row is reused while its RSS stays
+ * within 1/32 of the RSS it was taken at, for up to PROCESS_SMAPS_MAX_AGE scans.
+ * @param scanner Source state
+ * @param sample Section being filled (counts the reads)
+ * @param entry Ranked process
+ */
+static void measureProcessMemory(ProcessScanner *scanner, ProcessSample *sample, ProcessMemoryEntry *entry) {
+    ProcessRow *row = pid_table_find(&scanner->table, entry->pid);
+    if (row == NULL) {
+        return;
+    }
+
+    uint64_t rss = row->rss_pages;
+    uint64_t drift = rss > row->smaps_rss_pages ? rss - row->smaps_rss_pages : row->smaps_rss_pages - rss;
+    if (row->smaps_rss_pages == 0 || drift > rss / 32 ||
+        scanner->table.generation - row->smaps_generation >= PROCESS_SMAPS_MAX_AGE) {
+        row->smaps_ok = readSmapsRollup(scanner, entry->pid, &row->pss_kb, &row->swap_kb) == 0;
+        row->smaps_rss_pages = rss;
+        row->smaps_generation = scanner->table.generation;
+        sample->smaps_reads++;
+    }
+
+    entry->has_smaps = row->smaps_ok;
+    entry->pss_kb = row->smaps_ok ? row->pss_kb : 0;
+    entry->swap_kb = row->smaps_ok ? row->swap_kb : 0;
+}
+
+/**
+ * Read the stat fields of a ranked process and copy its command name
+ * @param scanner Source state
+ * @param pid Process id
+ * @param stat Output fields
+ * @param comm Output command name (PROCESS_COMM_LENGTH bytes)
+ * @return 0 on success, -1 if the process exited since it was sampled
+ */
+static int readProcessName(ProcessScanner *scanner, int pid, ProcessStat *stat, char *comm) {
+    ssize_t len = proc_scan_read(&scanner->scan, pid, "stat");
+    if (len <= 0 || parseProcessStat(scanner->scan.buf, (size_t)len, stat) != 0) {
+        return -1;
+    }
+
+    size_t comm_len = stat->comm_len < PROCESS_COMM_LENGTH - 1 ? stat->comm_len : PROCESS_COMM_LENGTH - 1;
+    memcpy(comm, stat->comm, comm_len);
+    comm[comm_len] = '\0';
+    return 0;
+}
+
+/**
+ * Fill in the details of the ranked processes
+ * Processes that exited since they were sampled are dropped.
+ * @param scanner Source state
+ * @param sample Section being filled
+ */
+static void describeProcesses(ProcessScanner *scanner, ProcessSample *sample) {
+    ProcessStat stat;
+    int kept = 0;
+
+    for (int i = 0; i < sample->count; i++) {
+        ProcessEntry *entry = &sample->top[i];
+        if (readProcessName(scanner, entry->pid, &stat, entry->comm) != 0) {
+            continue;
+        }
+        entry->threads = stat.threads;
+        entry->state = stat.state;
+        sample->top[kept++] = *entry;
+    }
+    sample->count = kept;
+
+    kept = 0;
+    for (int i = 0; i < sample->memory_count; i++) {
+        ProcessMemoryEntry *entry = &sample->memory_top[i];
+        if (readProcessName(scanner, entry->pid, &stat, entry->comm) != 0) {
+            continue;
+        }
+        measureProcessMemory(scanner, sample, entry);
+        sample->memory_top[kept++] = *entry;
+    }
+    sample->memory_count = kept;
+}
+
+/**
+ * Scan every process once: rank them by CPU usage since the last scan and by RSS
+ * @param scanner Source state
+ * @param sample Output section
+ */
+static void scanProcesses(ProcessScanner *scanner, ProcessSample *sample) {
+    uint64_t start_ns = processClockNs(CLOCK_MONOTONIC);
+    uint64_t boot_ticks = (uint64_t)(processClockNs(CLOCK_BOOTTIME) / 1e9 * scanner->ticks_per_second);
+    double interval_ns = scanner->last_ns == 0 ? 0.0 : (double)(start_ns - scanner->last_ns);
+    int pid;
+
+    sample->total = 0;
+    sample->count = 0;
+    sample->memory_count = 0;
+    sample->smaps_reads = 0;
+
+    pid_table_begin(&scanner->table);
+    proc_scan_rewind(&scanner->scan);
+    while ((pid = proc_scan_next(&scanner->scan)) > 0) {
+        uint64_t used_ns;
+        const ProcessRow *row = sampleProcess(scanner, pid, &used_ns);
+        if (row == NULL) {
+            continue;
+        }
+        sample->total++;
+
+        float cpu_percent = interval_ns > 0.0 ? (float)(100.0 * used_ns / interval_ns) : 0.0f;
+        rankProcess(sample, pid, cpu_percent);
+        rankProcessMemory(sample, pid, row->rss_pages * scanner->page_kb);
+    }
+    uint32_t exited = pid_table_sweep(&scanner->table, releaseProcessRow, scanner);
+    describeProcesses(scanner, sample);
+
+    scanner->last_ns = start_ns;
+    scanner->last_boot_ticks = boot_ticks;
+    sample->scan_ns = processClockNs(CLOCK_MONOTONIC) - start_ns;
+
+    TRACE_INFO("Process scan: %d processes, %u exited, %d smaps reads, %d fds left, %lu us",
+               sample->total, exited, sample->smaps_reads, scanner->fd_budget, sample->scan_ns / 1000);
+}
+
+/**
+ * Number of per-process descriptors the scanner may keep open
+ *
+ * A fixed share of the soft descriptor limit as it is; the limit is not
+ * raised, so the rest of the monitor (and anything it is embedded in)
+ * keeps the headroom it started with.
+ *
+ * @return Descriptor budget
+ */
+static int processFdBudget(void) {
+    struct rlimit limit;
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur <= PROCESS_FD_RESERVE) {
+        return 0;
+    }
+    rlim_t budget = (limit.rlim_cur - PROCESS_FD_RESERVE) / PROCESS_FD_SHARE;
+    return budget < PROCESS_FD_MAX ? (int)budget : PROCESS_FD_MAX;
+}
+
+/**
+ * Process source: open /proc and take the baseline scan
+ * @param state Output state
+ * @return 0 on success, -1 on failure
+ */
+static int processSourceInit(void **state) {
+    ProcessScanner *scanner = calloc(1, sizeof(*scanner));
+    ProcessSample baseline;
+
+    if (scanner == NULL) {
+        return -1;
+    }
+    if (proc_scan_open(&scanner->scan) != 0) {
+        free(scanner);
+        return -1;
+    }
+    if (pid_table_init(&scanner->table, sizeof(ProcessRow), PROCESS_TABLE_INITIAL) != 0) {
+        proc_scan_close(&scanner->scan);
+        free(scanner);
+        return -1;
+    }
+
+    long ticks = sysconf(_SC_CLK_TCK);
+    scanner->ticks_per_second = ticks > 0 ? (double)ticks : 100.0;
+    scanner->ns_per_tick = 1e9 / scanner->ticks_per_second;
+    long page_size = sysconf(_SC_PAGESIZE);
+    scanner->page_kb = page_size > 0 ? (uint64_t)page_size / 1024 : 4;
+    scanner->fd_budget = processFdBudget();
+    LOG_INFO(SYS_MON_SUCCESS, "Process scanner keeps up to %d /proc descriptors open", scanner->fd_budget);
+
+    scanProcesses(scanner, &baseline);
+    *state = scanner;
+    return 0;
+}
+
+/**
+ * Process source: rank the processes by CPU usage since the last scan
+ * @param state Source state
+ * @param snapshot Snapshot being assembled
+ * @return 0
+ */
+static int processSourceCollect(void *state, SystemSnapshot *snapshot) {
+    scanProcesses(state, &snapshot->processes);
+    return 0;
+}
+
+/**
+ * Process source: release state
+ * @param state Source state
+ */
+static void processSourceTeardown(void *state) {
+    ProcessScanner *scanner = state;
+
+    // An empty scan evicts every row and closes its descriptor
+    pid_table_begin(&scanner->table);
+    pid_table_sweep(&scanner->table, releaseProcessRow, scanner);
+    pid_table_free(&scanner->table);
+    proc_scan_close(&scanner->scan);
+    free(scanner);
+}
+#else
+/**
+ * Process source: per-process counters are only read from procfs
+ * @param state Unused
+ * @return -1
+ */
+static int processSourceInit(void **state) {
+    (void)state;
+    return -1;
+}
+
+/**
+ * Process source: never called without init
+ * @param state Unused
+ * @param snapshot Unused
+ * @return -1
+ */
+static int processSourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    (void)snapshot;
+    return -1;
+}
+
+/**
+ * Process source: nothing to release
+ * @param state Unused
+ */
+static void processSourceTeardown(void *state) {
+    (void)state;
+}
+#endif
+
+/**
+ * Process source: description
+ * @return Static string
+ */
+static const char *processSourceDescribe(void) {
+    return "busiest and largest processes (/proc/[pid]/stat, smaps_rollup)";
+}
+
+const MetricSource processMetricSource = {
+    .name = "processes",
+    .section = METRIC_PROCESSES,
+    .period_ms = 1000,
+    .init = processSourceInit,
+    .collect = processSourceCollect,
+    .teardown = processSourceTeardown,
+    .describe = processSourceDescribe
+};
+
+/**
+ * Process sample formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatProcessSample(const ProcessSample *sample, char *buffer, size_t size) {
+    size_t used = 0;
+    int lines = 0;
+    int len;
+
+    len = snprintf(buffer, size, "%d processes (scan %.2f ms)\n",
+                   sample->total, sample->scan_ns / 1e6);
+    if (len < 0 || (size_t)len >= size) {
+        return 0;
+    }
+    used = (size_t)len;
+    lines++;
+
+    for (int i = 0; i < sample->count; i++) {
+        const ProcessEntry *entry = &sample->top[i];
+        len = snprintf(buffer + used, size - used, "%7d %c %7d %6.1f%% %s\n",
+                       entry->pid, entry->state, entry->threads, entry->cpu_percent, entry->comm);
+        if (len < 0 || (size_t)len >= size - used) {
+            buffer[used] = '\0';
+            break;
+        }
+        used += (size_t)len;
+        lines++;
+    }
+    return lines;
+}
+
+/**
+ * Process memory formatting function
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatProcessMemory(const ProcessSample *sample, char *buffer, size_t size) {
+    size_t used = 0;
+    int lines = 0;
+
+    if (size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+
+    for (int i = 0; i < sample->memory_count; i++) {
+        const ProcessMemoryEntry *entry = &sample->memory_top[i];
+        int len;
+        if (entry->has_smaps) {
+            len = snprintf(buffer + used, size - used, "%7d %9.1f %9.1f %9.1f %s\n",
+                           entry->pid, entry->rss_kb / 1024.0, entry->pss_kb / 1024.0,
+                           entry->swap_kb / 1024.0, entry->comm);
+        } else {
+            len = snprintf(buffer + used, size - used, "%7d %9.1f %9s %9s %s\n",
+                           entry->pid, entry->rss_kb / 1024.0, "-", "-", entry->comm);
+        }
+        if (len < 0 || (size_t)len >= size - used) {
+            buffer[used] = '\0';
+            break;
+        }
+        used += (size_t)len;
+        lines++;
+    }
+    return lines;
+}
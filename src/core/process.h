@@ -0,0 +1,85 @@
+#ifndef PROCESS_H
+#define PROCESS_H
+
+#include "../utils/common.h"
+#include <stdint.h>
+
+// Processes kept in the processes section
+#define PROCESS_TOP_COUNT 16
+
+// Command name length, including the NUL (the kernel's TASK_COMM_LEN)
+#define PROCESS_COMM_LENGTH 16
+
+// Text buffer for the formatted processes section
+#define PROCESS_TEXT_BUFFER 2048
+
+/**
+ * One process of the processes section
+ */
+typedef struct {
+    int32_t pid;
+    int32_t threads;                    // Thread count
+    float cpu_percent;                  // Share of one CPU over the interval (%)
+    char state;                         // R, S, D, Z, ... (see proc(5))
+    char comm[PROCESS_COMM_LENGTH];     // Command name
+} ProcessEntry;
+
+/**
+ * One process of the memory ranking
+ */
+typedef struct {
+    int32_t pid;
+    int32_t has_smaps;                  // pss_kb and swap_kb are known (smaps_rollup was readable)
+    uint64_t rss_kb;                    // Resident set size
+    uint64_t pss_kb;                    // Proportional set size (shared pages split between sharers)
+    uint64_t swap_kb;                   // Swapped-out anonymous memory
+    char comm[PROCESS_COMM_LENGTH];     // Command name
+} ProcessMemoryEntry;
+
+/**
+ * Processes section: the busiest processes of one scan
+ *
+ * CPU usage is the CPU time each process used since the previous scan,
+ * so processes that already existed then need to have been seen twice.
+ * RSS is sampled for every process; PSS and swap only for the processes
+ * with the largest RSS.
+ */
+typedef struct {
+    uint64_t scan_ns;                   // Time the /proc scan took
+    int32_t total;                      // Processes found
+    int32_t count;                      // Entries in top
+    ProcessEntry top[PROCESS_TOP_COUNT];    // Highest CPU usage first
+    int32_t memory_count;               // Entries in memory_top
+    int32_t smaps_reads;                // smaps_rollup files read by this scan
+    ProcessMemoryEntry memory_top[PROCESS_TOP_COUNT];   // Largest RSS first
+} ProcessSample;
+
+/**
+ * Process sample formatting function
+ *
+ * Formats a summary line followed by one line per listed process.
+ *
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatProcessSample(const ProcessSample *sample, char *buffer, size_t size);
+
+/**
+ * Process memory formatting function
+ *
+ * Formats one line per process of the memory ranking.
+ *
+ * @param sample Record to format
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @return Number of lines written
+ */
+int formatProcessMemory(const ProcessSample *sample, char *buffer, size_t size);
+
+// Processes section titles
+#define PROCESS_INFO_TITLE "### Processes ### (PID S Threads CPU% Command)"
+#define PROCESS_MEMORY_TITLE "### Process memory ### (PID RSS PSS Swap Command, MB)"
+
+#endif // PROCESS_H
@@ -0,0 +1,241 @@
+#include "scheduler.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
+#define NSEC_PER_SEC 1000000000L
+#define NSEC_PER_MSEC 1000000L
+
+/**
+ * Add a number of milliseconds to a timespec
+ * @param ts Time to advance
+ * @param ms Milliseconds to add
+ */
+static void addMs(struct timespec *ts, int64_t ms) {
+    int64_t nsec = ts->tv_nsec + (ms % 1000) * NSEC_PER_MSEC;
+    ts->tv_sec += ms / 1000 + nsec / NSEC_PER_SEC;
+    ts->tv_nsec = nsec % NSEC_PER_SEC;
+}
+
+#ifndef __linux__
+/**
+ * Difference a - b in nanoseconds
+ */
+static int64_t diffNs(const struct timespec *a, const struct timespec *b) {
+    return (int64_t)(a->tv_sec - b->tv_sec) * NSEC_PER_SEC + (a->tv_nsec - b->tv_nsec);
+}
+#endif
+
+/**
+ * Initialize a scheduler
+ * @param sched Scheduler to initialize
+ * @param epoch Absolute CLOCK_MONOTONIC time of tick 0
+ * @param interval_ms Tick interval in milliseconds
+ * @param stop_fd Descriptor that becomes readable on stop (-1: none)
+ * @return 0 on success, -1 on failure
+ */
+int schedulerInit(Scheduler *sched, const struct timespec *epoch, int interval_ms, int stop_fd) {
+    memset(sched, 0, sizeof(*sched));
+    sched->interval_ms = interval_ms > 0 ? interval_ms : 1;
+    sched->stop_fd = stop_fd;
+    sched->next = *epoch;
+    addMs(&sched->next, sched->interval_ms);
+    sched->timer_fd = -1;
+
+#ifdef __linux__
+    sched->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (sched->timer_fd < 0) {
+        return -1;
+    }
+
+    struct itimerspec spec = {
+        .it_interval = { .tv_sec = sched->interval_ms / 1000,
+                         .tv_nsec = (long)(sched->interval_ms % 1000) * NSEC_PER_MSEC },
+        .it_value = sched->next
+    };
+    if (timerfd_settime(sched->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) != 0) {
+        close(sched->timer_fd);
+        sched->timer_fd = -1;
+        return -1;
+    }
+#endif
+
+    return 0;
+}
+
+/**
+ * Watch a descriptor while waiting for ticks
+ * @param sched Scheduler
+ * @param fd Descriptor to poll
+ * @param events poll() events to wait for
+ * @return Watch index, or -1 if the watch list is full
+ */
+int schedulerWatch(Scheduler *sched, int fd, short events) {
+    if (sched->watch_count == SCHEDULER_MAX_WATCH) {
+        return -1;
+    }
+    int index = sched->watch_count++;
+    sched->watch[index].fd = fd;
+    sched->watch[index].events = events;
+    sched->watch[index].revents = 0;
+    return index;
+}
+
+/**
+ * Copy the poll results of the watched descriptors back
+ * @param sched Scheduler
+ * @param fds Polled set whose watched part starts at first
+ * @param first Index of the first watched descriptor in fds
+ * @return Whether any watched descriptor signalled
+ */
+static int collectWatch(Scheduler *sched, const struct pollfd *fds, int first) {
+    int signalled = 0;
+    for (int i = 0; i < sched->watch_count; i++) {
+        sched->watch[i].revents |= fds[first + i].revents;
+        signalled |= sched->watch[i].revents != 0;
+    }
+    return signalled;
+}
+
+/**
+ * Wait until a descriptor set becomes readable
+ * @param fds Descriptors to poll
+ * @param count Number of descriptors
+ * @param timeout_ms Timeout in milliseconds (-1: no limit)
+ * @return poll() result
+ */
+static int pollRetry(struct pollfd *fds, int count, int timeout_ms) {
+    int ret;
+    do {
+        ret = poll(fds, count, timeout_ms);
+    } while (ret < 0 && errno == EINTR);
+    return ret;
+}
+
+/**
+ * Wait for the next tick
+ * @param sched Scheduler to wait on
+ * @return Number of ticks missed before this one, SCHEDULER_EVENT if a
+ *         watched descriptor signalled first, or -1 on stop or error
+ */
+int schedulerWait(Scheduler *sched) {
+    uint64_t expirations = 0;
+
+    for (int i = 0; i < sched->watch_count; i++) {
+        sched->watch[i].revents = 0;
+    }
+
+#ifdef __linux__
+    // poll() skips negative descriptors, so a missing stop_fd keeps its slot
+    int signalled = 0;
+    struct pollfd fds[2 + SCHEDULER_MAX_WATCH] = {
+        { .fd = sched->timer_fd, .events = POLLIN },
+        { .fd = sched->stop_fd, .events = POLLIN }
+    };
+    memcpy(&fds[2], sched->watch, (size_t)sched->watch_count * sizeof(struct pollfd));
+
+    for (;;) {
+        if (pollRetry(fds, 2 + sched->watch_count, -1) < 0) {
+            return -1;
+        }
+        if (fds[1].revents & (POLLIN | POLLHUP)) {
+            return -1;
+        }
+        signalled |= collectWatch(sched, fds, 2);
+        if (fds[0].revents & POLLIN) {
+            ssize_t n = read(sched->timer_fd, &expirations, sizeof(expirations));
+            if (n == sizeof(expirations) && expirations > 0) {
+                break;
+            }
+            if (n < 0 && errno != EAGAIN && errno != EINTR) {
+                return -1;
+            }
+        }
+        if (signalled) {
+            return SCHEDULER_EVENT;
+        }
+    }
+#else
+    struct pollfd fds[1 + SCHEDULER_MAX_WATCH] = {
+        { .fd = sched->stop_fd, .events = POLLIN }
+    };
+    memcpy(&fds[1], sched->watch, (size_t)sched->watch_count * sizeof(struct pollfd));
+    struct timespec now;
+
+    for (;;) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int64_t remaining = diffNs(&sched->next, &now);
+        if (remaining <= 0) {
+            break;
+        }
+
+        // Round up so the wake-up never lands before the deadline
+        int timeout_ms = (int)((remaining + NSEC_PER_MSEC - 1) / NSEC_PER_MSEC);
+        if (sched->stop_fd < 0 && sched->watch_count == 0) {
+            struct timespec ts = { .tv_sec = remaining / NSEC_PER_SEC,
+                                   .tv_nsec = remaining % NSEC_PER_SEC };
+            nanosleep(&ts, NULL);
+        } else if (pollRetry(fds, 1 + sched->watch_count, timeout_ms) > 0) {
+            if (fds[0].revents & (POLLIN | POLLHUP)) {
+                return -1;
+            }
+            if (collectWatch(sched, fds, 1)) {
+                return SCHEDULER_EVENT;
+            }
+        }
+    }
+
+    // Count every deadline that has passed and move past them
+    expirations = (uint64_t)(diffNs(&now, &sched->next) / ((int64_t)sched->interval_ms * NSEC_PER_MSEC)) + 1;
+    addMs(&sched->next, (int64_t)expirations * sched->interval_ms);
+#endif
+
+    sched->ticks += expirations;
+    sched->missed += expirations - 1;
+    return (int)(expirations - 1);
+}
+
+/**
+ * Release the scheduler's timer
+ * @param sched Scheduler to close
+ */
+void schedulerClose(Scheduler *sched) {
+    if (sched->timer_fd >= 0) {
+        close(sched->timer_fd);
+        sched->timer_fd = -1;
+    }
+}
+
+/**
+ * Parse a sampling interval
+ * @param text Interval text ("2", "0.1" or "100ms")
+ * @return Interval in milliseconds, or -1 if the text is not a positive interval
+ */
+int parseIntervalMs(const char *text) {
+    char *end;
+
+    errno = 0;
+    double value = strtod(text, &end);
+    if (end == text || errno != 0 || value <= 0) {
+        return -1;
+    }
+
+    double ms;
+    if (strcmp(end, "ms") == 0) {
+        ms = value;
+    } else if (*end == '\0' || strcmp(end, "s") == 0) {
+        ms = value * 1000.0;
+    } else {
+        return -1;
+    }
+
+    if (ms < 1.0 || ms > 86400000.0) {
+        return -1;
+    }
+    return (int)(ms + 0.5);
+}
@@ -0,0 +1,88 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <poll.h>
+#include <stdint.h>
+#include <time.h>
+
+// Extra descriptors a scheduler can watch between ticks
+#define SCHEDULER_MAX_WATCH 8
+
+// schedulerWait result when a watched descriptor signalled before the tick
+#define SCHEDULER_EVENT (-2)
+
+/**
+ * Periodic sampling scheduler
+ *
+ * Ticks fall on absolute CLOCK_MONOTONIC deadlines (epoch + k * interval),
+ * so the time spent collecting never accumulates as drift, and schedulers
+ * sharing an epoch stay in phase. On Linux each scheduler is a timerfd;
+ * elsewhere the deadlines are tracked by hand and slept with poll().
+ * Watched descriptors are polled in the same call, so an event can wake
+ * the caller between ticks.
+ */
+typedef struct {
+    int timer_fd;               // timerfd (-1 when emulated)
+    int stop_fd;                // Becomes readable when sampling should stop
+    struct timespec next;       // Next deadline (emulated path only)
+    int interval_ms;            // Tick interval in milliseconds
+    uint64_t ticks;             // Ticks consumed so far
+    uint64_t missed;            // Ticks that expired before the caller waited
+    int watch_count;            // Watched descriptors in use
+    struct pollfd watch[SCHEDULER_MAX_WATCH];   // revents: what signalled during the last wait
+} Scheduler;
+
+/**
+ * Initialize a scheduler
+ *
+ * @param sched Scheduler to initialize
+ * @param epoch Absolute CLOCK_MONOTONIC time of tick 0
+ * @param interval_ms Tick interval in milliseconds
+ * @param stop_fd Descriptor that becomes readable on stop (-1: none)
+ * @return 0 on success, -1 on failure
+ */
+int schedulerInit(Scheduler *sched, const struct timespec *epoch, int interval_ms, int stop_fd);
+
+/**
+ * Watch a descriptor while waiting for ticks
+ *
+ * @param sched Scheduler
+ * @param fd Descriptor to poll
+ * @param events poll() events to wait for (e.g. POLLPRI)
+ * @return Watch index, or -1 if SCHEDULER_MAX_WATCH descriptors are already watched
+ */
+int schedulerWatch(Scheduler *sched, int fd, short events);
+
+/**
+ * Wait for the next tick
+ *
+ * Returns immediately if one or more deadlines already passed; those
+ * extra deadlines are reported as missed instead of being replayed.
+ * After every return, watch[i].revents tells which watched descriptors
+ * signalled, including when the tick came at the same time.
+ *
+ * @param sched Scheduler to wait on
+ * @return Number of ticks missed before this one, SCHEDULER_EVENT if a
+ *         watched descriptor signalled first, or -1 on stop or error
+ */
+int schedulerWait(Scheduler *sched);
+
+/**
+ * Release the scheduler's timer
+ *
+ * @param sched Scheduler to close
+ */
+void schedulerClose(Scheduler *sched);
+
+/**
+ * Parse a sampling interval
+ *
+ * Accepts seconds with an optional fraction ("2", "0.1") or milliseconds
+ * with an "ms" suffix ("100ms").
+ *
+ * @param text Interval text
+ * @return Interval in milliseconds, or -1 if the text is not a positive interval
+ */
+int parseIntervalMs(const char *text);
+
+#endif // SCHEDULER_H
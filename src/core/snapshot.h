@@ -0,0 +1,111 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "common.h"
+#include "cpu.h"
+#include "memory.h"
+#include "process.h"
+#include "pressure.h"
+#include "disk.h"
+#include "net.h"
+#include "cgroup.h"
+#include "cgroup_tree.h"
+#include <stdint.h>
+
+/**
+ * Snapshot sections
+ * Each metric source fills exactly one section.
+ */
+typedef enum {
+    METRIC_CPU = 0,     // Aggregate and per-core CPU counters
+    METRIC_MEMORY,      // Memory counters
+    METRIC_USERS,       // User sessions
+    METRIC_SYSTEM,      // Host identity and uptime
+    METRIC_PROCESSES,   // Busiest processes
+    METRIC_PRESSURE,    // Pressure stall information
+    METRIC_DISKS,       // Block device I/O
+    METRIC_NETWORK,     // Network interface traffic
+    METRIC_CGROUP,      // Own (or selected) cgroup against its limits
+    METRIC_CGROUP_TREE, // Busiest groups of the whole cgroup hierarchy
+    METRIC_SECTIONS     // Number of sections
+} MetricId;
+
+// Section selection masks
+#define COLLECT_CPU     (1u << METRIC_CPU)
+#define COLLECT_MEMORY  (1u << METRIC_MEMORY)
+#define COLLECT_USERS   (1u << METRIC_USERS)
+#define COLLECT_SYSTEM  (1u << METRIC_SYSTEM)
+#define COLLECT_PROCESSES (1u << METRIC_PROCESSES)
+#define COLLECT_PRESSURE (1u << METRIC_PRESSURE)
+#define COLLECT_DISKS   (1u << METRIC_DISKS)
+#define COLLECT_NETWORK (1u << METRIC_NETWORK)
+#define COLLECT_CGROUP  (1u << METRIC_CGROUP)
+#define COLLECT_CGROUP_TREE (1u << METRIC_CGROUP_TREE)
+#define COLLECT_ALL     ((1u << METRIC_SECTIONS) - 1)
+
+// uname() field length used by the system section
+#define SYSTEM_NAME_LENGTH 65
+
+/**
+ * CPU section: /proc/stat aggregate counters at both ends of the interval,
+ * plus the per-core usage and scheduler activity parsed from the same read
+ */
+typedef struct {
+    unsigned long prev[7];
+    unsigned long curr[7];
+    CPUActivity activity;
+    CPUCoreSample cores;
+} CPUSample;
+
+/**
+ * Users section: one session per line
+ */
+typedef struct {
+    int count;                      // Number of sessions
+    char text[MAX_USER_BUFFER];     // Formatted session lines
+} UserSample;
+
+/**
+ * System section: uname fields and uptime
+ */
+typedef struct {
+    char sysname[SYSTEM_NAME_LENGTH];
+    char nodename[SYSTEM_NAME_LENGTH];
+    char release[SYSTEM_NAME_LENGTH];
+    char version[SYSTEM_NAME_LENGTH];
+    char machine[SYSTEM_NAME_LENGTH];
+    int uptime_days;
+    int uptime_hours;
+    int uptime_minutes;
+    int uptime_seconds;
+} SystemInfoSample;
+
+/**
+ * System snapshot
+ *
+ * One record per scheduler tick holding every enabled section. Arrays are
+ * bounded so the record is fixed-size and can travel through a ring as is.
+ * Sections whose source was not due this tick keep their last value;
+ * updated tells which ones were refreshed. A source event can also
+ * publish a record between two ticks, with only that source refreshed.
+ */
+typedef struct {
+    uint64_t timestamp_ns;      // CLOCK_MONOTONIC time of the tick
+    uint64_t tick;              // Tick number since the engine started
+    int missed;                 // Ticks skipped since the previous snapshot
+    unsigned int updated;       // COLLECT_* bits refreshed this tick
+    unsigned int signalled;     // COLLECT_* bits collected because their source signalled an event
+    int between_ticks;          // Published on an event, not on a tick (does not count as a sample)
+    CPUSample cpu;
+    MemorySample memory;
+    UserSample users;
+    SystemInfoSample system;
+    ProcessSample processes;
+    PressureSample pressure;
+    DiskSample disks;
+    NetSample network;
+    CgroupSample cgroup;
+    CgroupTreeSample cgroup_tree;
+} SystemSnapshot;
+
+#endif // SNAPSHOT_H
@@ -3,12 +3,15 @@
 #include "memory.h"
 #include "cpu.h"
 #include "user.h"
+#include "pressure.h"
+#include "scheduler.h"
+#include "metric_source.h"
 #include <getopt.h>
 #include <signal.h>
 
 // 전역 변수
 volatile sig_atomic_t exit_flag = 0;
-static ProcessIDs process_ids = {-1, -1, -1};
+volatile sig_atomic_t redraw_flag = 0;  // 터미널에 화면 버퍼 밖의 출력이 생겨 전체를 다시 그려야 함
 
 /**
  * Ctrl+Z 처리 함수 - SIGTSTP 신호를 무시하도록 설정
@@ -24,32 +27,6 @@ static void handleCtrlZ() {
     }
 }
 
-/**
- * 자식 프로세스 설정 함수 - 신호 처리 설정
- */
-static void childProcessFunction() {
-    // 자식 프로세스에서는 신호를 무시하도록 설정
-    signal(SIGINT, SIG_IGN);
-    signal(SIGTSTP, SIG_IGN);
-}
-
-/**
- * 자식 프로세스 종료 및 정리 함수
- */
-static void cleanupChildProcesses() {
-    int status;
-    
-    // 자식 프로세스 종료 신호 전송
-    if (process_ids.memPID > 0) kill(process_ids.memPID, SIGTERM);
-    if (process_ids.userPID > 0) kill(process_ids.userPID, SIGTERM);
-    if (process_ids.cpuPID > 0) kill(process_ids.cpuPID, SIGTERM);
-    
-    // 자식 프로세스 종료 대기
-    if (process_ids.memPID > 0) waitpid(process_ids.memPID, &status, 0);
-    if (process_ids.userPID > 0) waitpid(process_ids.userPID, &status, 0);
-    if (process_ids.cpuPID > 0) waitpid(process_ids.cpuPID, &status, 0);
-}
-
 /**
  * SIGINT(Ctrl+C) 처리 함수
  * @param signal 신호 번호
@@ -69,16 +46,29 @@ static void signalHandler(int signal) {
             
             // 대소문자 구분 없이 y 또는 yes 확인
             if (strcasecmp(userInput, "y") == 0 || strcasecmp(userInput, "yes") == 0) {
+                // 수집 스레드는 프로세스 종료와 함께 정리됨
                 printf("Terminating...\n");
-                cleanupChildProcesses();
                 exit(EXIT_SUCCESS);
             } else {
                 printf("Continuing...\n");
             }
         }
+        
+        // 프롬프트가 화면에 남거나 화면을 밀어 올렸으므로 다음 프레임은 전체를 그림
+        redraw_flag = 1;
     }
 }
 
+/**
+ * SIGCONT 처리 함수
+ * 정지된 동안 다른 프로그램이 터미널을 사용했을 수 있으므로 전체를 다시 그리게 합니다.
+ * @param signal 신호 번호
+ */
+static void continueHandler(int signal) {
+    (void)signal;
+    redraw_flag = 1;
+}
+
 /**
  * 신호 핸들러 설정 함수
  */
@@ -96,6 +86,45 @@ void setupSignalHandlers() {
         perror("sigaction error for SIGINT");
         exit(EXIT_FAILURE);
     }
+    
+    // SIGCONT 핸들러 설정 (SIGSTOP 후 재개)
+    sa.sa_handler = continueHandler;
+    if (sigaction(SIGCONT, &sa, NULL) == -1) {
+        perror("sigaction error for SIGCONT");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * 샘플링 간격 옵션 설정 함수
+ * 초 단위 소수("0.1") 또는 밀리초("100ms")를 받으며, 잘못된 값은 무시합니다.
+ * @param options 프로그램 옵션 구조체
+ * @param text 간격 문자열
+ */
+static void setDelayOption(ProgramOptions *options, const char *text) {
+    int ms = parseIntervalMs(text);
+    if (ms < 0) {
+        fprintf(stderr, "Invalid delay '%s', using %d ms\n", text, options->tdelay_ms);
+        return;
+    }
+    options->tdelay_ms = ms;
+}
+
+/**
+ * 압력 트리거 옵션 설정 함수
+ * 창(PRESSURE_WINDOW_MS) 안의 정체 시간 임계값을 밀리초로 받으며, 0은 트리거 없이 주기 수집만 합니다.
+ * @param options 프로그램 옵션 구조체
+ * @param text 임계값 문자열
+ */
+static void setPressureOption(ProgramOptions *options, const char *text) {
+    char *end;
+    long ms = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || ms < 0 || ms > PRESSURE_WINDOW_MS) {
+        fprintf(stderr, "Invalid pressure threshold '%s' (0-%d ms), using %d ms\n",
+                text, PRESSURE_WINDOW_MS, options->pressure_stall_ms);
+        return;
+    }
+    options->pressure_stall_ms = (int)ms;
 }
 
 /**
@@ -107,11 +136,20 @@ void setupSignalHandlers() {
 ProgramOptions parseCommandLineOptions(int argc, char *argv[]) {
     ProgramOptions options = {
         .samples = DEFAULT_SAMPLES,
-        .tdelay = DEFAULT_DELAY,
+        .tdelay_ms = DEFAULT_DELAY_MS,
         .user = 0,
         .system = 0,
         .sequential = 0,
-        .graphics = 0
+        .graphics = 0,
+        .cores = 0,
+        .processes = 0,
+        .pressure = 0,
+        .pressure_stall_ms = PRESSURE_DEFAULT_STALL_MS,
+        .disks = 0,
+        .network = 0,
+        .cgroup = 0,
+        .cgroup_path = NULL,
+        .cgroup_tree = 0
     };
     
     // 명령행 옵션 구조체
@@ -119,6 +157,13 @@ ProgramOptions parseCommandLineOptions(int argc, char *argv[]) {
         {"system", no_argument, 0, 's'}, 
         {"user", no_argument, 0, 'u'}, 
         {"graphics", no_argument, 0, 'g'},        
+        {"cores", no_argument, 0, 'p'},
+        {"processes", no_argument, 0, 't'},
+        {"pressure", optional_argument, 0, 'P'},
+        {"disks", no_argument, 0, 'd'},
+        {"network", no_argument, 0, 'n'},
+        {"cgroup", optional_argument, 0, 'C'},
+        {"cgroup-tree", no_argument, 0, 'T'},
         {"sequential", no_argument, 0, 'a'}, 
         {"samples", optional_argument, 0, 'b'},
         {"tdelay", optional_argument, 0, 'c'},
@@ -127,14 +172,27 @@ ProgramOptions parseCommandLineOptions(int argc, char *argv[]) {
     
     // 옵션 처리
     int opt;
-    while ((opt = getopt_long(argc, argv, "sugab::c::", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "sugptP::dnC::Tab::c::", long_options, NULL)) != -1) {
         switch (opt) {
             case 's': options.system = 1; break;
             case 'u': options.user = 1; break;
             case 'g': options.graphics = 1; break;
+            case 'p': options.cores = 1; break;
+            case 't': options.processes = 1; break;
+            case 'P':
+                options.pressure = 1;
+                if (optarg) setPressureOption(&options, optarg);
+                break;
+            case 'd': options.disks = 1; break;
+            case 'n': options.network = 1; break;
+            case 'C':
+                options.cgroup = 1;
+                if (optarg) options.cgroup_path = optarg;
+                break;
+            case 'T': options.cgroup_tree = 1; break;
             case 'a': options.sequential = 1; break;
             case 'b': if (optarg) options.samples = atoi(optarg); break;
-            case 'c': if (optarg) options.tdelay = atoi(optarg); break;
+            case 'c': if (optarg) setDelayOption(&options, optarg); break;
         }
     }
     
@@ -142,7 +200,7 @@ ProgramOptions parseCommandLineOptions(int argc, char *argv[]) {
     for (int ind = optind, i = 0; ind < argc; ind++, i++) {
         switch (i) {
             case 0: options.samples = atoi(argv[ind]); break;
-            case 1: options.tdelay = atoi(argv[ind]); break;
+            case 1: setDelayOption(&options, argv[ind]); break;
         }
     }
     
@@ -150,169 +208,100 @@ ProgramOptions parseCommandLineOptions(int argc, char *argv[]) {
 }
 
 /**
- * 상단 정보 출력 함수
+ * 상단 정보 포맷 함수
+ * @param buffer 출력 버퍼
+ * @param size 버퍼 크기
  * @param samples 샘플 수
- * @param tdelay 지연 시간(초)
+ * @param tdelay_ms 지연 시간(밀리초)
  * @param sequential 순차 모드 여부
  * @param iteration 현재 반복 인덱스
  */
-void printTopInfo(int samples, int tdelay, int sequential, int iteration) {
+void formatTopInfo(char *buffer, size_t size, int samples, int tdelay_ms, int sequential, int iteration) {
     struct rusage usage_info;
+    int len;
     
     int result = getrusage(RUSAGE_SELF, &usage_info);
     if (sequential) {
-        printf(">>> iteration %d\n", iteration);
+        len = snprintf(buffer, size, ">>> iteration %d\n", iteration);
     } else {
-        printf("\033[H\033[2J"); // 화면 지우기
-        printf("Nbr of samples: %d-- every %d secs\n", samples, tdelay);
+        len = snprintf(buffer, size, "Nbr of samples: %d-- every %g secs\n", samples, tdelay_ms / 1000.0);
+    }
+    if (len < 0 || (size_t)len >= size) {
+        return;
     }
     
     if (result == 0) {
-        printf("Memory usage: %ld kilobytes\n", usage_info.ru_maxrss);
+        snprintf(buffer + len, size - len, "Memory usage: %ld kilobytes\n", usage_info.ru_maxrss);
     } else {
-        printf("Failed to get resource usage info\n");
+        snprintf(buffer + len, size - len, "Failed to get resource usage info\n");
     }
 }
 
 /**
- * 시스템 정보 출력 함수
+ * 시스템 메트릭 소스 수집 함수
+ * uname 정보와 가동 시간을 스냅샷의 system 섹션에 저장합니다.
+ * @param state 사용하지 않음
+ * @param snapshot 작성 중인 스냅샷
+ * @return 성공 시 0, 실패 시 -1
  */
-void printSystemInfo() {
-    struct utsname sysinfo;
-    int days, hours, minutes, seconds;
+static int systemSourceCollect(void *state, SystemSnapshot *snapshot) {
+    SystemInfoSample *info = &snapshot->system;
+    struct utsname names;
+    (void)state;
     
     // 플랫폼 독립적 함수로 시스템 가동 시간 가져오기
-    get_system_uptime(&days, &hours, &minutes, &seconds);
-    
-    // 일(days)을 시간으로 변환하여 총 시간 계산
-    int days_to_hr = 24 * days;
-    int total_hr = days_to_hr + hours;
+    get_system_uptime(&info->uptime_days, &info->uptime_hours,
+                      &info->uptime_minutes, &info->uptime_seconds);
     
-    if (uname(&sysinfo) == 0) {
-        printf("### System Information ###\n");
-        printf("System Name = %s\n", sysinfo.sysname);
-        printf("Machine Name= %s\n", sysinfo.nodename);
-        printf("Version= %s\n", sysinfo.version);
-        printf("Release= %s\n", sysinfo.release);
-        printf("Architecture= %s\n", sysinfo.machine);
-        printf("System running since last reboot: %d days %02d:%02d:%02d (%02d:%02d:%02d)\n",
-               days, hours, minutes, seconds, total_hr, minutes, seconds);
-    } else {
-        perror("Error getting system information");
+    if (uname(&names) != 0) {
+        info->sysname[0] = '\0';
+        return -1;
     }
+    
+    snprintf(info->sysname, sizeof(info->sysname), "%s", names.sysname);
+    snprintf(info->nodename, sizeof(info->nodename), "%s", names.nodename);
+    snprintf(info->release, sizeof(info->release), "%s", names.release);
+    snprintf(info->version, sizeof(info->version), "%s", names.version);
+    snprintf(info->machine, sizeof(info->machine), "%s", names.machine);
+    return 0;
 }
 
 /**
- * 파이프 설정 함수
- * @param pipes 파이프 구조체 포인터
- * @return 성공 시 STATUS_SUCCESS, 실패 시 오류 코드
+ * 시스템 메트릭 소스 설명 함수
+ * @return 설명 문자열
  */
-static int setupPipes(PipeSet *pipes) {
-    if (pipe(pipes->memFD) == -1 || pipe(pipes->userFD) == -1 || 
-        pipe(pipes->cpuPFD) == -1 || pipe(pipes->cpuCFD) == -1 || pipe(pipes->ucountFD) == -1) {
-        perror("Pipe creation failed");
-        return STATUS_ERROR_PIPE;
-    }
-    return STATUS_SUCCESS;
+static const char *systemSourceDescribe(void) {
+    return "host identity (uname) and uptime";
 }
 
+const MetricSource systemMetricSource = {
+    .name = "system",
+    .section = METRIC_SYSTEM,
+    .period_ms = 1000,  // 자주 바뀌지 않으므로 최대 초당 1회
+    .collect = systemSourceCollect,
+    .describe = systemSourceDescribe
+};
+
 /**
- * 자식 프로세스 생성 및 관리 함수
- * @param samples 샘플 수
- * @param tdelay 지연 시간(초)
- * @param pipes 파이프 구조체 포인터
- * @return 프로세스 ID 구조체
+ * 시스템 정보 출력 함수
+ * @param info 스냅샷의 시스템 섹션
  */
-ProcessIDs createChildProcesses(int samples, int tdelay, PipeSet *pipes) {
-    // 파이프 설정
-    if (setupPipes(pipes) != STATUS_SUCCESS) {
-        exit(EXIT_FAILURE);
-    }
-    
-    // 메모리 정보 수집 자식 프로세스 생성
-    process_ids.memPID = fork();
-    if (process_ids.memPID == -1) {
-        perror("Memory fork failed");
-        exit(EXIT_FAILURE);
-    } else if (process_ids.memPID == 0) {
-        childProcessFunction();
-        
-        // 사용하지 않는 파이프 닫기
-        close(pipes->cpuPFD[0]); close(pipes->cpuPFD[1]);
-        close(pipes->cpuCFD[0]); close(pipes->cpuCFD[1]);
-        close(pipes->userFD[0]); close(pipes->userFD[1]);
-        close(pipes->ucountFD[0]); close(pipes->ucountFD[1]);
-        close(pipes->memFD[0]); // 읽기 종단 닫기
-        
-        // 메모리 정보 수집 및 전송 - 매개변수 순서 수정
-        storeMemoryInfo(tdelay, samples, pipes->memFD);
-        
-        close(pipes->memFD[1]);
-        exit(EXIT_SUCCESS);
-    }
-    
-    // 사용자 정보 수집 자식 프로세스 생성
-    process_ids.userPID = fork();
-    if (process_ids.userPID == -1) {
-        perror("User fork failed");
-        kill(process_ids.memPID, SIGTERM);
-        waitpid(process_ids.memPID, NULL, 0);
-        exit(EXIT_FAILURE);
-    } else if (process_ids.userPID == 0) {
-        childProcessFunction();
-        
-        // 사용하지 않는 파이프 닫기
-        close(pipes->cpuPFD[0]); close(pipes->cpuPFD[1]);
-        close(pipes->cpuCFD[0]); close(pipes->cpuCFD[1]);
-        close(pipes->memFD[0]); close(pipes->memFD[1]);
-        close(pipes->userFD[0]); // 읽기 종단 닫기
-        close(pipes->ucountFD[0]); // 읽기 종단 닫기
-        
-        // 사용자 정보 수집 및 전송
-        storeUserInfo(pipes->userFD, pipes->ucountFD);
-        
-        close(pipes->userFD[1]);
-        close(pipes->ucountFD[1]);
-        exit(EXIT_SUCCESS);
-    }
+void printSystemInfo(const SystemInfoSample *info) {
+    // 일(days)을 시간으로 변환하여 총 시간 계산
+    int days_to_hr = 24 * info->uptime_days;
+    int total_hr = days_to_hr + info->uptime_hours;
     
-    // CPU 정보 수집 자식 프로세스 생성
-    process_ids.cpuPID = fork();
-    if (process_ids.cpuPID == -1) {
-        perror("CPU fork failed");
-        kill(process_ids.memPID, SIGTERM);
-        kill(process_ids.userPID, SIGTERM);
-        waitpid(process_ids.memPID, NULL, 0);
-        waitpid(process_ids.userPID, NULL, 0);
-        exit(EXIT_FAILURE);
-    } else if (process_ids.cpuPID == 0) {
-        childProcessFunction();
-        
-        // 사용하지 않는 파이프 닫기
-        close(pipes->memFD[0]); close(pipes->memFD[1]);
-        close(pipes->userFD[0]); close(pipes->userFD[1]);
-        close(pipes->ucountFD[0]); close(pipes->ucountFD[1]);
-        close(pipes->cpuPFD[0]); // 읽기 종단 닫기
-        close(pipes->cpuCFD[0]); // 읽기 종단 닫기
-        
-        // CPU 정보 수집 및 전송
-        for (int i = 0; i < samples; i++) {
-            storeCPUInfo(pipes->cpuPFD);
-            sleep(tdelay);
-            storeCPUInfo(pipes->cpuCFD);
-        }
-        
-        close(pipes->cpuPFD[1]);
-        close(pipes->cpuCFD[1]);
-        exit(EXIT_SUCCESS);
+    if (info->sysname[0] != '\0') {
+        printf("### System Information ###\n");
+        printf("System Name = %s\n", info->sysname);
+        printf("Machine Name= %s\n", info->nodename);
+        printf("Version= %s\n", info->version);
+        printf("Release= %s\n", info->release);
+        printf("Architecture= %s\n", info->machine);
+        printf("System running since last reboot: %d days %02d:%02d:%02d (%02d:%02d:%02d)\n",
+               info->uptime_days, info->uptime_hours, info->uptime_minutes, info->uptime_seconds,
+               total_hr, info->uptime_minutes, info->uptime_seconds);
+    } else {
+        printf("Error getting system information\n");
     }
-    
-    // 부모 프로세스에서는 쓰기용 파이프 닫기
-    close(pipes->memFD[1]);
-    close(pipes->userFD[1]);
-    close(pipes->cpuPFD[1]);
-    close(pipes->cpuCFD[1]);
-    close(pipes->ucountFD[1]);
-    
-    return process_ids;
-} 
\ No newline at end of file
+}
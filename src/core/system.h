@@ -2,14 +2,17 @@
 #define SYSTEM_H
 
 #include "common.h"
+#include "snapshot.h"
 
 /**
  * System information output function
  * 
- * Collects and outputs basic system information including OS name, version, hostname, 
- * architecture, and uptime.
+ * Outputs basic system information including OS name, version, hostname, 
+ * architecture, and uptime, as collected by the system metric source.
+ * 
+ * @param info System section of a snapshot
  */
-void printSystemInfo(void);
+void printSystemInfo(const SystemInfoSample *info);
 
 /**
  * System uptime information collection function
@@ -24,21 +27,20 @@ void printSystemInfo(void);
  */
 void getSystemUptimeInfo(int *days, int *hours, int *minutes, int *seconds);
 
-// Top information output function
-void printTopInfo(int samples, int tdelay, int sequential, int iteration);
-
 /**
- * Child process creation function
+ * Top information formatting function
  * 
- * Creates child processes to collect CPU, memory, and user information.
- * Each child process collects specific information and sends it back to the parent process through pipes.
+ * Formats the sample count (or iteration) line and the monitor's own
+ * memory usage line.
  * 
- * @param samples Number of samples to collect
- * @param tdelay Sampling interval (seconds)
- * @param pipes Pointer to pipe structure
- * @return Process ID structure of created processes
+ * @param buffer Output buffer
+ * @param size Buffer size
+ * @param samples Number of samples
+ * @param tdelay_ms Delay between samples (milliseconds)
+ * @param sequential Whether sequential mode is enabled
+ * @param iteration Current iteration index
  */
-ProcessIDs createChildProcesses(int samples, int tdelay, PipeSet *pipes);
+void formatTopInfo(char *buffer, size_t size, int samples, int tdelay_ms, int sequential, int iteration);
 
 // Signal handler setup function
 void setupSignalHandlers(void);
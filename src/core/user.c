@@ -1,4 +1,5 @@
 #include "user.h"
+#include "metric_source.h"
 #include <signal.h>
 
 #ifdef __APPLE__
@@ -9,15 +10,17 @@
 #endif
 
 /**
- * 사용자 정보 수집 및 파이프로 전송하는 함수
- * @param userFD 사용자 정보 파이프 파일 디스크립터 배열
- * @param ucountFD 사용자 수 파이프 파일 디스크립터 배열
+ * 사용자 정보를 수집하여 버퍼에 저장하는 함수
+ * @param all_users 사용자 정보를 저장할 버퍼 (한 줄에 한 세션)
+ * @param size 버퍼 크기
+ * @return 사용자 세션 수
  */
-void storeUserInfo(int userFD[2], int ucountFD[2]) {
+int storeUserInfo(char *all_users, size_t size) {
+    all_users[0] = '\0';
+    
 #ifdef __APPLE__
     struct utmpx *utmp;
     int userLine_count = 0;
-    char all_users[MAX_USER_BUFFER] = {0};
 
     setutxent(); // utmp 파일 열기
 
@@ -29,7 +32,7 @@ void storeUserInfo(int userFD[2], int ucountFD[2]) {
                     utmp->ut_user, utmp->ut_line, utmp->ut_host);
             
             // 모든 사용자 정보를 하나의 큰 버퍼에 누적
-            strncat(all_users, buffer, sizeof(all_users) - strlen(all_users) - 1);
+            strncat(all_users, buffer, size - strlen(all_users) - 1);
             userLine_count++;
         }
     }
@@ -38,11 +41,10 @@ void storeUserInfo(int userFD[2], int ucountFD[2]) {
 #else
     struct utmp *utmp;
     int userLine_count = 0;
-    char all_users[MAX_USER_BUFFER] = {0};
     
     if (utmpname(_PATH_UTMP) == -1) {
         perror("Error setting utmp file");
-        return;
+        return 0;
     }
 
     setutent(); // utmp 파일 열기
@@ -55,7 +57,7 @@ void storeUserInfo(int userFD[2], int ucountFD[2]) {
                     utmp->ut_user, utmp->ut_line, utmp->ut_host);
             
             // 모든 사용자 정보를 하나의 큰 버퍼에 누적
-            strncat(all_users, buffer, sizeof(all_users) - strlen(all_users) - 1);
+            strncat(all_users, buffer, size - strlen(all_users) - 1);
             userLine_count++;
         }
     }
@@ -63,45 +65,33 @@ void storeUserInfo(int userFD[2], int ucountFD[2]) {
     endutent(); // utmp 파일 닫기
 #endif
 
-    // 먼저 사용자 수 전송
-    if (write(ucountFD[1], &userLine_count, sizeof(userLine_count)) == -1) {
-        perror("Error writing user count to pipe");
-        return;
-    }
+    return userLine_count;
+}
 
-    // 전체 사용자 정보 한 번에 전송
-    size_t len = strlen(all_users) + 1;
-    
-    if (write(userFD[1], &len, sizeof(len)) == -1 || 
-        write(userFD[1], all_users, len) == -1) {
-        perror("Error writing user data to pipe");
-        return;
-    }
+/**
+ * 사용자 메트릭 소스 수집 함수
+ * @param state 사용하지 않음
+ * @param snapshot 작성 중인 스냅샷
+ * @return 0
+ */
+static int userSourceCollect(void *state, SystemSnapshot *snapshot) {
+    (void)state;
+    snapshot->users.count = storeUserInfo(snapshot->users.text, sizeof(snapshot->users.text));
+    return 0;
 }
 
 /**
- * 사용자 정보 출력 함수
- * @param userFD 사용자 정보 파이프 파일 디스크립터 배열
+ * 사용자 메트릭 소스 설명 함수
+ * @return 설명 문자열
  */
-void printUserInfo(int userFD[2]) {
-    size_t len = 0;
-    char buffer[MAX_USER_BUFFER] = {0};
-    
-    printf("### Sessions/users ###\n");
-    
-    // 먼저 데이터 길이 읽기
-    if (read(userFD[0], &len, sizeof(len)) <= 0 || len > sizeof(buffer)) {
-        printf("No active user sessions\n");
-        return;
-    }
-    
-    // 실제 데이터 읽기
-    ssize_t bytesRead = read(userFD[0], buffer, len);
-    
-    if (bytesRead > 0) {
-        buffer[bytesRead] = '\0'; // null 종료 보장
-        printf("%s", buffer);
-    } else {
-        printf("No active user sessions\n");
-    }
-} 
\ No newline at end of file
+static const char *userSourceDescribe(void) {
+    return "logged-in user sessions (utmp)";
+}
+
+const MetricSource userMetricSource = {
+    .name = "users",
+    .section = METRIC_USERS,
+    .period_ms = 0,
+    .collect = userSourceCollect,
+    .describe = userSourceDescribe
+};
@@ -6,13 +6,14 @@
 /**
  * User information collection and storage function
  * 
- * Collects information about current user sessions and sends it through pipes.
- * This function is called by child processes to monitor session status.
+ * Collects information about current user sessions into a buffer, one session per line.
+ * This function is called by the user collector thread to monitor session status.
  * 
- * @param userFD Pipe file descriptor for user information
- * @param ucountFD Pipe file descriptor for user count
+ * @param all_users Output buffer
+ * @param size Buffer size
+ * @return Number of active user sessions
  */
-void storeUserInfo(int userFD[2], int ucountFD[2]);
+int storeUserInfo(char *all_users, size_t size);
 
 /**
  * Current user count function
@@ -23,7 +24,8 @@ void storeUserInfo(int userFD[2], int ucountFD[2]);
  */
 int getUserCount(void);
 
-// User information output function
-void printUserInfo(int userFD[2]);
+// Sessions section title and empty-section text
+#define USER_INFO_TITLE "### Sessions/users ###"
+#define USER_INFO_NONE "No active user sessions"
 
 #endif // USER_H 
\ No newline at end of file
@@ -0,0 +1,497 @@
+#include "graph.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * Make room for a number of columns
+ * @param series Series to grow
+ * @param columns Columns needed
+ * @return 0 on success, -1 on allocation failure
+ */
+static int reserve_columns(GraphSeries *series, int columns) {
+    if (columns <= series->capacity) {
+        return 0;
+    }
+
+    float *min = realloc(series->min, (size_t)columns * sizeof(float));
+    if (min == NULL) {
+        return -1;
+    }
+    series->min = min;
+
+    float *max = realloc(series->max, (size_t)columns * sizeof(float));
+    if (max == NULL) {
+        return -1;
+    }
+    series->max = max;
+
+    series->capacity = columns;
+    return 0;
+}
+
+/**
+ * Recompute one column from the points it covers
+ * @param series Series being updated (tier, per_column and newest_column set)
+ * @param history Source history
+ * @param c Column slot
+ * @param oldest Absolute index of the oldest point still held by the tier
+ * @param total Points pushed to the tier so far
+ * @return 1 if the column holds data, 0 if it is empty
+ */
+static int fill_column(GraphSeries *series, const history_t *history, int c, int64_t oldest, uint64_t total) {
+    int64_t start = (series->newest_column - (series->columns - 1) + c) * series->per_column;
+    int64_t end = start + series->per_column;
+    if (start < oldest) start = oldest;
+    if (end > (int64_t)total) end = (int64_t)total;
+    if (start >= end) {
+        return 0;
+    }
+
+    history_point_t point = history_at(history, series->tier, (int)(start - oldest));
+    float lo = point.min;
+    float hi = point.max;
+    for (int64_t p = start + 1; p < end; p++) {
+        point = history_at(history, series->tier, (int)(p - oldest));
+        if (point.min < lo) lo = point.min;
+        if (point.max > hi) hi = point.max;
+    }
+    series->min[c] = lo;
+    series->max[c] = hi;
+    return 1;
+}
+
+/**
+ * Bring a series up to date with a history window
+ *
+ * When only new points arrived, the columns are shifted left by the number
+ * of bucket boundaries crossed and only the columns that received points
+ * are recomputed, plus the oldest one, whose points the ring may have
+ * dropped. Anything else (new window, width or tier) rebuilds every column.
+ *
+ * @param series Series to update
+ * @param history Source history
+ * @param span Window length in raw samples
+ * @param width Graph width in pixels
+ * @return 1 if recomputed, 0 if the cached result was reused, -1 on allocation failure
+ */
+int graph_series_update(GraphSeries *series, const history_t *history, int span, int width) {
+    if (series->valid && series->appended == history->appended &&
+        series->span == span && series->width == width) {
+        return 0;
+    }
+
+    int points;
+    history_tier_id_t tier = history_tier_for_span(history, span, &points);
+    if (width < 1) {
+        width = 1;
+    }
+
+    // Buckets hold a whole number of points and are anchored to absolute
+    // point indices, so a new point only ever touches the newest column
+    int per_column = (points + width - 1) / width;
+    int columns = (points + per_column - 1) / per_column;
+    if (reserve_columns(series, columns) != 0) {
+        series->valid = 0;
+        return -1;
+    }
+
+    int count = history_count(history, tier);
+    uint64_t total = history->tiers[tier].pushed;
+    int64_t oldest = (int64_t)(total - (uint64_t)count);    // Absolute index of history_at(0)
+    int64_t newest_column = total > 0 ? (int64_t)((total - 1) / (uint64_t)per_column) : 0;
+
+    int64_t shift = newest_column - series->newest_column;
+    int from = 0;   // First column to recompute
+    if (series->valid && series->span == span && series->width == width &&
+        series->tier == tier && series->per_column == per_column && series->columns == columns &&
+        total >= series->pushed && shift >= 0 && shift < columns) {
+        // Same buckets: scroll the kept columns and redo the newest ones
+        if (shift > 0) {
+            memmove(series->min, series->min + shift, (size_t)(columns - shift) * sizeof(float));
+            memmove(series->max, series->max + shift, (size_t)(columns - shift) * sizeof(float));
+            series->first = series->first > shift ? series->first - (int)shift : 0;
+        }
+        from = columns - 1 - (int)shift;
+    } else {
+        series->first = columns;
+    }
+
+    series->columns = columns;
+    series->tier = tier;
+    series->per_column = per_column;
+    series->newest_column = newest_column;
+    for (int c = columns - 1; c >= from; c--) {
+        if (!fill_column(series, history, c, oldest, total)) {
+            break;
+        }
+        if (c < series->first) {
+            series->first = c;
+        }
+    }
+    if (from > 0 && series->first == 0 && !fill_column(series, history, 0, oldest, total)) {
+        series->first = 1;
+    }
+
+    series->pushed = total;
+    series->valid = 1;
+    series->appended = history->appended;
+    series->span = span;
+    series->width = width;
+    return 1;
+}
+
+/**
+ * Release the column arrays of a series
+ * @param series Series to free
+ */
+void graph_series_free(GraphSeries *series) {
+    free(series->min);
+    free(series->max);
+    series->min = series->max = NULL;
+    series->capacity = 0;
+    series->valid = 0;
+}
+
+/**
+ * Convert a value to a y coordinate
+ * @param value Value to convert
+ * @param scale Factor converting the value to percent
+ * @param height Graph height in pixels
+ * @return y coordinate, clamped to the graph
+ */
+static double value_to_y(double value, double scale, int height) {
+    double percent = value * scale;
+    if (percent < 0.0) percent = 0.0;
+    if (percent > 100.0) percent = 100.0;
+    return height * (1.0 - percent / 100.0);
+}
+
+/**
+ * Trace columns of a series as a filled area with an outline
+ * @param cr Cairo context
+ * @param series Up-to-date series
+ * @param from First column to trace (clamped to the first column with data)
+ * @param width Graph width in pixels
+ * @param height Graph height in pixels
+ * @param scale Factor converting a value to percent of the graph height
+ * @param color Line color (the fill uses it at 30% opacity)
+ */
+static void trace_columns(cairo_t *cr, const GraphSeries *series, int from, int width, int height,
+                          double scale, const double color[3]) {
+    if (from < series->first) {
+        from = series->first;
+    }
+    if (from >= series->columns) {
+        return;
+    }
+
+    // The newest column sits at the right edge
+    double x_step = series->columns > 1 ? (double)width / (series->columns - 1) : 0.0;
+    double x_from = series->columns > 1 ? from * x_step : width;
+
+    // Fill area below the upper envelope
+    cairo_set_source_rgba(cr, color[0], color[1], color[2], 0.3);
+    cairo_move_to(cr, x_from, height);
+    for (int c = from; c < series->columns; c++) {
+        double x = series->columns > 1 ? c * x_step : width;
+        cairo_line_to(cr, x, value_to_y(series->max[c], scale, height));
+    }
+    cairo_line_to(cr, width, height);
+    cairo_close_path(cr);
+    cairo_fill(cr);
+
+    // Outline: a vertical min-max segment per column keeps peaks visible.
+    // Round joins stay within half a line width of each point, so a strip
+    // redrawn on its own matches the full trace.
+    cairo_set_source_rgb(cr, color[0], color[1], color[2]);
+    cairo_set_line_width(cr, 1.5);
+    cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND);
+    for (int c = from; c < series->columns; c++) {
+        double x = series->columns > 1 ? c * x_step : width;
+        double y_min = value_to_y(series->min[c], scale, height);
+        double y_max = value_to_y(series->max[c], scale, height);
+
+        if (c == from) {
+            cairo_move_to(cr, x, y_min);
+        } else {
+            cairo_line_to(cr, x, y_min);
+        }
+        if (y_max != y_min) {
+            cairo_line_to(cr, x, y_max);
+        }
+    }
+    cairo_stroke(cr);
+}
+
+/**
+ * Mark the newest value at the right edge with a dark halo
+ * @param cr Cairo context
+ * @param width Graph width in pixels
+ * @param height Graph height in pixels
+ * @param scale Factor converting a value to percent of the graph height
+ * @param latest Newest value
+ * @param color Marker color
+ */
+static void draw_marker(cairo_t *cr, int width, int height, double scale, double latest,
+                        const double color[3]) {
+    double y = value_to_y(latest, scale, height);
+    cairo_set_source_rgb(cr, 0.2, 0.2, 0.2);  // Dark gray background
+    cairo_arc(cr, width, y, 3.5, 0, 2 * M_PI);
+    cairo_fill(cr);
+
+    cairo_set_source_rgb(cr, color[0], color[1], color[2]);
+    cairo_arc(cr, width, y, 2.5, 0, 2 * M_PI);
+    cairo_fill(cr);
+}
+
+/**
+ * Paint the static layer: background, grid, axis labels, span label and border
+ * @param cr Cairo context of the layer surface
+ * @param width Layer width in pixels
+ * @param height Layer height in pixels
+ * @param span_label Span shown in the top-right corner
+ */
+static void paint_static_layer(cairo_t *cr, int width, int height, const char *span_label) {
+    // Draw background - using darker background
+    cairo_set_source_rgb(cr, 0.07, 0.07, 0.07);  // Darker background #121212
+    cairo_paint(cr);
+
+    // Draw grid
+    cairo_set_source_rgba(cr, 0.3, 0.3, 0.3, 0.3);  // Darker grid lines
+
+    // Horizontal grid lines
+    for (int i = 1; i < 4; i++) {
+        double y = height * i / 4.0;
+        cairo_move_to(cr, 0, y);
+        cairo_line_to(cr, width, y);
+    }
+
+    // Vertical grid lines
+    for (int i = 1; i < 6; i++) {
+        double x = width * i / 6.0;
+        cairo_move_to(cr, x, 0);
+        cairo_line_to(cr, x, height);
+    }
+    cairo_stroke(cr);
+
+    // Display percentage (25%, 50%, 75%, 100%)
+    cairo_set_source_rgba(cr, 0.5, 0.5, 0.5, 0.7);
+    cairo_set_font_size(cr, 9);
+
+    for (int i = 1; i <= 4; i++) {
+        char text[10];
+        snprintf(text, sizeof(text), "%d%%", i * 25);
+        cairo_move_to(cr, 2, height - (height * i / 4.0) - 2);
+        cairo_show_text(cr, text);
+    }
+
+    // Span in the top-right corner
+    if (span_label != NULL) {
+        cairo_text_extents_t extents;
+        cairo_text_extents(cr, span_label, &extents);
+        cairo_move_to(cr, width - extents.x_advance - 4, 11);
+        cairo_show_text(cr, span_label);
+    }
+
+    // Draw border
+    cairo_set_source_rgb(cr, 0.3, 0.3, 0.3);  // Darker border
+    cairo_rectangle(cr, 0, 0, width, height);
+    cairo_stroke(cr);
+}
+
+/**
+ * Rebuild the static layer if the size or span label changed
+ * @param cr Cairo context of the widget (the layer is made compatible with its target)
+ * @param cache Widget's cache
+ * @param width Widget width in pixels
+ * @param height Widget height in pixels
+ * @param span_label Span label to bake in
+ * @return 0 if the layer is usable, -1 otherwise
+ */
+static int update_static_layer(cairo_t *cr, GraphCache *cache, int width, int height,
+                               const char *span_label) {
+    if (cache->layer != NULL && cache->layer_width == width &&
+        cache->layer_height == height && cache->layer_label == span_label) {
+        return 0;
+    }
+
+    if (cache->layer != NULL) {
+        cairo_surface_destroy(cache->layer);
+        cache->layer = NULL;
+    }
+
+    // A surface similar to the target stays on the X server for remote sessions
+    cairo_surface_t *layer = cairo_surface_create_similar(cairo_get_target(cr),
+                                                          CAIRO_CONTENT_COLOR, width, height);
+    if (cairo_surface_status(layer) != CAIRO_STATUS_SUCCESS) {
+        cairo_surface_destroy(layer);
+        return -1;
+    }
+
+    cairo_t *layer_cr = cairo_create(layer);
+    paint_static_layer(layer_cr, width, height, span_label);
+    cairo_destroy(layer_cr);
+
+    cache->layer = layer;
+    cache->layer_width = width;
+    cache->layer_height = height;
+    cache->layer_label = span_label;
+    return 0;
+}
+
+/**
+ * Release the plot surfaces
+ * @param cache Widget's cache
+ */
+static void destroy_plot(GraphCache *cache) {
+    for (int i = 0; i < 2; i++) {
+        if (cache->plot[i] != NULL) {
+            cairo_surface_destroy(cache->plot[i]);
+            cache->plot[i] = NULL;
+        }
+    }
+    cache->plot_valid = 0;
+}
+
+/**
+ * Bring the scrolling plot up to date
+ *
+ * New columns shift the previous plot left by their pixel step and only
+ * the strip they occupy is traced again. Anything else (first frame,
+ * resize, new scale or span, a jump of a whole window) retraces the plot.
+ *
+ * @param cr Cairo context of the widget
+ * @param cache Widget's cache (series already updated)
+ * @param width Widget width in pixels
+ * @param height Widget height in pixels
+ * @param params What to show
+ * @return 0 if the front plot surface is current, -1 if it could not be created
+ */
+static int update_plot(cairo_t *cr, GraphCache *cache, int width, int height, const GraphParams *params) {
+    const GraphSeries *series = &cache->series;
+    uint64_t appended = params->history->appended;
+
+    if (cache->plot[0] == NULL || cache->plot_width != width || cache->plot_height != height) {
+        destroy_plot(cache);
+        for (int i = 0; i < 2; i++) {
+            cache->plot[i] = cairo_surface_create_similar(cairo_get_target(cr),
+                                                          CAIRO_CONTENT_COLOR_ALPHA, width, height);
+            if (cairo_surface_status(cache->plot[i]) != CAIRO_STATUS_SUCCESS) {
+                destroy_plot(cache);
+                return -1;
+            }
+        }
+        cache->plot_width = width;
+        cache->plot_height = height;
+    }
+
+    if (cache->plot_scale != params->scale || cache->plot_span != params->span) {
+        cache->plot_valid = 0;
+    }
+    if (cache->plot_valid && cache->plot_appended == appended) {
+        return 0;
+    }
+
+    // Shifts use rounded absolute positions so the rounding error never accumulates
+    double x_step = (double)width / (series->columns - 1);
+    int64_t delta = series->newest_column - cache->plot_column;
+    long long shift = llround(series->newest_column * x_step) - llround(cache->plot_column * x_step);
+
+    if (!cache->plot_valid || delta < 0 || delta >= series->columns || shift >= width) {
+        cairo_t *plot_cr = cairo_create(cache->plot[cache->plot_front]);
+        cairo_set_operator(plot_cr, CAIRO_OPERATOR_CLEAR);
+        cairo_paint(plot_cr);
+        cairo_set_operator(plot_cr, CAIRO_OPERATOR_OVER);
+        trace_columns(plot_cr, series, series->first, width, height, params->scale, params->color);
+        cairo_destroy(plot_cr);
+        TRACE_DEBUG("graph plot: full retrace, %d columns, %dx%d", series->columns, width, height);
+    } else {
+        int back = cache->plot_front ^ 1;
+        cairo_t *plot_cr = cairo_create(cache->plot[back]);
+
+        // Blit the previous plot shifted left; what scrolls in is transparent
+        cairo_set_operator(plot_cr, CAIRO_OPERATOR_SOURCE);
+        cairo_set_source_surface(plot_cr, cache->plot[cache->plot_front], (double)-shift, 0);
+        cairo_paint(plot_cr);
+
+        // Retrace from a little left of the previous newest column (it may have
+        // been partial), so the new segment joins the old one inside the cleared strip
+        double x_prev = width - (double)delta * x_step;
+        int strip = (int)floor(x_prev) - 2;
+        if (strip < 0) {
+            strip = 0;
+        }
+        cairo_rectangle(plot_cr, strip, 0, width - strip, height);
+        cairo_clip(plot_cr);
+        cairo_set_operator(plot_cr, CAIRO_OPERATOR_CLEAR);
+        cairo_paint(plot_cr);
+        cairo_set_operator(plot_cr, CAIRO_OPERATOR_OVER);
+
+        int from = series->columns - 1 - (int)delta - (int)ceil(3.0 / x_step);
+        trace_columns(plot_cr, series, from, width, height, params->scale, params->color);
+        cairo_destroy(plot_cr);
+        TRACE_DEBUG("graph plot: scrolled %lld px, retraced from column %d", shift, from);
+
+        cache->plot_front = back;
+    }
+
+    cache->plot_valid = 1;
+    cache->plot_appended = appended;
+    cache->plot_column = series->newest_column;
+    cache->plot_scale = params->scale;
+    cache->plot_span = params->span;
+    return 0;
+}
+
+/**
+ * Render a graph: composite the cached static layer, then draw the data
+ * @param cr Cairo context of the widget
+ * @param cache Widget's cache
+ * @param width Widget width in pixels
+ * @param height Widget height in pixels
+ * @param params What to show
+ */
+void graph_render(cairo_t *cr, GraphCache *cache, int width, int height, const GraphParams *params) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    if (update_static_layer(cr, cache, width, height, params->span_label) == 0) {
+        cairo_set_source_surface(cr, cache->layer, 0, 0);
+        cairo_paint(cr);
+    } else {
+        paint_static_layer(cr, width, height, params->span_label);
+    }
+
+    const GraphSeries *series = &cache->series;
+    if (params->scale <= 0.0 ||
+        graph_series_update(&cache->series, params->history, params->span, width) < 0 ||
+        series->first >= series->columns) {
+        return;
+    }
+
+    if (series->columns > 1 && update_plot(cr, cache, width, height, params) == 0) {
+        cairo_set_source_surface(cr, cache->plot[cache->plot_front], 0, 0);
+        cairo_paint(cr);
+    } else {
+        trace_columns(cr, series, series->first, width, height, params->scale, params->color);
+    }
+
+    draw_marker(cr, width, height, params->scale, params->latest, params->color);
+}
+
+/**
+ * Release everything held by a graph cache
+ * @param cache Cache to free
+ */
+void graph_cache_free(GraphCache *cache) {
+    graph_series_free(&cache->series);
+    destroy_plot(cache);
+    if (cache->layer != NULL) {
+        cairo_surface_destroy(cache->layer);
+        cache->layer = NULL;
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include "history.h"
+#include <cairo.h>
+
+/**
+ * Downsampled view of a history window
+ *
+ * The window is reduced to at most one column per pixel, each holding the
+ * minimum and maximum of the points it covers, so spikes survive however
+ * long the window is. Columns cover fixed ranges of absolute point
+ * indices, so appending a point only changes the newest column, or
+ * scrolls the columns by one when it starts a new bucket. The result is
+ * cached: an append updates the newest columns in place, and only a new
+ * window or width recomputes every column.
+ */
+typedef struct {
+    int columns;                // Column slots across the graph
+    int first;                  // First column holding data (earlier ones are empty)
+    float *min;                 // Per-column minimum
+    float *max;                 // Per-column maximum
+    int capacity;               // Allocated column slots
+    history_tier_id_t tier;     // Tier the columns were built from
+    int per_column;             // Tier points per column
+    int64_t newest_column;      // Absolute index of the newest column
+    uint64_t pushed;            // Tier points covered by the columns
+
+    // Cache key of the current contents
+    int valid;
+    uint64_t appended;
+    int span;
+    int width;
+} GraphSeries;
+
+/**
+ * Per-widget graph cache
+ *
+ * Holds the downsampled series, the static layer (background, grid, axis
+ * labels, span label and border) and a scrolling plot of the data.
+ * The static layer is rendered once into an offscreen surface and only
+ * rebuilt when the widget is resized or the span label changes. The plot
+ * is shifted left when samples arrive and only the new strip is traced,
+ * so a frame is two composites plus a few line segments.
+ */
+typedef struct {
+    GraphSeries series;
+    cairo_surface_t *layer;     // Cached static layer (NULL until first render)
+    int layer_width;
+    int layer_height;
+    const char *layer_label;    // Span label baked into the layer (static string)
+
+    // Scrolling plot
+    cairo_surface_t *plot[2];   // Ping-pong surfaces: the front one is current
+    int plot_front;
+    int plot_valid;
+    int plot_width;
+    int plot_height;
+    double plot_scale;          // Scale the plot was traced at
+    int plot_span;              // Span the plot was traced for
+    uint64_t plot_appended;     // History position the plot shows
+    int64_t plot_column;        // Newest column the plot shows
+} GraphCache;
+
+/**
+ * What one graph frame shows
+ */
+typedef struct {
+    const history_t *history;   // Source history
+    int span;                   // Window length in raw samples
+    const char *span_label;     // Span shown in the corner (static string)
+    double scale;               // Factor converting a value to percent (0: nothing to draw)
+    double latest;              // Newest value
+    double color[3];            // Line color
+} GraphParams;
+
+/**
+ * Render a graph: composite the cached static layer, then draw the data
+ *
+ * @param cr Cairo context of the widget
+ * @param cache Widget's cache
+ * @param width Widget width in pixels
+ * @param height Widget height in pixels
+ * @param params What to show
+ */
+void graph_render(cairo_t *cr, GraphCache *cache, int width, int height, const GraphParams *params);
+
+/**
+ * Release everything held by a graph cache
+ *
+ * @param cache Cache to free
+ */
+void graph_cache_free(GraphCache *cache);
+
+/**
+ * Bring a series up to date with a history window
+ *
+ * @param series Series to update
+ * @param history Source history
+ * @param span Window length in raw samples (older tiers are used for long windows)
+ * @param width Graph width in pixels
+ * @return 1 if recomputed, 0 if the cached result was reused, -1 on allocation failure
+ */
+int graph_series_update(GraphSeries *series, const history_t *history, int span, int width);
+
+/**
+ * Release the column arrays of a series
+ *
+ * @param series Series to free
+ */
+void graph_series_free(GraphSeries *series);
+
+#endif // GRAPH_H
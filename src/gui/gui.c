@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include "gui_utils.h"
 #include "error.h"
+#include "trace.h"
 
 #ifdef HAVE_GTK
 #include "cpu.h"
@@ -9,9 +10,10 @@
 #include "system.h"
 #include "user.h"
 #include "platform.h"
+#include "gui_collector.h"
+#include "graph.h"
 #include <string.h>
 #include <stdlib.h>
-#include <sys/utsname.h>
 #include <cairo.h>
 #include <math.h>
 
@@ -19,6 +21,99 @@
 static GuiWidgets widgets;
 static GuiData gui_data;
 static VimColorTheme vim_theme;
+static GuiCollector gui_collector;
+
+// Raw history kept per metric (seconds)
+#define GUI_HISTORY_RAW_SECONDS 3600
+
+// Time spans the graphs cycle through on scroll (seconds)
+static const int graph_spans[] = { 60, 600, 3600, 86400 };
+static const char *graph_span_names[] = { "1 min", "10 min", "1 h", "24 h" };
+#define GRAPH_SPAN_COUNT ((int)(sizeof(graph_spans) / sizeof(graph_spans[0])))
+
+// What each graph plots
+static const GraphSource cpu_graph = {
+    .history = &gui_data.cpu_history, .latest = &gui_data.cpu_usage,
+    .color = {0.373, 0.529, 0.843}  // Blue
+};
+static const GraphSource memory_graph = {
+    .history = &gui_data.memory_history, .latest = &gui_data.memory_used,
+    .total = &gui_data.memory_total, .color = {0.529, 0.686, 0.373}  // Green
+};
+static const GraphSource swap_graph = {
+    .history = &gui_data.swap_history, .latest = &gui_data.swap_used,
+    .total = &gui_data.swap_total, .color = {0.843, 0.529, 0.0}  // Orange
+};
+static const GraphSource disk_graph = {
+    .history = &gui_data.disk_history, .latest = &gui_data.disk_util,
+    .color = {0.686, 0.373, 0.686}  // Purple
+};
+static const GraphSource network_graph = {
+    .history = &gui_data.network_history, .latest = &gui_data.network_bytes,
+    .total = &gui_data.network_peak, .color = {0.373, 0.686, 0.686}  // Cyan
+};
+
+/**
+ * Destroy notifier for a widget's graph cache
+ */
+static void free_widget_cache(gpointer data) {
+    graph_cache_free(data);
+    g_free(data);
+}
+
+/**
+ * Graph cache of a drawing area
+ * Each drawing area has its own size, so each keeps its own cache.
+ */
+static GraphCache *widget_cache(GtkWidget *widget) {
+    GraphCache *cache = g_object_get_data(G_OBJECT(widget), "graph-cache");
+    if (cache == NULL) {
+        cache = g_new0(GraphCache, 1);
+        g_object_set_data_full(G_OBJECT(widget), "graph-cache", cache, free_widget_cache);
+    }
+    return cache;
+}
+
+/**
+ * Raw samples covered by the selected graph span
+ */
+static int graph_span_samples(const GuiData *data) {
+    return (int)((int64_t)graph_spans[data->graph_span] * 1000 / data->update_interval);
+}
+
+/**
+ * Graph scroll handler: scrolling up zooms in, scrolling down zooms out
+ */
+static gboolean on_graph_scroll(GtkWidget *widget, GdkEventScroll *event, gpointer data) {
+    GuiData *gui_data = (GuiData *)data;
+    (void)widget;
+    
+    if (event->direction == GDK_SCROLL_UP && gui_data->graph_span > 0) {
+        gui_data->graph_span--;
+    } else if (event->direction == GDK_SCROLL_DOWN && gui_data->graph_span < GRAPH_SPAN_COUNT - 1) {
+        gui_data->graph_span++;
+    } else {
+        return FALSE;
+    }
+    
+    gtk_widget_queue_draw(widgets.dashboard_cpu_graph);
+    gtk_widget_queue_draw(widgets.dashboard_memory_graph);
+    gtk_widget_queue_draw(widgets.dashboard_swap_graph);
+    gtk_widget_queue_draw(widgets.dashboard_network_graph);
+    gtk_widget_queue_draw(widgets.cpu_usage_graph);
+    gtk_widget_queue_draw(widgets.memory_usage_graph);
+    gtk_widget_queue_draw(widgets.swap_usage_graph);
+    gtk_widget_queue_draw(widgets.disks_graph);
+    return TRUE;
+}
+
+/**
+ * Let a graph widget change the displayed span on scroll
+ */
+static void connect_graph_scroll(GtkWidget *graph) {
+    gtk_widget_add_events(graph, GDK_SCROLL_MASK);
+    g_signal_connect(graph, "scroll-event", G_CALLBACK(on_graph_scroll), &gui_data);
+}
 
 /**
  * Initialize VIM color theme
@@ -138,7 +233,8 @@ void init_gui(int *argc, char ***argv) {
     // CPU usage mini graph
     widgets.dashboard_cpu_graph = gtk_drawing_area_new();
     gtk_widget_set_size_request(widgets.dashboard_cpu_graph, -1, 100);
-    g_signal_connect(widgets.dashboard_cpu_graph, "draw", G_CALLBACK(draw_cpu_graph), &gui_data);
+    g_signal_connect(widgets.dashboard_cpu_graph, "draw", G_CALLBACK(draw_graph), (gpointer)&cpu_graph);
+    connect_graph_scroll(widgets.dashboard_cpu_graph);
     gtk_box_pack_start(GTK_BOX(cpu_card_box), widgets.dashboard_cpu_graph, TRUE, TRUE, 0);
     
     // --- Memory card ---
@@ -168,7 +264,8 @@ void init_gui(int *argc, char ***argv) {
     // Memory usage mini graph
     widgets.dashboard_memory_graph = gtk_drawing_area_new();
     gtk_widget_set_size_request(widgets.dashboard_memory_graph, -1, 100);
-    g_signal_connect(widgets.dashboard_memory_graph, "draw", G_CALLBACK(draw_memory_graph), &gui_data);
+    g_signal_connect(widgets.dashboard_memory_graph, "draw", G_CALLBACK(draw_graph), (gpointer)&memory_graph);
+    connect_graph_scroll(widgets.dashboard_memory_graph);
     gtk_box_pack_start(GTK_BOX(memory_card_box), widgets.dashboard_memory_graph, TRUE, TRUE, 0);
     
     // --- Swap card ---
@@ -198,9 +295,37 @@ void init_gui(int *argc, char ***argv) {
     // Swap usage mini graph
     widgets.dashboard_swap_graph = gtk_drawing_area_new();
     gtk_widget_set_size_request(widgets.dashboard_swap_graph, -1, 100);
-    g_signal_connect(widgets.dashboard_swap_graph, "draw", G_CALLBACK(draw_swap_graph), &gui_data);
+    g_signal_connect(widgets.dashboard_swap_graph, "draw", G_CALLBACK(draw_graph), (gpointer)&swap_graph);
+    connect_graph_scroll(widgets.dashboard_swap_graph);
     gtk_box_pack_start(GTK_BOX(swap_card_box), widgets.dashboard_swap_graph, TRUE, TRUE, 0);
     
+    // --- Network card ---
+    GtkWidget *network_card = gtk_frame_new(NULL);
+    gtk_frame_set_shadow_type(GTK_FRAME(network_card), GTK_SHADOW_ETCHED_IN);
+    GtkWidget *network_card_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(network_card_box), 10);
+    gtk_container_add(GTK_CONTAINER(network_card), network_card_box);
+    
+    // Network card header
+    GtkWidget *network_header = gtk_label_new(NULL);
+    gtk_label_set_markup(GTK_LABEL(network_header), 
+                        "<span font_desc='Monospace Bold 12' foreground='#5fafaf'>Network Traffic</span>");
+    gtk_widget_set_halign(network_header, GTK_ALIGN_START);
+    gtk_box_pack_start(GTK_BOX(network_card_box), network_header, FALSE, FALSE, 0);
+    
+    // Network traffic label
+    widgets.dashboard_network_label = gtk_label_new("");
+    gtk_label_set_justify(GTK_LABEL(widgets.dashboard_network_label), GTK_JUSTIFY_LEFT);
+    gtk_label_set_xalign(GTK_LABEL(widgets.dashboard_network_label), 0.0);
+    gtk_box_pack_start(GTK_BOX(network_card_box), widgets.dashboard_network_label, FALSE, FALSE, 5);
+    
+    // Network traffic mini graph (scaled to the peak seen)
+    widgets.dashboard_network_graph = gtk_drawing_area_new();
+    gtk_widget_set_size_request(widgets.dashboard_network_graph, -1, 100);
+    g_signal_connect(widgets.dashboard_network_graph, "draw", G_CALLBACK(draw_graph), (gpointer)&network_graph);
+    connect_graph_scroll(widgets.dashboard_network_graph);
+    gtk_box_pack_start(GTK_BOX(network_card_box), widgets.dashboard_network_graph, TRUE, TRUE, 0);
+    
     // --- Users card ---
     GtkWidget *users_card = gtk_frame_new(NULL);
     gtk_frame_set_shadow_type(GTK_FRAME(users_card), GTK_SHADOW_ETCHED_IN);
@@ -234,7 +359,8 @@ void init_gui(int *argc, char ***argv) {
     gtk_grid_attach(GTK_GRID(dashboard_grid), cpu_card, 1, 0, 1, 1);
     gtk_grid_attach(GTK_GRID(dashboard_grid), memory_card, 0, 1, 1, 1);
     gtk_grid_attach(GTK_GRID(dashboard_grid), swap_card, 1, 1, 1, 1);
-    gtk_grid_attach(GTK_GRID(dashboard_grid), users_card, 0, 2, 2, 1);
+    gtk_grid_attach(GTK_GRID(dashboard_grid), network_card, 0, 2, 1, 1);
+    gtk_grid_attach(GTK_GRID(dashboard_grid), users_card, 1, 2, 1, 1);
     
     // Add dashboard tab
     GtkWidget *dashboard_label = gtk_label_new("Dashboard");
@@ -272,9 +398,17 @@ void init_gui(int *argc, char ***argv) {
     widgets.cpu_usage_graph = gtk_drawing_area_new();
     gtk_widget_set_size_request(widgets.cpu_usage_graph, -1, 300);
     g_signal_connect(widgets.cpu_usage_graph, "draw", 
-                    G_CALLBACK(draw_cpu_graph), &gui_data);
+                    G_CALLBACK(draw_graph), (gpointer)&cpu_graph);
+    connect_graph_scroll(widgets.cpu_usage_graph);
     gtk_box_pack_start(GTK_BOX(widgets.cpu_box), widgets.cpu_usage_graph, TRUE, TRUE, 0);
     
+    // Per-core usage label
+    widgets.cpu_cores_label = gtk_label_new("");
+    gtk_label_set_justify(GTK_LABEL(widgets.cpu_cores_label), GTK_JUSTIFY_LEFT);
+    gtk_label_set_xalign(GTK_LABEL(widgets.cpu_cores_label), 0.0);
+    gtk_label_set_line_wrap(GTK_LABEL(widgets.cpu_cores_label), TRUE);
+    gtk_box_pack_start(GTK_BOX(widgets.cpu_box), widgets.cpu_cores_label, FALSE, FALSE, 0);
+    
     // Add CPU tab
     GtkWidget *cpu_label = gtk_label_new("CPU");
     gtk_notebook_append_page(GTK_NOTEBOOK(widgets.notebook), widgets.cpu_box, cpu_label);
@@ -297,7 +431,8 @@ void init_gui(int *argc, char ***argv) {
     widgets.memory_usage_graph = gtk_drawing_area_new();
     gtk_widget_set_size_request(widgets.memory_usage_graph, -1, 200);
     g_signal_connect(widgets.memory_usage_graph, "draw", 
-                    G_CALLBACK(draw_memory_graph), &gui_data);
+                    G_CALLBACK(draw_graph), (gpointer)&memory_graph);
+    connect_graph_scroll(widgets.memory_usage_graph);
     gtk_box_pack_start(GTK_BOX(widgets.memory_box), widgets.memory_usage_graph, TRUE, TRUE, 0);
     
     // Swap usage label
@@ -314,7 +449,8 @@ void init_gui(int *argc, char ***argv) {
     widgets.swap_usage_graph = gtk_drawing_area_new();
     gtk_widget_set_size_request(widgets.swap_usage_graph, -1, 200);
     g_signal_connect(widgets.swap_usage_graph, "draw", 
-                    G_CALLBACK(draw_swap_graph), &gui_data);
+                    G_CALLBACK(draw_graph), (gpointer)&swap_graph);
+    connect_graph_scroll(widgets.swap_usage_graph);
     gtk_box_pack_start(GTK_BOX(widgets.memory_box), widgets.swap_usage_graph, TRUE, TRUE, 0);
     
     // Add memory tab
@@ -343,6 +479,108 @@ void init_gui(int *argc, char ***argv) {
     GtkWidget *users_label = gtk_label_new("Users");
     gtk_notebook_append_page(GTK_NOTEBOOK(widgets.notebook), widgets.users_box, users_label);
     
+    // --- Processes tab ---
+    widgets.processes_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(widgets.processes_box), 10);
+    
+    // Process count and scan time
+    widgets.processes_label = gtk_label_new("");
+    gtk_label_set_xalign(GTK_LABEL(widgets.processes_label), 0.0);
+    gtk_box_pack_start(GTK_BOX(widgets.processes_box), widgets.processes_label, FALSE, FALSE, 0);
+    
+    // Process list scroll window
+    GtkWidget *processes_scroll = gtk_scrolled_window_new(NULL, NULL);
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(processes_scroll),
+                                  GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
+    gtk_box_pack_start(GTK_BOX(widgets.processes_box), processes_scroll, TRUE, TRUE, 0);
+    
+    widgets.processes_list = gtk_tree_view_new();
+    tree_context = gtk_widget_get_style_context(widgets.processes_list);
+    gtk_style_context_add_class(tree_context, "dark-bg");
+    gtk_container_add(GTK_CONTAINER(processes_scroll), widgets.processes_list);
+    
+    // Largest processes by resident memory
+    GtkWidget *memory_title = gtk_label_new("Largest resident memory (MB)");
+    gtk_label_set_xalign(GTK_LABEL(memory_title), 0.0);
+    gtk_box_pack_start(GTK_BOX(widgets.processes_box), memory_title, FALSE, FALSE, 0);
+    
+    GtkWidget *memory_scroll = gtk_scrolled_window_new(NULL, NULL);
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(memory_scroll),
+                                  GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
+    gtk_box_pack_start(GTK_BOX(widgets.processes_box), memory_scroll, TRUE, TRUE, 0);
+    
+    widgets.processes_memory_list = gtk_tree_view_new();
+    tree_context = gtk_widget_get_style_context(widgets.processes_memory_list);
+    gtk_style_context_add_class(tree_context, "dark-bg");
+    gtk_container_add(GTK_CONTAINER(memory_scroll), widgets.processes_memory_list);
+    
+    // Add processes tab
+    GtkWidget *processes_label = gtk_label_new("Processes");
+    gtk_notebook_append_page(GTK_NOTEBOOK(widgets.notebook), widgets.processes_box, processes_label);
+    
+    // --- Pressure tab ---
+    widgets.pressure_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(widgets.pressure_box), 10);
+    
+    // Trigger state
+    widgets.pressure_label = gtk_label_new("");
+    gtk_label_set_xalign(GTK_LABEL(widgets.pressure_label), 0.0);
+    gtk_box_pack_start(GTK_BOX(widgets.pressure_box), widgets.pressure_label, FALSE, FALSE, 0);
+    
+    widgets.pressure_list = gtk_tree_view_new();
+    tree_context = gtk_widget_get_style_context(widgets.pressure_list);
+    gtk_style_context_add_class(tree_context, "dark-bg");
+    gtk_box_pack_start(GTK_BOX(widgets.pressure_box), widgets.pressure_list, FALSE, FALSE, 0);
+    
+    // Add pressure tab
+    GtkWidget *pressure_label = gtk_label_new("Pressure");
+    gtk_notebook_append_page(GTK_NOTEBOOK(widgets.notebook), widgets.pressure_box, pressure_label);
+    
+    // --- Disks tab ---
+    widgets.disks_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(widgets.disks_box), 10);
+    
+    // Totals
+    widgets.disks_label = gtk_label_new("");
+    gtk_label_set_xalign(GTK_LABEL(widgets.disks_label), 0.0);
+    gtk_box_pack_start(GTK_BOX(widgets.disks_box), widgets.disks_label, FALSE, FALSE, 0);
+    
+    // Busiest device utilization graph
+    widgets.disks_graph = gtk_drawing_area_new();
+    gtk_widget_set_size_request(widgets.disks_graph, -1, 200);
+    g_signal_connect(widgets.disks_graph, "draw",
+                    G_CALLBACK(draw_graph), (gpointer)&disk_graph);
+    connect_graph_scroll(widgets.disks_graph);
+    gtk_box_pack_start(GTK_BOX(widgets.disks_box), widgets.disks_graph, TRUE, TRUE, 0);
+    
+    widgets.disks_list = gtk_tree_view_new();
+    tree_context = gtk_widget_get_style_context(widgets.disks_list);
+    gtk_style_context_add_class(tree_context, "dark-bg");
+    gtk_box_pack_start(GTK_BOX(widgets.disks_box), widgets.disks_list, FALSE, FALSE, 0);
+    
+    // Add disks tab
+    GtkWidget *disks_label = gtk_label_new("Disks");
+    gtk_notebook_append_page(GTK_NOTEBOOK(widgets.notebook), widgets.disks_box, disks_label);
+    
+    // --- Cgroups tab ---
+    widgets.cgroups_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(widgets.cgroups_box), 10);
+    
+    // Own group against its limits
+    widgets.cgroups_label = gtk_label_new("");
+    gtk_label_set_xalign(GTK_LABEL(widgets.cgroups_label), 0.0);
+    gtk_box_pack_start(GTK_BOX(widgets.cgroups_box), widgets.cgroups_label, FALSE, FALSE, 0);
+    
+    // Busiest groups of the hierarchy, in tree order
+    widgets.cgroups_list = gtk_tree_view_new();
+    tree_context = gtk_widget_get_style_context(widgets.cgroups_list);
+    gtk_style_context_add_class(tree_context, "dark-bg");
+    gtk_box_pack_start(GTK_BOX(widgets.cgroups_box), widgets.cgroups_list, FALSE, FALSE, 0);
+    
+    // Add cgroups tab
+    GtkWidget *cgroups_label = gtk_label_new("Cgroups");
+    gtk_notebook_append_page(GTK_NOTEBOOK(widgets.notebook), widgets.cgroups_box, cgroups_label);
+    
     // Status bar
     widgets.statusbar = gtk_statusbar_new();
     gtk_box_pack_end(GTK_BOX(widgets.main_box), widgets.statusbar, FALSE, FALSE, 0);
@@ -352,8 +590,20 @@ void init_gui(int *argc, char ***argv) {
     // Activate first tab (Dashboard)
     gtk_notebook_set_current_page(GTK_NOTEBOOK(widgets.notebook), 0);
     
-    // Initialize GUI data
-    gui_data.update_interval = 1000; // 1 second
+    // Initialize GUI data; gtk_init has already removed its own arguments,
+    // so --tdelay (e.g. --tdelay=100ms for 10 Hz) can be parsed like the CLI
+    ProgramOptions options = parseCommandLineOptions(*argc, *argv);
+    gui_data.update_interval = options.tdelay_ms;
+    
+    int raw_capacity = (int)((int64_t)GUI_HISTORY_RAW_SECONDS * 1000 / gui_data.update_interval);
+    history_init(&gui_data.cpu_history, gui_data.update_interval, raw_capacity);
+    history_init(&gui_data.memory_history, gui_data.update_interval, raw_capacity);
+    history_init(&gui_data.swap_history, gui_data.update_interval, raw_capacity);
+    history_init(&gui_data.disk_history, gui_data.update_interval, raw_capacity);
+    history_init(&gui_data.network_history, gui_data.update_interval, raw_capacity);
+    if (gui_collector_start(&gui_collector, gui_data.update_interval) != STATUS_SUCCESS) {
+        LOG_ERROR(SYS_MON_ERR_SYSTEM, "Failed to start background data collection");
+    }
     
     // Apply VIM theme
     apply_vim_theme(widgets.window);
@@ -366,14 +616,12 @@ void init_gui(int *argc, char ***argv) {
     GtkStyleContext *dashboard_users_style = gtk_widget_get_style_context(widgets.dashboard_users_list);
     gtk_style_context_add_class(dashboard_users_style, "dark-bg");
     
-    // Set timer
-    g_timeout_add(gui_data.update_interval, update_system_data, &gui_data);
+    // Set timer: polling only checks for a new snapshot, so it runs faster
+    // than sampling to keep display latency low
+    g_timeout_add(gui_data.update_interval > 4 ? gui_data.update_interval / 4 : 1,
+                  update_system_data, &gui_data);
     LOG_INFO(SYS_MON_SUCCESS, "Timer set");
     
-    // First update execution
-    update_system_data(&gui_data);
-    LOG_INFO(SYS_MON_SUCCESS, "First data update complete");
-    
     LOG_INFO(SYS_MON_SUCCESS, "GUI initialization complete.");
 }
 
@@ -394,23 +642,15 @@ void run_gui(void) {
 void cleanup_gui(void) {
     LOG_INFO(SYS_MON_SUCCESS, "Cleaning up GUI resources...");
     
+    // Stop background collection before releasing what it feeds
+    gui_collector_stop(&gui_collector);
+    
     // Free memory
-    free(gui_data.cpu_history);
-    free(gui_data.memory_history);
-    free(gui_data.swap_history);
-    
-    free(gui_data.system_name);
-    free(gui_data.node_name);
-    free(gui_data.version);
-    free(gui_data.release);
-    free(gui_data.machine);
-    
-    if (gui_data.users != NULL) {
-        for (int i = 0; i < gui_data.user_count; i++) {
-            free(gui_data.users[i]);
-        }
-        free(gui_data.users);
-    }
+    history_free(&gui_data.cpu_history);
+    history_free(&gui_data.memory_history);
+    history_free(&gui_data.swap_history);
+    history_free(&gui_data.disk_history);
+    history_free(&gui_data.network_history);
     
     LOG_INFO(SYS_MON_SUCCESS, "GUI resources cleaned up.");
 }
@@ -570,385 +810,30 @@ void apply_vim_theme(GtkWidget *widget) {
 }
 
 /**
- * CPU graph drawing callback
- */
-gboolean draw_cpu_graph(GtkWidget *widget, cairo_t *cr, gpointer data) {
-    GuiData *gui_data = (GuiData *)data;
-    GtkAllocation allocation;
-    
-    gtk_widget_get_allocation(widget, &allocation);
-    int width = allocation.width;
-    int height = allocation.height;
-    
-    // Draw background - using darker background
-    cairo_set_source_rgb(cr, 0.07, 0.07, 0.07);  // Darker background #121212
-    cairo_paint(cr);
-    
-    // Draw grid
-    cairo_set_source_rgba(cr, 0.3, 0.3, 0.3, 0.3);  // Darker grid lines
-    
-    // Horizontal grid lines
-    for (int i = 1; i < 4; i++) {
-        double y = height * i / 4.0;
-        cairo_move_to(cr, 0, y);
-        cairo_line_to(cr, width, y);
-    }
-    
-    // Vertical grid lines
-    for (int i = 1; i < 6; i++) {
-        double x = width * i / 6.0;
-        cairo_move_to(cr, x, 0);
-        cairo_line_to(cr, x, height);
-    }
-    cairo_stroke(cr);
-    
-    // Display CPU usage (25%, 50%, 75%, 100%)
-    cairo_set_source_rgba(cr, 0.5, 0.5, 0.5, 0.7);
-    cairo_set_font_size(cr, 9);
-    
-    for (int i = 1; i <= 4; i++) {
-        char text[10];
-        snprintf(text, sizeof(text), "%d%%", i * 25);
-        cairo_move_to(cr, 2, height - (height * i / 4.0) - 2);
-        cairo_show_text(cr, text);
-    }
-    
-    // Draw border
-    cairo_set_source_rgb(cr, 0.3, 0.3, 0.3);  // Darker border
-    cairo_rectangle(cr, 0, 0, width, height);
-    cairo_stroke(cr);
-    
-    // Draw CPU usage
-    if (gui_data->cpu_history != NULL && gui_data->cpu_history_size > 0) {
-        double x_step = (double)width / gui_data->cpu_history_size;
-        
-        // Debug output for CPU usage validity check
-        printf("Drawing CPU graph: current usage=%.2f%%, history size=%d\n", 
-               gui_data->cpu_usage, gui_data->cpu_history_size);
-        
-        // Fill area below graph
-        cairo_set_source_rgba(cr, 0.373, 0.529, 0.843, 0.3);  // Blue, semi-transparent
-        
-        cairo_move_to(cr, 0, height);
-        
-        for (int i = 0; i < gui_data->cpu_history_size; i++) {
-            double x = i * x_step;
-            double usage = gui_data->cpu_history[i];
-            
-            // Clamp usage range (0-100%)
-            if (usage < 0) usage = 0;
-            if (usage > 100) usage = 100;
-            
-            double y = height * (1.0 - usage / 100.0);
-            
-            if (i == 0) {
-                cairo_move_to(cr, x, y);
-            } else {
-                cairo_line_to(cr, x, y);
-            }
-        }
-        
-        cairo_line_to(cr, width, height);
-        cairo_close_path(cr);
-        cairo_fill(cr);
-        
-        // Draw graph line
-        cairo_set_source_rgb(cr, 0.373, 0.529, 0.843);  // Blue
-        cairo_set_line_width(cr, 1.5);
-        
-        for (int i = 0; i < gui_data->cpu_history_size; i++) {
-            double x = i * x_step;
-            double usage = gui_data->cpu_history[i];
-            
-            // Clamp usage range (0-100%)
-            if (usage < 0) usage = 0;
-            if (usage > 100) usage = 100;
-            
-            double y = height * (1.0 - usage / 100.0);
-            
-            if (i == 0) {
-                cairo_move_to(cr, x, y);
-            } else {
-                cairo_line_to(cr, x, y);
-            }
-        }
-        
-        cairo_stroke(cr);
-        
-        // Mark last data point - use blue color only (no white outline)
-        if (gui_data->cpu_history_size > 0) {
-            int last = gui_data->cpu_history_size - 1;
-            double x = last * x_step;
-            double usage = gui_data->cpu_history[last];
-            
-            // Clamp usage range (0-100%)
-            if (usage < 0) usage = 0;
-            if (usage > 100) usage = 100;
-            
-            double y = height * (1.0 - usage / 100.0);
-            
-            // Draw point with dark background and blue color
-            cairo_set_source_rgb(cr, 0.2, 0.2, 0.2);  // Dark gray background
-            cairo_arc(cr, x, y, 3.5, 0, 2 * M_PI);
-            cairo_fill(cr);
-            
-            cairo_set_source_rgb(cr, 0.373, 0.529, 0.843);  // Blue
-            cairo_arc(cr, x, y, 2.5, 0, 2 * M_PI);
-            cairo_fill(cr);
-        }
-    }
-    
-    return FALSE;
-}
-
-/**
- * Memory graph drawing callback
- */
-gboolean draw_memory_graph(GtkWidget *widget, cairo_t *cr, gpointer data) {
-    GuiData *gui_data = (GuiData *)data;
-    GtkAllocation allocation;
-    
-    gtk_widget_get_allocation(widget, &allocation);
-    int width = allocation.width;
-    int height = allocation.height;
-    
-    // Draw background - using darker background from VIM theme
-    cairo_set_source_rgb(cr, 0.07, 0.07, 0.07);  // Darker background #121212
-    cairo_paint(cr);
-    
-    // Draw grid
-    cairo_set_source_rgba(cr, 0.3, 0.3, 0.3, 0.3);  // Darker grid lines
-    
-    // Horizontal grid lines
-    for (int i = 1; i < 4; i++) {
-        double y = height * i / 4.0;
-        cairo_move_to(cr, 0, y);
-        cairo_line_to(cr, width, y);
-    }
-    
-    // Vertical grid lines
-    for (int i = 1; i < 6; i++) {
-        double x = width * i / 6.0;
-        cairo_move_to(cr, x, 0);
-        cairo_line_to(cr, x, height);
-    }
-    cairo_stroke(cr);
-    
-    // Display memory usage percentage (25%, 50%, 75%, 100%)
-    cairo_set_source_rgba(cr, 0.5, 0.5, 0.5, 0.7);
-    cairo_set_font_size(cr, 9);
-    
-    for (int i = 1; i <= 4; i++) {
-        char text[10];
-        snprintf(text, sizeof(text), "%d%%", i * 25);
-        cairo_move_to(cr, 2, height - (height * i / 4.0) - 2);
-        cairo_show_text(cr, text);
-    }
-    
-    // Draw border
-    cairo_set_source_rgb(cr, 0.3, 0.3, 0.3);  // Darker border
-    cairo_rectangle(cr, 0, 0, width, height);
-    cairo_stroke(cr);
-    
-    // Draw memory usage - based on percentage
-    if (gui_data->memory_history != NULL && gui_data->memory_history_size > 0 && gui_data->memory_total > 0) {
-        double x_step = (double)width / gui_data->memory_history_size;
-        
-        // Fill area below graph
-        cairo_set_source_rgba(cr, 0.529, 0.686, 0.373, 0.3);
-        
-        cairo_move_to(cr, 0, height);
-        
-        // Calculate first point - based on percentage
-        double memory_percent = (gui_data->memory_history[0] / gui_data->memory_total) * 100.0;
-        if (memory_percent > 100.0) memory_percent = 100.0; // Clamp to maximum 100%
-        
-        cairo_line_to(cr, 0, height * (1.0 - memory_percent / 100.0));
-        
-        for (int i = 1; i < gui_data->memory_history_size; i++) {
-            double x = i * x_step;
-            
-            // Convert each point to percentage
-            memory_percent = (gui_data->memory_history[i] / gui_data->memory_total) * 100.0;
-            if (memory_percent > 100.0) memory_percent = 100.0; // Clamp to maximum 100%
-            
-            double y = height * (1.0 - memory_percent / 100.0);
-            cairo_line_to(cr, x, y);
-        }
-        
-        cairo_line_to(cr, width, height);
-        cairo_close_path(cr);
-        cairo_fill(cr);
-        
-        // Draw graph line
-        cairo_set_source_rgb(cr, 0.529, 0.686, 0.373);
-        cairo_set_line_width(cr, 1.5);
-        
-        // Recalculate first point
-        memory_percent = (gui_data->memory_history[0] / gui_data->memory_total) * 100.0;
-        if (memory_percent > 100.0) memory_percent = 100.0;
-        
-        cairo_move_to(cr, 0, height * (1.0 - memory_percent / 100.0));
-        
-        for (int i = 1; i < gui_data->memory_history_size; i++) {
-            double x = i * x_step;
-            
-            // Convert percentage
-            memory_percent = (gui_data->memory_history[i] / gui_data->memory_total) * 100.0;
-            if (memory_percent > 100.0) memory_percent = 100.0;
-            
-            double y = height * (1.0 - memory_percent / 100.0);
-            cairo_line_to(cr, x, y);
-        }
-        
-        cairo_stroke(cr);
-        
-        // Draw point - use dark background instead of white
-        if (gui_data->memory_history_size > 0) {
-            double x = (gui_data->memory_history_size - 1) * x_step;
-            
-            // Calculate last point percentage
-            memory_percent = (gui_data->memory_history[gui_data->memory_history_size - 1] / gui_data->memory_total) * 100.0;
-            if (memory_percent > 100.0) memory_percent = 100.0;
-            
-            double y = height * (1.0 - memory_percent / 100.0);
-            
-            // Draw point with dark background
-            cairo_set_source_rgb(cr, 0.2, 0.2, 0.2);  // Dark gray background
-            cairo_arc(cr, x, y, 3.5, 0, 2 * M_PI);
-            cairo_fill(cr);
-            
-            cairo_set_source_rgb(cr, 0.529, 0.686, 0.373);
-            cairo_arc(cr, x, y, 2.5, 0, 2 * M_PI);
-            cairo_fill(cr);
-        }
-    }
-    
-    return FALSE;
-}
-
-/**
- * Swap memory graph drawing callback
+ * Graph drawing callback shared by all graphs
+ * @param data The GraphSource the widget plots
  */
-gboolean draw_swap_graph(GtkWidget *widget, cairo_t *cr, gpointer data) {
-    GuiData *gui_data = (GuiData *)data;
+gboolean draw_graph(GtkWidget *widget, cairo_t *cr, gpointer data) {
+    const GraphSource *source = (const GraphSource *)data;
     GtkAllocation allocation;
     
     gtk_widget_get_allocation(widget, &allocation);
-    int width = allocation.width;
-    int height = allocation.height;
     
-    // Draw background - using darker background from VIM theme
-    cairo_set_source_rgb(cr, 0.07, 0.07, 0.07);  // Darker background #121212
-    cairo_paint(cr);
-    
-    // Draw grid
-    cairo_set_source_rgba(cr, 0.3, 0.3, 0.3, 0.3);  // Darker grid lines
-    
-    // Horizontal grid lines
-    for (int i = 1; i < 4; i++) {
-        double y = height * i / 4.0;
-        cairo_move_to(cr, 0, y);
-        cairo_line_to(cr, width, y);
-    }
-    
-    // Vertical grid lines
-    for (int i = 1; i < 6; i++) {
-        double x = width * i / 6.0;
-        cairo_move_to(cr, x, 0);
-        cairo_line_to(cr, x, height);
+    // Values are percentages unless the source has a total to scale against
+    double scale = 1.0;
+    if (source->total != NULL) {
+        scale = *source->total > 0 ? 100.0 / *source->total : 0.0;
     }
-    cairo_stroke(cr);
-    
-    // Display swap usage percentage (25%, 50%, 75%, 100%)
-    cairo_set_source_rgba(cr, 0.5, 0.5, 0.5, 0.7);
-    cairo_set_font_size(cr, 9);
     
-    for (int i = 1; i <= 4; i++) {
-        char text[10];
-        snprintf(text, sizeof(text), "%d%%", i * 25);
-        cairo_move_to(cr, 2, height - (height * i / 4.0) - 2);
-        cairo_show_text(cr, text);
-    }
-    
-    // Draw border
-    cairo_set_source_rgb(cr, 0.3, 0.3, 0.3);  // Darker border
-    cairo_rectangle(cr, 0, 0, width, height);
-    cairo_stroke(cr);
-    
-    // Draw swap usage
-    if (gui_data->swap_history != NULL && gui_data->swap_history_size > 0 && gui_data->swap_total > 0) {
-        double x_step = (double)width / gui_data->swap_history_size;
-        
-        // Fill area below graph
-        cairo_set_source_rgba(cr, 0.843, 0.529, 0.0, 0.3);
-        
-        cairo_move_to(cr, 0, height);
-        
-        // Calculate first point - based on percentage
-        double swap_percent = (gui_data->swap_history[0] / gui_data->swap_total) * 100.0;
-        if (swap_percent > 100.0) swap_percent = 100.0; // Clamp to maximum 100%
-        
-        cairo_line_to(cr, 0, height * (1.0 - swap_percent / 100.0));
-        
-        for (int i = 1; i < gui_data->swap_history_size; i++) {
-            double x = i * x_step;
-            
-            // Convert each point to percentage
-            swap_percent = (gui_data->swap_history[i] / gui_data->swap_total) * 100.0;
-            if (swap_percent > 100.0) swap_percent = 100.0; // Clamp to maximum 100%
-            
-            double y = height * (1.0 - swap_percent / 100.0);
-            cairo_line_to(cr, x, y);
-        }
-        
-        cairo_line_to(cr, width, height);
-        cairo_close_path(cr);
-        cairo_fill(cr);
-        
-        // Draw graph line
-        cairo_set_source_rgb(cr, 0.843, 0.529, 0.0);
-        cairo_set_line_width(cr, 1.5);
-        
-        // Recalculate first point
-        swap_percent = (gui_data->swap_history[0] / gui_data->swap_total) * 100.0;
-        if (swap_percent > 100.0) swap_percent = 100.0;
-        
-        cairo_move_to(cr, 0, height * (1.0 - swap_percent / 100.0));
-        
-        for (int i = 1; i < gui_data->swap_history_size; i++) {
-            double x = i * x_step;
-            
-            // Convert percentage
-            swap_percent = (gui_data->swap_history[i] / gui_data->swap_total) * 100.0;
-            if (swap_percent > 100.0) swap_percent = 100.0;
-            
-            double y = height * (1.0 - swap_percent / 100.0);
-            cairo_line_to(cr, x, y);
-        }
-        
-        cairo_stroke(cr);
-        
-        // Draw point with dark background
-        if (gui_data->swap_history_size > 0) {
-            double x = (gui_data->swap_history_size - 1) * x_step;
-            
-            // Calculate last point percentage
-            swap_percent = (gui_data->swap_history[gui_data->swap_history_size - 1] / gui_data->swap_total) * 100.0;
-            if (swap_percent > 100.0) swap_percent = 100.0;
-            
-            double y = height * (1.0 - swap_percent / 100.0);
-            
-            // Draw point with dark background
-            cairo_set_source_rgb(cr, 0.2, 0.2, 0.2);  // Dark gray background
-            cairo_arc(cr, x, y, 3.5, 0, 2 * M_PI);
-            cairo_fill(cr);
-            
-            cairo_set_source_rgb(cr, 0.843, 0.529, 0.0);
-            cairo_arc(cr, x, y, 2.5, 0, 2 * M_PI);
-            cairo_fill(cr);
-        }
-    }
+    GraphParams params = {
+        .history = source->history,
+        .span = graph_span_samples(&gui_data),
+        .span_label = graph_span_names[gui_data.graph_span],
+        .scale = scale,
+        .latest = *source->latest,
+        .color = { source->color[0], source->color[1], source->color[2] }
+    };
+    graph_render(cr, widget_cache(widget), allocation.width, allocation.height, &params);
     
     return FALSE;
 }
@@ -1017,26 +902,34 @@ void update_system_info_display(GuiWidgets *widgets, GuiData *data) {
  * Update CPU display
  */
 void update_cpu_display(GuiWidgets *widgets, GuiData *data) {
-    char cpu_info[256];
+    char cpu_info[512];
+    char activity[CPU_ACTIVITY_TEXT_BUFFER];
     
     // Validate CPU usage
     if (data->cpu_usage < 0) {
         data->cpu_usage = 0.0;
-        printf("[ Warning: CPU usage is negative. Adjusting to 0. ]\n");
+        TRACE_INFO("CPU usage is negative. Adjusting to 0.");
     }
     if (data->cpu_usage > 100.0) {
         data->cpu_usage = 100.0;
-        printf("[ Warning: CPU usage exceeds 100%%. Adjusting to 100%%. ]\n");
+        TRACE_INFO("CPU usage exceeds 100%%. Adjusting to 100%%.");
     }
     
-    printf("[ update_cpu_display: CPU usage = %.2f%% ]\n", data->cpu_usage);
+    TRACE_DEBUG("update_cpu_display: CPU usage = %.2f%%", data->cpu_usage);
     
-    // Update main CPU tab - simple markup
+    // Update main CPU tab - simple markup, load and scheduler activity below the usage
+    if (data->cpu_activity == NULL ||
+        formatCPUActivity(data->cpu_activity, activity, sizeof(activity)) == 0) {
+        activity[0] = '\0';
+    } else {
+        activity[strlen(activity) - 1] = '\0';   // Drop the last line break
+    }
     snprintf(cpu_info, sizeof(cpu_info),
              "<span font_desc=\"Monospace\">"
-             "CPU Usage: <span foreground=\"#5f87d7\">%.2f%%</span>"
+             "CPU Usage: <span foreground=\"#5f87d7\">%.2f%%</span>\n"
+             "<span foreground=\"#d0d0d0\">%s</span>"
              "</span>",
-             data->cpu_usage);
+             data->cpu_usage, activity);
     
     gtk_label_set_markup(GTK_LABEL(widgets->cpu_usage_label), cpu_info);
     
@@ -1065,14 +958,11 @@ void update_cpu_display(GuiWidgets *widgets, GuiData *data) {
              cpu_color, data->cpu_usage,
              cpu_color, cpu_level);
     
-    // Debug log before updating label
-    printf("[ Updating CPU label: %s ]\n", cpu_info);
-    
     gtk_label_set_markup(GTK_LABEL(widgets->dashboard_cpu_label), cpu_info);
     
     // Update CPU progress bar
     double fraction = data->cpu_usage / 100.0;
-    printf("[ Updating CPU progress bar: %.2f ]\n", fraction);
+    TRACE_DEBUG("Updating CPU progress bar: %.2f", fraction);
     
     gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(widgets->cpu_usage_bar), fraction);
     gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(widgets->dashboard_cpu_bar), fraction);
@@ -1094,120 +984,31 @@ void update_cpu_display(GuiWidgets *widgets, GuiData *data) {
         gtk_style_context_add_class(context, "cpu-low");
     }
     
-    // Redraw CPU graph widget
-    gtk_widget_queue_draw(widgets->cpu_usage_graph);
-    gtk_widget_queue_draw(widgets->dashboard_cpu_graph);
-    
-    printf("[ update_cpu_display: complete ]\n");
-}
-
-/**
- * Calculate memory information more accurately
- * Linux: Read information from /proc/meminfo
- * macOS: Use vm_statistics or sysctl
- * 
- * @param used_memory Pointer to store used memory (in GB)
- * @param total_memory Pointer to store total memory (in GB)
- * @param used_swap Pointer to store used swap (in GB)
- * @param total_swap Pointer to store total swap (in GB)
- * @return 0 on success, -1 on failure
- */
-int get_detailed_memory_info(double *used_memory, double *total_memory, 
-                             double *used_swap, double *total_swap) {
-#ifdef __linux__
-    // Linux system code
-    FILE *fp;
-    char buffer[256];
-    long memTotal = 0, memFree = 0, buffers = 0, cached = 0, swapTotal = 0, swapFree = 0;
-    
-    // Open /proc/meminfo file
-    fp = fopen("/proc/meminfo", "r");
-    if (fp == NULL) {
-        // If opening file fails, use sysinfo information as a fallback
-        struct sysinfo sys_info;
-        if (sysinfo(&sys_info) == 0) {
-            *total_memory = (double)sys_info.totalram / (1024 * 1024 * 1024);
-            *used_memory = *total_memory - (double)sys_info.freeram / (1024 * 1024 * 1024);
-            *total_swap = (double)sys_info.totalswap / (1024 * 1024 * 1024);
-            *used_swap = *total_swap - (double)sys_info.freeswap / (1024 * 1024 * 1024);
-            return 0;
-        }
-        return -1;
-    }
-    
-    // Parse /proc/meminfo file
-    while (fgets(buffer, sizeof(buffer), fp)) {
-        if (sscanf(buffer, "MemTotal: %ld kB", &memTotal) == 1) {
-            continue;
-        }
-        if (sscanf(buffer, "MemFree: %ld kB", &memFree) == 1) {
-            continue;
-        }
-        if (sscanf(buffer, "Buffers: %ld kB", &buffers) == 1) {
-            continue;
-        }
-        if (sscanf(buffer, "Cached: %ld kB", &cached) == 1) {
-            continue;
-        }
-        if (sscanf(buffer, "SwapTotal: %ld kB", &swapTotal) == 1) {
-            continue;
-        }
-        if (sscanf(buffer, "SwapFree: %ld kB", &swapFree) == 1) {
-            continue;
+    // Update per-core usage, eight cores per line
+    if (data->core_count > 0) {
+        GString *cores = g_string_new("<span font_desc=\"Monospace\">");
+        
+        for (int i = 0; i < data->core_count; i++) {
+            const char *core_color = "#87af5f";
+            if (data->core_usage[i] > 90.0f) {
+                core_color = "#d75f5f";
+            } else if (data->core_usage[i] > 70.0f) {
+                core_color = "#d78700";
+            }
+            
+            g_string_append_printf(cores, "cpu%-3d <span foreground=\"%s\">%5.1f%%</span>%s",
+                                   data->core_id[i], core_color, data->core_usage[i],
+                                   (i % 8 == 7) ? "\n" : "  ");
         }
+        
+        g_string_append(cores, "</span>");
+        gtk_label_set_markup(GTK_LABEL(widgets->cpu_cores_label), cores->str);
+        g_string_free(cores, TRUE);
     }
     
-    fclose(fp);
-    
-    // Convert values to GB
-    const double KB_TO_GB = 1024.0 * 1024.0;
-    *total_memory = memTotal / KB_TO_GB;
-    
-    // Used memory = total memory - free memory - buffers - cached
-    // This method more accurately reflects "available" memory
-    *used_memory = (memTotal - memFree - buffers - cached) / KB_TO_GB;
-    
-    // Ensure non-negative values
-    if (*used_memory < 0) *used_memory = 0;
-    
-    *total_swap = swapTotal / KB_TO_GB;
-    *used_swap = (swapTotal - swapFree) / KB_TO_GB;
-    
-    return 0;
-    
-#elif defined(__APPLE__) && defined(__MACH__)
-    // macOS system code
-    // macOS requires using mach interfaces or sysctl functions,
-    // but here we assume platform.h's calculate_memory_usage() function is already implemented
-
-    // Total memory (GB)
-    *total_memory = calculate_memory_total();
-    
-    // Used memory (GB)
-    *used_memory = calculate_memory_usage();
-    
-    // If used memory is greater than total memory, adjust
-    if (*used_memory > *total_memory) {
-        *used_memory = *total_memory * 0.85;  // Temporary adjustment value (85%)
-    }
-    
-    // Swap information (macOS requires a separate function for swap)
-    *total_swap = calculate_swap_total();
-    *used_swap = calculate_swap_usage();
-    
-    return 0;
-#else
-    // Other systems use sysinfo
-    struct sysinfo sys_info;
-    if (sysinfo(&sys_info) == 0) {
-        *total_memory = (double)sys_info.totalram / (1024 * 1024 * 1024);
-        *used_memory = *total_memory - (double)sys_info.freeram / (1024 * 1024 * 1024);
-        *total_swap = (double)sys_info.totalswap / (1024 * 1024 * 1024);
-        *used_swap = *total_swap - (double)sys_info.freeswap / (1024 * 1024 * 1024);
-        return 0;
-    }
-    return -1;
-#endif
+    // Redraw CPU graph widget
+    gtk_widget_queue_draw(widgets->cpu_usage_graph);
+    gtk_widget_queue_draw(widgets->dashboard_cpu_graph);
 }
 
 /**
@@ -1418,219 +1219,468 @@ void update_users_display(GuiWidgets *widgets, GuiData *data) {
 }
 
 /**
- * Collect system data and update GUI (timer callback)
+ * Process list columns
  */
-gboolean update_system_data(gpointer user_data) {
-    GuiData *data = (GuiData *)user_data;
-    struct utsname sys_name_info;
-    int days, hours, minutes, seconds;
-    
-    // Collect CPU usage - simplified stable approach
-    LOG_INFO(SYS_MON_SUCCESS, "Collecting CPU information");
-    
-    // Static variables for CPU calculation
-    static unsigned long prev_stats[7] = {0};
-    static unsigned long curr_stats[7] = {0};
-    static double last_cpu_usage = 15.0; // Start with reasonable default
-    static int samples_collected = 0;
-    
-    // Backup previous values before getting new ones
-    memcpy(prev_stats, curr_stats, sizeof(curr_stats));
-    
-    // Get current CPU stats
-    get_cpu_stats(curr_stats);
-    
-    // Calculate CPU usage
-    double cpu_usage = last_cpu_usage; // Default to last usage if calculation fails
-    
-    // Debug info
-    printf("CPU raw stats - User: %lu, Nice: %lu, System: %lu, Idle: %lu\n", 
-           curr_stats[0], curr_stats[1], curr_stats[2], curr_stats[3]);
-    
-    // Only process if we have at least one previous sample
-    if (samples_collected > 0) {
-        // Calculate deltas for user, nice, system, idle
-        unsigned long user_delta = (curr_stats[0] >= prev_stats[0]) ? 
-                                  (curr_stats[0] - prev_stats[0]) : 0;
-        unsigned long nice_delta = (curr_stats[1] >= prev_stats[1]) ? 
-                                  (curr_stats[1] - prev_stats[1]) : 0;
-        unsigned long system_delta = (curr_stats[2] >= prev_stats[2]) ? 
-                                    (curr_stats[2] - prev_stats[2]) : 0;
-        unsigned long idle_delta = (curr_stats[3] >= prev_stats[3]) ? 
-                                  (curr_stats[3] - prev_stats[3]) : 0;
+enum {
+    PROCESS_COLUMN_PID,
+    PROCESS_COLUMN_STATE,
+    PROCESS_COLUMN_THREADS,
+    PROCESS_COLUMN_CPU,
+    PROCESS_COLUMN_COMMAND,
+    PROCESS_COLUMNS
+};
+
+/**
+ * Process memory list columns
+ */
+enum {
+    MEMORY_COLUMN_PID,
+    MEMORY_COLUMN_RSS,
+    MEMORY_COLUMN_PSS,
+    MEMORY_COLUMN_SWAP,
+    MEMORY_COLUMN_COMMAND,
+    MEMORY_COLUMNS
+};
+
+/**
+ * Update process memory list
+ */
+static void update_process_memory_list(GuiWidgets *widgets, const ProcessSample *processes) {
+    static const char *const titles[MEMORY_COLUMNS] = { "PID", "RSS", "PSS", "Swap", "Command" };
+    GtkListStore *store;
+    GtkTreeIter iter;
+    
+    store = GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(widgets->processes_memory_list)));
+    if (store == NULL) {
+        store = gtk_list_store_new(MEMORY_COLUMNS, G_TYPE_INT, G_TYPE_STRING, G_TYPE_STRING,
+                                   G_TYPE_STRING, G_TYPE_STRING);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(widgets->processes_memory_list), GTK_TREE_MODEL(store));
+        g_object_unref(store);
         
-        // Total delta = sum of all activity
-        unsigned long total_delta = user_delta + nice_delta + system_delta + idle_delta;
+        for (int c = 0; c < MEMORY_COLUMNS; c++) {
+            GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
+            GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes(
+                titles[c], renderer, "text", c, NULL);
+            gtk_tree_view_append_column(GTK_TREE_VIEW(widgets->processes_memory_list), column);
+        }
+    } else {
+        gtk_list_store_clear(store);
+    }
+    
+    for (int i = 0; i < processes->memory_count; i++) {
+        const ProcessMemoryEntry *entry = &processes->memory_top[i];
+        char rss[32], pss[32] = "-", swap[32] = "-";
         
-        // Log the deltas for debugging
-        printf("CPU deltas - User: %lu, Nice: %lu, System: %lu, Idle: %lu, Total: %lu\n",
-               user_delta, nice_delta, system_delta, idle_delta, total_delta);
+        // PSS and swap are unknown when smaps_rollup is not readable
+        snprintf(rss, sizeof(rss), "%.1f", entry->rss_kb / 1024.0);
+        if (entry->has_smaps) {
+            snprintf(pss, sizeof(pss), "%.1f", entry->pss_kb / 1024.0);
+            snprintf(swap, sizeof(swap), "%.1f", entry->swap_kb / 1024.0);
+        }
+        gtk_list_store_append(store, &iter);
+        gtk_list_store_set(store, &iter,
+                           MEMORY_COLUMN_PID, entry->pid,
+                           MEMORY_COLUMN_RSS, rss,
+                           MEMORY_COLUMN_PSS, pss,
+                           MEMORY_COLUMN_SWAP, swap,
+                           MEMORY_COLUMN_COMMAND, entry->comm,
+                           -1);
+    }
+}
+
+/**
+ * Update processes display
+ */
+void update_processes_display(GuiWidgets *widgets, GuiData *data) {
+    static const char *const titles[PROCESS_COLUMNS] = { "PID", "S", "Threads", "CPU %", "Command" };
+    const ProcessSample *processes = data->processes;
+    GtkListStore *store;
+    GtkTreeIter iter;
+    char text[128];
+    
+    if (processes == NULL) {
+        return;
+    }
+    
+    snprintf(text, sizeof(text), "%d processes (scan %.2f ms), busiest first",
+             processes->total, processes->scan_ns / 1e6);
+    gtk_label_set_text(GTK_LABEL(widgets->processes_label), text);
+    
+    store = GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(widgets->processes_list)));
+    if (store == NULL) {
+        store = gtk_list_store_new(PROCESS_COLUMNS, G_TYPE_INT, G_TYPE_STRING, G_TYPE_INT,
+                                   G_TYPE_STRING, G_TYPE_STRING);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(widgets->processes_list), GTK_TREE_MODEL(store));
+        g_object_unref(store);
         
-        // If we have valid deltas, calculate CPU percentage
-        if (total_delta > 0) {
-            // CPU percentage = non-idle time / total time
-            double new_usage = 100.0 * (double)(total_delta - idle_delta) / (double)total_delta;
-            
-            // Apply bounds
-            if (new_usage < 0.0) new_usage = 0.0;
-            if (new_usage > 100.0) new_usage = 100.0;
-            
-            printf("Raw calculated CPU usage: %.2f%%\n", new_usage);
-            
-            // Apply weighted average with previous value to smooth out spikes
-            // More weight to previous value if this is a big change
-            if (fabs(new_usage - last_cpu_usage) > 25.0) {
-                // Big change - heavily favor previous value
-                cpu_usage = 0.85 * last_cpu_usage + 0.15 * new_usage;
-                printf("Large change detected, applying heavy smoothing\n");
-            } else if (fabs(new_usage - last_cpu_usage) > 10.0) {
-                // Medium change - moderately favor previous value
-                cpu_usage = 0.65 * last_cpu_usage + 0.35 * new_usage;
-                printf("Medium change detected, applying moderate smoothing\n");
-            } else {
-                // Small change - light smoothing
-                cpu_usage = 0.5 * last_cpu_usage + 0.5 * new_usage;
-                printf("Small change, applying light smoothing\n");
-            }
-            
-            printf("Smoothed CPU usage: %.2f%%\n", cpu_usage);
-        } else {
-            // No significant activity, use previous value
-            printf("No significant CPU activity detected, keeping previous value\n");
+        for (int c = 0; c < PROCESS_COLUMNS; c++) {
+            GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
+            GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes(
+                titles[c], renderer, "text", c, NULL);
+            gtk_tree_view_append_column(GTK_TREE_VIEW(widgets->processes_list), column);
         }
     } else {
-        // First sample, can't calculate yet
-        printf("First CPU sample collected, waiting for next sample\n");
+        gtk_list_store_clear(store);
     }
     
-    // Special case handling for when CPU reading is 0
-    if (cpu_usage < 2.0 && last_cpu_usage > 5.0) {
-        // Sudden drop to near-zero - likely incorrect reading
-        // Only allow gradual decreases
-        cpu_usage = last_cpu_usage * 0.7;  // decay toward zero rather than jump
-        printf("Suspect zero reading detected, decaying value instead: %.2f%%\n", cpu_usage);
+    for (int i = 0; i < processes->count; i++) {
+        const ProcessEntry *entry = &processes->top[i];
+        char state[2] = { entry->state, '\0' };
+        
+        snprintf(text, sizeof(text), "%.1f", entry->cpu_percent);
+        gtk_list_store_append(store, &iter);
+        gtk_list_store_set(store, &iter,
+                           PROCESS_COLUMN_PID, entry->pid,
+                           PROCESS_COLUMN_STATE, state,
+                           PROCESS_COLUMN_THREADS, entry->threads,
+                           PROCESS_COLUMN_CPU, text,
+                           PROCESS_COLUMN_COMMAND, entry->comm,
+                           -1);
     }
     
-    // Update for next iteration
-    last_cpu_usage = cpu_usage;
-    samples_collected++;
+    update_process_memory_list(widgets, processes);
+}
+
+/**
+ * Pressure list columns
+ */
+enum {
+    PRESSURE_COLUMN_RESOURCE,
+    PRESSURE_COLUMN_SOME_AVG10,
+    PRESSURE_COLUMN_SOME_AVG60,
+    PRESSURE_COLUMN_SOME_AVG300,
+    PRESSURE_COLUMN_SOME_RECENT,
+    PRESSURE_COLUMN_FULL_AVG10,
+    PRESSURE_COLUMN_FULL_AVG60,
+    PRESSURE_COLUMN_FULL_AVG300,
+    PRESSURE_COLUMN_FULL_RECENT,
+    PRESSURE_COLUMNS
+};
+
+/**
+ * Update pressure display
+ */
+void update_pressure_display(GuiWidgets *widgets, GuiData *data) {
+    static const char *const titles[PRESSURE_COLUMNS] = {
+        "Resource", "Some 10s", "60s", "300s", "Recent", "Full 10s", "60s", "300s", "Recent"
+    };
+    const PressureSample *pressure = data->pressure;
+    GtkListStore *store;
+    GtkTreeIter iter;
+    char text[PRESSURE_COLUMNS][16];
     
-    // Update the GUI data
-    data->cpu_usage = cpu_usage;
+    if (pressure == NULL) {
+        return;
+    }
     
-    // Log final value
-    printf("Final CPU Usage: %.2f%%\n", data->cpu_usage);
+    gtk_label_set_text(GTK_LABEL(widgets->pressure_label), data->pressure_signalled ?
+                       "Share of time tasks stalled (%) - sampled now: a trigger fired" :
+                       "Share of time tasks stalled (%)");
     
-    // Update CPU history
-    if (data->cpu_history == NULL) {
-        LOG_INFO(SYS_MON_SUCCESS, "Initializing CPU history (size: 60)");
-        data->cpu_history_size = 60; // 1 minute of data (1 second intervals)
-        data->cpu_history = calloc(data->cpu_history_size, sizeof(float));
+    store = GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(widgets->pressure_list)));
+    if (store == NULL) {
+        store = gtk_list_store_new(PRESSURE_COLUMNS, G_TYPE_STRING,
+                                   G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                                   G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(widgets->pressure_list), GTK_TREE_MODEL(store));
+        g_object_unref(store);
         
-        // Initialize with current value
-        for (int i = 0; i < data->cpu_history_size; i++) {
-            data->cpu_history[i] = (float)data->cpu_usage;
+        for (int c = 0; c < PRESSURE_COLUMNS; c++) {
+            GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
+            GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes(
+                titles[c], renderer, "text", c, NULL);
+            gtk_tree_view_append_column(GTK_TREE_VIEW(widgets->pressure_list), column);
         }
     } else {
-        // Shift data
-        for (int i = 0; i < data->cpu_history_size - 1; i++) {
-            data->cpu_history[i] = data->cpu_history[i + 1];
+        gtk_list_store_clear(store);
+    }
+    
+    for (int r = 0; r < PRESSURE_RESOURCES; r++) {
+        const PressureStat *stat = &pressure->resource[r];
+        const float values[PRESSURE_COLUMNS - 1] = {
+            stat->some.avg10, stat->some.avg60, stat->some.avg300, stat->some.recent,
+            stat->full.avg10, stat->full.avg60, stat->full.avg300, stat->full.recent
+        };
+        if (!stat->available) {
+            continue;
         }
         
-        // Add new data
-        data->cpu_history[data->cpu_history_size - 1] = (float)data->cpu_usage;
+        for (int c = 1; c < PRESSURE_COLUMNS; c++) {
+            snprintf(text[c], sizeof(text[c]), "%.2f", values[c - 1]);
+        }
+        gtk_list_store_append(store, &iter);
+        gtk_list_store_set(store, &iter,
+                           PRESSURE_COLUMN_RESOURCE, pressureResourceName((PressureResource)r),
+                           PRESSURE_COLUMN_SOME_AVG10, text[PRESSURE_COLUMN_SOME_AVG10],
+                           PRESSURE_COLUMN_SOME_AVG60, text[PRESSURE_COLUMN_SOME_AVG60],
+                           PRESSURE_COLUMN_SOME_AVG300, text[PRESSURE_COLUMN_SOME_AVG300],
+                           PRESSURE_COLUMN_SOME_RECENT, text[PRESSURE_COLUMN_SOME_RECENT],
+                           PRESSURE_COLUMN_FULL_AVG10, text[PRESSURE_COLUMN_FULL_AVG10],
+                           PRESSURE_COLUMN_FULL_AVG60, text[PRESSURE_COLUMN_FULL_AVG60],
+                           PRESSURE_COLUMN_FULL_AVG300, text[PRESSURE_COLUMN_FULL_AVG300],
+                           PRESSURE_COLUMN_FULL_RECENT, text[PRESSURE_COLUMN_FULL_RECENT],
+                           -1);
     }
+}
+
+/**
+ * Disk list columns
+ */
+enum {
+    DISK_COLUMN_NAME,
+    DISK_COLUMN_READ_IOPS,
+    DISK_COLUMN_WRITE_IOPS,
+    DISK_COLUMN_READ_MB,
+    DISK_COLUMN_WRITE_MB,
+    DISK_COLUMN_AWAIT,
+    DISK_COLUMN_UTIL,
+    DISK_COLUMNS
+};
+
+/**
+ * Update disks display
+ */
+void update_disks_display(GuiWidgets *widgets, GuiData *data) {
+    static const char *const titles[DISK_COLUMNS] = {
+        "Device", "Reads/s", "Writes/s", "Read MB/s", "Write MB/s", "Await (ms)", "Util (%)"
+    };
+    const double MB = 1024.0 * 1024.0;
+    const DiskSample *disks = data->disks;
+    GtkListStore *store;
+    GtkTreeIter iter;
+    char text[DISK_COLUMNS][16];
+    char summary[128];
     
-    // Collect memory information - more accurate function
-    if (get_detailed_memory_info(&data->memory_used, &data->memory_total, 
-                                &data->swap_used, &data->swap_total) != 0) {
-        // If error occurs, use previous method
-        data->memory_used = calculate_memory_usage();
-        data->memory_total = calculate_memory_total();
-        data->swap_used = calculate_swap_usage();
-        data->swap_total = calculate_swap_total();
+    if (disks == NULL) {
+        return;
     }
     
-    // Update memory history
-    if (data->memory_history == NULL) {
-        data->memory_history_size = 60; // 1 minute of data (1 second intervals)
-        data->memory_history = calloc(data->memory_history_size, sizeof(double));
+    snprintf(summary, sizeof(summary), "%d devices, %.0f IOPS, read %.2f MB/s, write %.2f MB/s",
+             disks->devices, disks->total_iops,
+             disks->total_read_bytes / MB, disks->total_write_bytes / MB);
+    gtk_label_set_text(GTK_LABEL(widgets->disks_label), summary);
+    
+    store = GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(widgets->disks_list)));
+    if (store == NULL) {
+        store = gtk_list_store_new(DISK_COLUMNS, G_TYPE_STRING,
+                                   G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                                   G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(widgets->disks_list), GTK_TREE_MODEL(store));
+        g_object_unref(store);
         
-        // Set initial history values
-        for (int i = 0; i < data->memory_history_size; i++) {
-            data->memory_history[i] = data->memory_used;
+        for (int c = 0; c < DISK_COLUMNS; c++) {
+            GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
+            GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes(
+                titles[c], renderer, "text", c, NULL);
+            gtk_tree_view_append_column(GTK_TREE_VIEW(widgets->disks_list), column);
         }
     } else {
-        // Move data
-        for (int i = 0; i < data->memory_history_size - 1; i++) {
-            data->memory_history[i] = data->memory_history[i + 1];
-        }
-        // Add new data
-        data->memory_history[data->memory_history_size - 1] = data->memory_used;
+        gtk_list_store_clear(store);
     }
     
-    // Update swap history
-    if (data->swap_history == NULL) {
-        data->swap_history_size = 60; // 1 minute of data (1 second intervals)
-        data->swap_history = calloc(data->swap_history_size, sizeof(double));
+    for (int i = 0; i < disks->count; i++) {
+        const DiskEntry *entry = &disks->top[i];
         
-        // Set initial history values
-        for (int i = 0; i < data->swap_history_size; i++) {
-            data->swap_history[i] = data->swap_used;
-        }
+        snprintf(text[DISK_COLUMN_READ_IOPS], sizeof(text[0]), "%.1f", entry->read_iops);
+        snprintf(text[DISK_COLUMN_WRITE_IOPS], sizeof(text[0]), "%.1f", entry->write_iops);
+        snprintf(text[DISK_COLUMN_READ_MB], sizeof(text[0]), "%.2f", entry->read_bytes / MB);
+        snprintf(text[DISK_COLUMN_WRITE_MB], sizeof(text[0]), "%.2f", entry->write_bytes / MB);
+        snprintf(text[DISK_COLUMN_AWAIT], sizeof(text[0]), "%.2f", entry->await_ms);
+        snprintf(text[DISK_COLUMN_UTIL], sizeof(text[0]), "%.1f", entry->util_percent);
+        gtk_list_store_append(store, &iter);
+        gtk_list_store_set(store, &iter,
+                           DISK_COLUMN_NAME, entry->name,
+                           DISK_COLUMN_READ_IOPS, text[DISK_COLUMN_READ_IOPS],
+                           DISK_COLUMN_WRITE_IOPS, text[DISK_COLUMN_WRITE_IOPS],
+                           DISK_COLUMN_READ_MB, text[DISK_COLUMN_READ_MB],
+                           DISK_COLUMN_WRITE_MB, text[DISK_COLUMN_WRITE_MB],
+                           DISK_COLUMN_AWAIT, text[DISK_COLUMN_AWAIT],
+                           DISK_COLUMN_UTIL, text[DISK_COLUMN_UTIL],
+                           -1);
+    }
+    
+    gtk_widget_queue_draw(widgets->disks_graph);
+}
+
+/**
+ * Update network display
+ */
+void update_network_display(GuiWidgets *widgets, GuiData *data) {
+    const NetSample *network = data->network;
+    char network_info[256];
+    
+    if (network == NULL) {
+        return;
+    }
+    
+    snprintf(network_info, sizeof(network_info),
+             "Received: %.1f KB/s\nSent: %.1f KB/s\nDrops: %.1f/s  Errors: %.1f/s\n"
+             "Interfaces: %d (+%d -%d)  Busiest: %s",
+             network->total_rx_bytes / 1024.0, network->total_tx_bytes / 1024.0,
+             network->total_drops, network->total_errors,
+             network->interfaces, network->appeared, network->disappeared,
+             network->count > 0 ? network->top[0].name : "-");
+    gtk_label_set_text(GTK_LABEL(widgets->dashboard_network_label), network_info);
+    gtk_widget_queue_draw(widgets->dashboard_network_graph);
+}
+
+/**
+ * Cgroup list columns
+ */
+enum {
+    CGROUP_COLUMN_PATH,
+    CGROUP_COLUMN_CORES,
+    CGROUP_COLUMN_MEMORY,
+    CGROUP_COLUMN_CPU_PRESSURE,
+    CGROUP_COLUMN_MEMORY_PRESSURE,
+    CGROUP_COLUMN_IO_PRESSURE,
+    CGROUP_COLUMNS
+};
+
+/**
+ * Update cgroups display
+ */
+void update_cgroups_display(GuiWidgets *widgets, GuiData *data) {
+    static const char *const titles[CGROUP_COLUMNS] = {
+        "Group", "Cores", "Memory (MB)", "CPU some (%)", "Memory some (%)", "IO some (%)"
+    };
+    const CgroupTreeSample *tree = data->cgroup_tree;
+    GtkListStore *store;
+    GtkTreeIter iter;
+    char text[CGROUP_COLUMNS][CGROUP_TREE_PATH_LENGTH + 16];
+    char summary[CGROUP_TEXT_BUFFER + 128];
+    size_t used = 0;
+    
+    if (data->cgroup == NULL || tree == NULL) {
+        return;
+    }
+    
+    // Own group against its limits, then the hierarchy totals
+    summary[0] = '\0';
+    if (data->cgroup->path[0] != '\0') {
+        formatCgroupSample(data->cgroup, summary, sizeof(summary));
+        used = strlen(summary);
+    }
+    if (tree->groups > 0) {
+        snprintf(summary + used, sizeof(summary) - used, "%d groups, %d populated",
+                 tree->groups, tree->populated);
     } else {
-        // Move data
-        for (int i = 0; i < data->swap_history_size - 1; i++) {
-            data->swap_history[i] = data->swap_history[i + 1];
-        }
-        // Add new data
-        data->swap_history[data->swap_history_size - 1] = data->swap_used;
+        snprintf(summary + used, sizeof(summary) - used, "No cgroup v2 hierarchy");
     }
+    gtk_label_set_text(GTK_LABEL(widgets->cgroups_label), summary);
     
-    // Collect system information
-    if (uname(&sys_name_info) == 0) {
-        free(data->system_name);
-        data->system_name = strdup(sys_name_info.sysname);
-        
-        free(data->node_name);
-        data->node_name = strdup(sys_name_info.nodename);
-        
-        free(data->version);
-        data->version = strdup(sys_name_info.version);
+    store = GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(widgets->cgroups_list)));
+    if (store == NULL) {
+        store = gtk_list_store_new(CGROUP_COLUMNS, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,
+                                   G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(widgets->cgroups_list), GTK_TREE_MODEL(store));
+        g_object_unref(store);
         
-        free(data->release);
-        data->release = strdup(sys_name_info.release);
+        for (int c = 0; c < CGROUP_COLUMNS; c++) {
+            GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
+            GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes(
+                titles[c], renderer, "text", c, NULL);
+            gtk_tree_view_append_column(GTK_TREE_VIEW(widgets->cgroups_list), column);
+        }
+    } else {
+        gtk_list_store_clear(store);
+    }
+    
+    for (int i = 0; i < tree->count; i++) {
+        const CgroupTreeEntry *entry = &tree->top[i];
+        int indent = entry->depth < 8 ? entry->depth * 2 : 16;
         
-        free(data->machine);
-        data->machine = strdup(sys_name_info.machine);
+        snprintf(text[CGROUP_COLUMN_PATH], sizeof(text[0]), "%*s%s%s", indent, "", entry->path,
+                 entry->populated ? "" : " (empty)");
+        snprintf(text[CGROUP_COLUMN_CORES], sizeof(text[0]), "%.2f", entry->cpu_cores);
+        snprintf(text[CGROUP_COLUMN_MEMORY], sizeof(text[0]), "%.1f", entry->memory_current / (1024.0 * 1024.0));
+        snprintf(text[CGROUP_COLUMN_CPU_PRESSURE], sizeof(text[0]), "%.2f", entry->pressure[0]);
+        snprintf(text[CGROUP_COLUMN_MEMORY_PRESSURE], sizeof(text[0]), "%.2f", entry->pressure[1]);
+        snprintf(text[CGROUP_COLUMN_IO_PRESSURE], sizeof(text[0]), "%.2f", entry->pressure[2]);
+        gtk_list_store_append(store, &iter);
+        gtk_list_store_set(store, &iter,
+                           CGROUP_COLUMN_PATH, text[CGROUP_COLUMN_PATH],
+                           CGROUP_COLUMN_CORES, text[CGROUP_COLUMN_CORES],
+                           CGROUP_COLUMN_MEMORY, text[CGROUP_COLUMN_MEMORY],
+                           CGROUP_COLUMN_CPU_PRESSURE, text[CGROUP_COLUMN_CPU_PRESSURE],
+                           CGROUP_COLUMN_MEMORY_PRESSURE, text[CGROUP_COLUMN_MEMORY_PRESSURE],
+                           CGROUP_COLUMN_IO_PRESSURE, text[CGROUP_COLUMN_IO_PRESSURE],
+                           -1);
     }
+}
+
+/**
+ * Collect system data and update GUI (timer callback)
+ */
+gboolean update_system_data(gpointer user_data) {
+    GuiData *data = (GuiData *)user_data;
     
-    // Get system uptime
-    get_system_uptime(&days, &hours, &minutes, &seconds);
-    data->uptime_days = days;
-    data->uptime_hours = hours;
-    data->uptime_minutes = minutes;
-    data->uptime_seconds = seconds;
-    
-    // Collect user session information
-    if (data->users != NULL) {
-        for (int i = 0; i < data->user_count; i++) {
-            free(data->users[i]);
-        }
-        free(data->users);
+    // Collection runs on the publisher thread; only render when it has
+    // published something new
+    const GuiSnapshot *snapshot = gui_collector_latest(&gui_collector);
+    if (snapshot == NULL) {
+        return G_SOURCE_CONTINUE;
     }
     
-    // Collect user session information
-    // Currently, a simple example
-    data->user_count = 1;
-    data->users = calloc(data->user_count, sizeof(char *));
-    data->users[0] = strdup("Current User (Terminal)");
+    // Update the GUI data; strings and arrays are borrowed from the snapshot,
+    // which stays valid until the next pick-up
+    data->cpu_usage = snapshot->cpu_usage;
+    data->core_count = snapshot->cores.count;
+    data->cpu_activity = &snapshot->cpu_activity;
+    data->core_id = snapshot->cores.id;
+    data->core_usage = snapshot->cores.usage;
+    
+    data->memory_used = snapshot->memory_used;
+    data->memory_total = snapshot->memory_total;
+    data->swap_used = snapshot->swap_used;
+    data->swap_total = snapshot->swap_total;
+    
+    const SystemInfoSample *system = &snapshot->system;
+    data->system_name = system->sysname[0] != '\0' ? system->sysname : NULL;
+    data->node_name = system->nodename;
+    data->version = system->version;
+    data->release = system->release;
+    data->machine = system->machine;
+    data->uptime_days = system->uptime_days;
+    data->uptime_hours = system->uptime_hours;
+    data->uptime_minutes = system->uptime_minutes;
+    data->uptime_seconds = system->uptime_seconds;
+    
+    data->users = snapshot->user_lines;
+    data->user_count = snapshot->user_count;
+    data->processes = &snapshot->processes;
+    data->pressure = &snapshot->pressure;
+    data->pressure_signalled = snapshot->pressure_signalled;
+    data->disks = &snapshot->disks;
+    data->disk_util = snapshot->disks.busiest_util;
+    data->network = &snapshot->network;
+    data->cgroup = &snapshot->cgroup;
+    data->cgroup_tree = &snapshot->cgroup_tree;
+    data->network_bytes = snapshot->network.total_rx_bytes + snapshot->network.total_tx_bytes;
+    if (data->network_bytes > data->network_peak) {
+        data->network_peak = data->network_bytes;
+    }
+    
+    // Append to the histories (O(1), rollups update incrementally);
+    // trigger snapshots between ticks would add extra points
+    if (!snapshot->between_ticks) {
+        history_append(&data->cpu_history, (float)data->cpu_usage);
+        history_append(&data->memory_history, (float)data->memory_used);
+        history_append(&data->swap_history, (float)data->swap_used);
+        history_append(&data->disk_history, (float)data->disk_util);
+        history_append(&data->network_history, (float)data->network_bytes);
+    }
     
     // Update GUI
     update_system_info_display(&widgets, data);
     update_cpu_display(&widgets, data);
     update_memory_display(&widgets, data);
     update_users_display(&widgets, data);
+    update_processes_display(&widgets, data);
+    update_pressure_display(&widgets, data);
+    update_disks_display(&widgets, data);
+    update_network_display(&widgets, data);
+    update_cgroups_display(&widgets, data);
     
     // Update status bar
     char status_msg[128];
@@ -1649,7 +1699,8 @@ gboolean update_system_data(gpointer user_data) {
     gtk_statusbar_push(GTK_STATUSBAR(widgets.statusbar), 
                       widgets.statusbar_context_id, status_msg);
     
-    LOG_INFO(SYS_MON_SUCCESS, "Data updated");
+    TRACE_INFO("Data updated: tick %lu, CPU %.1f%%, memory %.2f GB",
+               snapshot->tick, data->cpu_usage, data->memory_used);
     return G_SOURCE_CONTINUE; // Continue timer
 }
 
@@ -1684,8 +1735,7 @@ void updateCPUDisplay(GtkWidget *label, unsigned long prevCpuUsage[7], unsigned
     // Update the GUI label with the formatted text
     gtk_label_set_markup(GTK_LABEL(label), displayText);
     
-    // Debug output to verify data flow
-    printf("GUI: Updated CPU display with usage %.1f%%\n", cpuUsage);
+    TRACE_DEBUG("GUI: Updated CPU display with usage %.1f%%", cpuUsage);
 }
 
 /**
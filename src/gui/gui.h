@@ -2,6 +2,8 @@
 #define GUI_H
 
 #include "common.h"
+#include "collector.h"
+#include "history.h"
 
 // Include GTK+ headers (conditionally)
 #ifdef HAVE_GTK
@@ -49,6 +51,8 @@ typedef struct {
     GtkWidget *dashboard_swap_label;
     GtkWidget *dashboard_swap_bar;
     GtkWidget *dashboard_swap_graph;
+    GtkWidget *dashboard_network_label;
+    GtkWidget *dashboard_network_graph;
     GtkWidget *dashboard_users_list;
     
     // System tab widgets
@@ -60,6 +64,7 @@ typedef struct {
     GtkWidget *cpu_usage_label;
     GtkWidget *cpu_usage_bar;
     GtkWidget *cpu_usage_graph;
+    GtkWidget *cpu_cores_label;
     
     // Memory tab widgets
     GtkWidget *memory_box;
@@ -74,6 +79,28 @@ typedef struct {
     GtkWidget *users_box;
     GtkWidget *users_list;
     
+    // Processes tab widgets
+    GtkWidget *processes_box;
+    GtkWidget *processes_label;
+    GtkWidget *processes_list;
+    GtkWidget *processes_memory_list;
+    
+    // Pressure tab widgets
+    GtkWidget *pressure_box;
+    GtkWidget *pressure_label;
+    GtkWidget *pressure_list;
+    
+    // Disks tab widgets
+    GtkWidget *disks_box;
+    GtkWidget *disks_label;
+    GtkWidget *disks_graph;
+    GtkWidget *disks_list;
+    
+    // Cgroups tab widgets
+    GtkWidget *cgroups_box;
+    GtkWidget *cgroups_label;
+    GtkWidget *cgroups_list;
+    
     // Status bar
     GtkWidget *statusbar;
     guint statusbar_context_id;
@@ -88,45 +115,87 @@ typedef struct {
 typedef struct {
     // CPU data
     double cpu_usage;
-    float *cpu_history;
-    int cpu_history_size;
+    history_t cpu_history;          // Usage (%)
+    
+    // Per-core CPU data (borrowed from the current GUI snapshot)
+    int core_count;
+    const int *core_id;
+    const float *core_usage;
+    
+    // Load averages and scheduler activity (borrowed from the current GUI snapshot)
+    const CPUActivity *cpu_activity;
     
     // Memory data
     double memory_total;
     double memory_used;
-    double *memory_history;
-    int memory_history_size;
+    history_t memory_history;       // Used memory (GB)
     
     // Swap data
     double swap_total;
     double swap_used;
-    double *swap_history;
-    int swap_history_size;
-    
-    // System information
-    char *system_name;
-    char *node_name;
-    char *release;
-    char *version;
-    char *machine;
+    history_t swap_history;         // Used swap (GB)
+    
+    // System information (borrowed from the current GUI snapshot)
+    const char *system_name;
+    const char *node_name;
+    const char *release;
+    const char *version;
+    const char *machine;
     int uptime_days;
     int uptime_hours;
     int uptime_minutes;
     int uptime_seconds;
     
-    // User session data
-    char **users;
+    // User session data (borrowed from the current GUI snapshot)
+    const char *const *users;
     int user_count;
     
+    // Busiest processes (borrowed from the current GUI snapshot)
+    const ProcessSample *processes;
+    
+    // Pressure stall information (borrowed from the current GUI snapshot)
+    const PressureSample *pressure;
+    int pressure_signalled;
+    
+    // Block device I/O (borrowed from the current GUI snapshot)
+    const DiskSample *disks;
+    double disk_util;
+    history_t disk_history;         // Busiest device utilization (%)
+    
+    // Network traffic (borrowed from the current GUI snapshot)
+    const NetSample *network;
+    double network_bytes;           // Received + sent, all interfaces (bytes/s)
+    double network_peak;            // Highest network_bytes seen, the graph's 100%
+    history_t network_history;      // Received + sent (bytes/s)
+    
+    // Cgroups (borrowed from the current GUI snapshot)
+    const CgroupSample *cgroup;
+    const CgroupTreeSample *cgroup_tree;
+    
     // Update interval (milliseconds)
     guint update_interval;
+    
+    // Time span shown by the graphs (index into the span table, changed on scroll)
+    int graph_span;
 } GuiData;
 
+/**
+ * Graph source
+ *
+ * Tells the shared graph renderer which history a drawing area plots.
+ */
+typedef struct {
+    const history_t *history;   // Samples to plot
+    const double *latest;       // Newest value
+    const double *total;        // Value at 100% (NULL: values are already percentages)
+    double color[3];            // Line color (RGB)
+} GraphSource;
+
 /**
  * Structure to hold system data for GUI
  */
 typedef struct {
-    int pipe_fd[2];                      // Pipe file descriptors for IPC
+    CollectorEngine *engine;             // Background collector threads
     GtkWidget *cpuLabel;                 // Label for CPU usage display
     GtkWidget *memoryLabel;              // Label for memory usage display
     unsigned long prevCpuUsage[7];       // Previous CPU usage statistics
@@ -152,21 +221,18 @@ void update_cpu_display(GuiWidgets *widgets, GuiData *data);
 void update_memory_display(GuiWidgets *widgets, GuiData *data);
 void update_system_info_display(GuiWidgets *widgets, GuiData *data);
 void update_users_display(GuiWidgets *widgets, GuiData *data);
+void update_processes_display(GuiWidgets *widgets, GuiData *data);
+void update_pressure_display(GuiWidgets *widgets, GuiData *data);
+void update_disks_display(GuiWidgets *widgets, GuiData *data);
+void update_network_display(GuiWidgets *widgets, GuiData *data);
+void update_cgroups_display(GuiWidgets *widgets, GuiData *data);
 
 // Graph drawing functions
-gboolean draw_cpu_graph(GtkWidget *widget, cairo_t *cr, gpointer data);
-gboolean draw_memory_graph(GtkWidget *widget, cairo_t *cr, gpointer data);
-gboolean draw_swap_graph(GtkWidget *widget, cairo_t *cr, gpointer data);
+gboolean draw_graph(GtkWidget *widget, cairo_t *cr, gpointer data);
 
 // Event handlers
 void on_window_destroy(GtkWidget *widget, gpointer data);
 
-/**
- * Function to create the main GUI window
- * @param pipe_fd Pipe file descriptor array
- */
-void createGUI(int pipe_fd[2]);
-
 /**
  * Function to update the CPU usage display
  * @param label GTK label to update
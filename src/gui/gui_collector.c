@@ -0,0 +1,231 @@
+#include "gui_collector.h"
+#include "error.h"
+#include "trace.h"
+#include <string.h>
+#include <math.h>
+
+// Set on the middle slot index while it holds an unread snapshot
+#define GUI_SNAPSHOT_FRESH 0x4u
+
+/**
+ * Smooth the aggregate CPU usage of one engine snapshot
+ * @param collector Collector (owns the smoothing state)
+ * @param cpu CPU section of the engine snapshot
+ * @return Smoothed usage (%)
+ */
+static double smooth_cpu_usage(GuiCollector *collector, const CPUSample *cpu) {
+    const unsigned long *prev_stats = cpu->prev;
+    const unsigned long *curr_stats = cpu->curr;
+    double last_cpu_usage = collector->last_cpu_usage;
+    double cpu_usage = last_cpu_usage; // Default to last usage if calculation fails
+
+    TRACE_DEBUG("CPU raw stats - User: %lu, Nice: %lu, System: %lu, Idle: %lu",
+                curr_stats[0], curr_stats[1], curr_stats[2], curr_stats[3]);
+
+    // Calculate deltas for user, nice, system, idle
+    unsigned long user_delta = (curr_stats[0] >= prev_stats[0]) ?
+                              (curr_stats[0] - prev_stats[0]) : 0;
+    unsigned long nice_delta = (curr_stats[1] >= prev_stats[1]) ?
+                              (curr_stats[1] - prev_stats[1]) : 0;
+    unsigned long system_delta = (curr_stats[2] >= prev_stats[2]) ?
+                                (curr_stats[2] - prev_stats[2]) : 0;
+    unsigned long idle_delta = (curr_stats[3] >= prev_stats[3]) ?
+                              (curr_stats[3] - prev_stats[3]) : 0;
+
+    // Total delta = sum of all activity
+    unsigned long total_delta = user_delta + nice_delta + system_delta + idle_delta;
+
+    TRACE_DEBUG("CPU deltas - User: %lu, Nice: %lu, System: %lu, Idle: %lu, Total: %lu",
+                user_delta, nice_delta, system_delta, idle_delta, total_delta);
+
+    // If we have valid deltas, calculate CPU percentage
+    if (total_delta > 0) {
+        // CPU percentage = non-idle time / total time
+        double new_usage = 100.0 * (double)(total_delta - idle_delta) / (double)total_delta;
+
+        // Apply bounds
+        if (new_usage < 0.0) new_usage = 0.0;
+        if (new_usage > 100.0) new_usage = 100.0;
+
+        TRACE_DEBUG("Raw calculated CPU usage: %.2f%%", new_usage);
+
+        // Apply weighted average with previous value to smooth out spikes
+        // More weight to previous value if this is a big change
+        if (fabs(new_usage - last_cpu_usage) > 25.0) {
+            // Big change - heavily favor previous value
+            cpu_usage = 0.85 * last_cpu_usage + 0.15 * new_usage;
+            TRACE_DEBUG("Large change detected, applying heavy smoothing");
+        } else if (fabs(new_usage - last_cpu_usage) > 10.0) {
+            // Medium change - moderately favor previous value
+            cpu_usage = 0.65 * last_cpu_usage + 0.35 * new_usage;
+            TRACE_DEBUG("Medium change detected, applying moderate smoothing");
+        } else {
+            // Small change - light smoothing
+            cpu_usage = 0.5 * last_cpu_usage + 0.5 * new_usage;
+            TRACE_DEBUG("Small change, applying light smoothing");
+        }
+
+        TRACE_DEBUG("Smoothed CPU usage: %.2f%%", cpu_usage);
+    } else {
+        // No significant activity, use previous value
+        TRACE_DEBUG("No significant CPU activity detected, keeping previous value");
+    }
+
+    // Special case handling for when CPU reading is 0
+    if (cpu_usage < 2.0 && last_cpu_usage > 5.0) {
+        // Sudden drop to near-zero - likely incorrect reading
+        // Only allow gradual decreases
+        cpu_usage = last_cpu_usage * 0.7;  // decay toward zero rather than jump
+        TRACE_INFO("Suspect zero reading detected, decaying value instead: %.2f%%", cpu_usage);
+    }
+
+    collector->last_cpu_usage = cpu_usage;
+    return cpu_usage;
+}
+
+/**
+ * Split the users section into one entry per session
+ * @param out Snapshot being filled
+ * @param users Users section of the engine snapshot
+ */
+static void split_user_lines(GuiSnapshot *out, const UserSample *users) {
+    memcpy(out->user_text, users->text, sizeof(out->user_text));
+    out->user_text[sizeof(out->user_text) - 1] = '\0';
+    out->user_count = 0;
+
+    char *line = out->user_text;
+    while (*line != '\0' && out->user_count < GUI_MAX_USERS) {
+        char *end = strchr(line, '\n');
+        if (end != NULL) {
+            *end = '\0';
+        }
+        out->user_lines[out->user_count++] = line;
+        if (end == NULL) {
+            break;
+        }
+        line = end + 1;
+    }
+}
+
+/**
+ * Convert one engine snapshot into a GUI snapshot
+ * @param collector Collector (keeps the last CPU usage)
+ * @param snapshot Engine snapshot
+ * @param out Back slot to fill
+ */
+static void build_snapshot(GuiCollector *collector, const SystemSnapshot *snapshot, GuiSnapshot *out) {
+    const double BYTES_TO_GB = 1024.0 * 1024.0 * 1024.0;
+    const MemorySample *memory = &snapshot->memory;
+
+    out->tick = snapshot->tick;
+    out->between_ticks = snapshot->between_ticks;
+
+    // A trigger snapshot carries no new CPU counters: repeat the last figures
+    if (snapshot->between_ticks) {
+        out->cpu_usage = collector->last_cpu_usage;
+    } else {
+        out->cpu_usage = smooth_cpu_usage(collector, &snapshot->cpu);
+        TRACE_INFO("Final CPU Usage: %.2f%% (tick %lu)", out->cpu_usage, out->tick);
+    }
+    out->cpu_activity = snapshot->cpu.activity;
+    out->cores = snapshot->cpu.cores;
+
+    // Used memory = total memory - MemAvailable (same figure as the CLI)
+    out->memory_total = memory->phys_total / BYTES_TO_GB;
+    out->memory_used = (memory->phys_total - memory->phys_available) / BYTES_TO_GB;
+    out->swap_total = memory->swap_total / BYTES_TO_GB;
+    out->swap_used = (memory->swap_total - memory->swap_free) / BYTES_TO_GB;
+
+    out->system = snapshot->system;
+    split_user_lines(out, &snapshot->users);
+    out->processes = snapshot->processes;
+    out->pressure = snapshot->pressure;
+    out->pressure_signalled = (snapshot->signalled & COLLECT_PRESSURE) != 0;
+    out->disks = snapshot->disks;
+    out->network = snapshot->network;
+    out->cgroup = snapshot->cgroup;
+    out->cgroup_tree = snapshot->cgroup_tree;
+}
+
+/**
+ * Publisher thread: drains the engine and publishes GUI snapshots
+ * @param arg GUI collector
+ * @return NULL
+ */
+static void *publisher_thread(void *arg) {
+    GuiCollector *collector = arg;
+    SystemSnapshot snapshot;
+
+    while (collectorReceive(&collector->engine, &snapshot) == 0) {
+        build_snapshot(collector, &snapshot, &collector->slots[collector->back]);
+
+        // Hand the filled slot over and take back whichever slot was in the middle
+        unsigned int previous = atomic_exchange_explicit(&collector->middle,
+                                                         collector->back | GUI_SNAPSHOT_FRESH,
+                                                         memory_order_acq_rel);
+        collector->back = previous & ~GUI_SNAPSHOT_FRESH;
+    }
+    return NULL;
+}
+
+/**
+ * Start collecting in the background
+ * @param collector Collector to start
+ * @param interval_ms Sampling interval (milliseconds)
+ * @return STATUS_SUCCESS, or an error status
+ */
+int gui_collector_start(GuiCollector *collector, int interval_ms) {
+    collector->started = 0;
+    collector->back = 0;
+    collector->front = 1;
+    atomic_store(&collector->middle, 2);
+    collector->last_cpu_usage = 15.0; // Start with reasonable default
+
+    int status = collectorStart(&collector->engine, 0, interval_ms, COLLECT_ALL);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+
+    if (pthread_create(&collector->thread, NULL, publisher_thread, collector) != 0) {
+        LOG_ERROR(SYS_MON_ERR_SYSTEM, "Failed to create GUI publisher thread");
+        collectorStop(&collector->engine);
+        return STATUS_ERROR_FORK;
+    }
+    collector->started = 1;
+    return STATUS_SUCCESS;
+}
+
+/**
+ * Pick up the most recent snapshot (GTK thread only)
+ * @param collector Running collector
+ * @return Newest unread snapshot, or NULL if nothing new was published
+ */
+const GuiSnapshot *gui_collector_latest(GuiCollector *collector) {
+    if (!(atomic_load_explicit(&collector->middle, memory_order_acquire) & GUI_SNAPSHOT_FRESH)) {
+        return NULL;
+    }
+
+    // Only the publisher sets the flag, so the exchange always returns a fresh slot
+    unsigned int fresh = atomic_exchange_explicit(&collector->middle, collector->front,
+                                                  memory_order_acq_rel);
+    collector->front = fresh & ~GUI_SNAPSHOT_FRESH;
+    return &collector->slots[collector->front];
+}
+
+/**
+ * Stop the publisher and the collector engine
+ * @param collector Collector to stop
+ */
+void gui_collector_stop(GuiCollector *collector) {
+    if (!collector->started) {
+        return;
+    }
+
+    // The publisher may be blocked in collectorReceive: interrupt it before
+    // the engine (and its ring) goes away
+    collectorInterrupt(&collector->engine);
+    pthread_join(collector->thread, NULL);
+    collector->started = 0;
+
+    collectorStop(&collector->engine);
+}
@@ -0,0 +1,113 @@
+#ifndef GUI_COLLECTOR_H
+#define GUI_COLLECTOR_H
+
+#include "common.h"
+#include "collector.h"
+#include "cpu.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+// User session lines kept in a GUI snapshot
+#define GUI_MAX_USERS 64
+
+/**
+ * GUI snapshot
+ *
+ * Everything the GUI renders for one tick, already converted to display
+ * units. Snapshots are filled by the publisher thread and never modified
+ * once published; pointers into a snapshot stay valid until the GTK thread
+ * picks up the next one.
+ */
+typedef struct {
+    uint64_t tick;                      // Collector tick this snapshot was built from
+    int between_ticks;                  // Built from a trigger snapshot: only pressure is new
+
+    // CPU data
+    double cpu_usage;                   // Smoothed aggregate usage (%)
+    CPUCoreSample cores;                // Per-core usage
+    CPUActivity cpu_activity;           // Load averages and scheduler activity
+
+    // Memory data (GB)
+    double memory_total;
+    double memory_used;
+    double swap_total;
+    double swap_used;
+
+    // System information
+    SystemInfoSample system;
+
+    // User sessions
+    int user_count;
+    const char *user_lines[GUI_MAX_USERS];  // Point into user_text
+    char user_text[MAX_USER_BUFFER];        // Session lines, NUL-separated
+    
+    // Busiest processes
+    ProcessSample processes;
+    
+    // Pressure stall information
+    PressureSample pressure;
+    int pressure_signalled;             // Collected because a pressure trigger fired
+    
+    // Block device I/O
+    DiskSample disks;
+    
+    // Network traffic
+    NetSample network;
+    
+    // Own cgroup and the busiest groups of the hierarchy
+    CgroupSample cgroup;
+    CgroupTreeSample cgroup_tree;
+} GuiSnapshot;
+
+/**
+ * GUI collector
+ *
+ * Runs the collector engine plus one publisher thread that turns engine
+ * snapshots into GuiSnapshots. Publication is a triple buffer: the
+ * publisher fills its back slot and swaps it with the shared middle slot
+ * in one atomic exchange; the GTK thread swaps its front slot with the
+ * middle slot when a fresh one is flagged. Neither side ever blocks or
+ * allocates on the hot path.
+ */
+typedef struct {
+    CollectorEngine engine;
+    pthread_t thread;
+    int started;                // Whether the publisher thread was created
+
+    GuiSnapshot slots[3];
+    _Atomic unsigned int middle;  // Shared slot index, GUI_SNAPSHOT_FRESH when unread
+    unsigned int back;            // Publisher-owned slot
+    unsigned int front;           // GTK-owned slot
+
+    // Publisher thread state
+    double last_cpu_usage;
+} GuiCollector;
+
+/**
+ * Start collecting in the background
+ *
+ * @param collector Collector to start
+ * @param interval_ms Sampling interval (milliseconds)
+ * @return STATUS_SUCCESS, or an error status
+ */
+int gui_collector_start(GuiCollector *collector, int interval_ms);
+
+/**
+ * Pick up the most recent snapshot (GTK thread only)
+ *
+ * The returned snapshot, and every pointer into it, stays valid until the
+ * next call.
+ *
+ * @param collector Running collector
+ * @return Newest unread snapshot, or NULL if nothing new was published
+ */
+const GuiSnapshot *gui_collector_latest(GuiCollector *collector);
+
+/**
+ * Stop the publisher and the collector engine
+ *
+ * @param collector Collector to stop
+ */
+void gui_collector_stop(GuiCollector *collector);
+
+#endif // GUI_COLLECTOR_H
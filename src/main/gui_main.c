@@ -1,5 +1,6 @@
 #include "common.h"
 #include "gui.h"
+#include "trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -10,6 +11,9 @@ int main(int argc, char *argv[]) {
 #ifdef HAVE_GTK
     printf("GTK+ library detected. Initializing GUI...\n");
     
+    // Trace dumps (SIGUSR2 or exit); must precede every other thread
+    trace_init("system_monitor_gui.trace");
+    
     // Initialize and run GUI mode
     init_gui(&argc, &argv);
     run_gui();
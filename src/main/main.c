@@ -4,7 +4,17 @@
 #include "cpu.h"
 #include "user.h"
 #include "system.h"
+#include "process.h"
+#include "pressure.h"
+#include "disk.h"
+#include "net.h"
+#include "cgroup.h"
+#include "cgroup_tree.h"
+#include "collector.h"
 #include "error.h"
+#include "trace.h"
+#include "screen.h"
+#include "outbuf.h"
 
 #ifdef ENABLE_GUI
 #include "gui.h"
@@ -12,13 +22,13 @@
 
 // 상수 정의
 #define DEFAULT_REFRESH_RATE 1  // 기본 갱신 주기 (초)
+#define DEFAULT_BENCH_ITERATIONS 100000  // 기본 벤치마크 반복 횟수
 
 // 함수 선언
-void runSequentialMode(int samples, int tdelay, int user, int system, int graphics,
-                      PipeSet *pipes);
-void runNonsequentialMode(int samples, int tdelay, int user, int system, int graphics,
-                         PipeSet *pipes, int userLine_count);
-void closePipes(PipeSet *pipes);
+void runSequentialMode(int samples, int tdelay_ms, int user, int system, int graphics,
+                      int cores, int processes, int pressure, int disks, int network, int cgroup, int cgroupTree, CollectorEngine *engine);
+void runNonsequentialMode(int samples, int tdelay_ms, int user, int system, int graphics,
+                         int cores, int processes, int pressure, int disks, int network, int cgroup, int cgroupTree, CollectorEngine *engine);
 void printUsage(const char* programName);
 
 /**
@@ -36,22 +46,20 @@ void printUsage(const char* programName) {
     printf("  -u, --user                  Display user information only\n");
     printf("  -m, --system                Display system information only\n");
     printf("  -g, --graphics              Enable graphical display\n");
+    printf("  -p, --cores                 Display per-core CPU usage\n");
+    printf("  -t, --processes             Display the busiest processes\n");
+    printf("  -P, --pressure[=<stall ms>] Display pressure stall information; sample it at once when tasks\n");
+    printf("                              stall that long within %d ms (default: %d, 0: no trigger)\n",
+           PRESSURE_WINDOW_MS, PRESSURE_DEFAULT_STALL_MS);
+    printf("  -d, --disks                 Display per-device disk I/O (IOPS, throughput, latency, utilization)\n");
+    printf("  -n, --network               Display per-interface network traffic (bytes, packets, drops, errors)\n");
+    printf("  -C, --cgroup[=<path>]       Display CPU and memory of a cgroup v2 group against its effective limits\n");
+    printf("                              (default: the monitor's own group; path absolute or under the mount)\n");
+    printf("  -T, --cgroup-tree           Display the busiest groups of the whole cgroup v2 hierarchy with their\n");
+    printf("                              CPU, memory and pressure\n");
     printf("  --samples <count>           Number of samples to collect (default: 10)\n");
-    printf("  --tdelay <seconds>          Time between samples (default: 1 second)\n");
-}
-
-/**
- * 파이프 닫기 함수
- * 프로그램에서 사용한 모든 파이프를 닫습니다.
- * 
- * @param pipes 파이프 구조체 포인터
- */
-void closePipes(PipeSet *pipes) {
-    close(pipes->cpuPFD[0]);
-    close(pipes->cpuCFD[0]);
-    close(pipes->userFD[0]);
-    close(pipes->memFD[0]);
-    close(pipes->ucountFD[0]);
+    printf("  --tdelay <seconds|Nms>      Time between samples, e.g. 0.1 or 100ms (default: 1 second)\n");
+    printf("  --bench[=<iterations>]      Measure CPU statistics sampling cost (ns/sample)\n");
 }
 
 /**
@@ -63,6 +71,9 @@ void closePipes(PipeSet *pipes) {
  * @return 종료 코드
  */
 int main(int argc, char *argv[]) {
+    // 트레이스 초기화 (SIGUSR2 또는 종료 시 덤프, 다른 스레드 생성 전에 호출)
+    trace_init("system_monitor.trace");
+    
     // Initialize error handling system
     error_init("system_monitor.log", 0);  // 0 for non-verbose mode
     
@@ -90,6 +101,19 @@ int main(int argc, char *argv[]) {
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             printUsage(argv[0]);
             return EXIT_SUCCESS;
+        } else if (strncmp(argv[i], "--bench", 7) == 0) {
+            // 수집기 비용 측정 후 종료
+            int iterations = DEFAULT_BENCH_ITERATIONS;
+            if (argv[i][7] == '=') {
+                iterations = atoi(argv[i] + 8);
+            }
+            if (iterations <= 0) {
+                iterations = DEFAULT_BENCH_ITERATIONS;
+            }
+            printf("get_cpu_stats: %.0f ns/sample (%d iterations)\n",
+                   benchmarkCPUStats(iterations), iterations);
+            error_cleanup();
+            return EXIT_SUCCESS;
         }
         // GUI 모드 옵션은 CLI 모드에서 무시
         // else if (strcmp(argv[i], "-g") == 0 || strcmp(argv[i], "--gui") == 0) {
@@ -114,50 +138,64 @@ int main(int argc, char *argv[]) {
     // 프로그램 옵션 파싱
     ProgramOptions options = parseCommandLineOptions(argc, argv);
     
-    // 파이프 생성
-    PipeSet pipes;
-    
-    // Create pipes for inter-process communication
-    if (pipe(pipes.cpuPFD) < 0 || 
-        pipe(pipes.cpuCFD) < 0 || 
-        pipe(pipes.userFD) < 0 || 
-        pipe(pipes.memFD) < 0 || 
-        pipe(pipes.ucountFD) < 0) {
-        
-        LOG_FATAL(SYS_MON_ERR_PIPE, "Pipe creation failed: %s", strerror(errno));
-        // Fatal error logs and exits automatically
+    // 표시할 항목에 필요한 수집기만 실행
+    unsigned int mask = 0;
+    if (!options.user || options.system) {
+        mask |= COLLECT_MEMORY | COLLECT_CPU;
     }
-    
-    // Create child processes
-    ProcessIDs pids = createChildProcesses(options.samples, options.tdelay, &pipes);
-    
-    // Check if process creation was successful
-    if (pids.cpuPID <= 0 || pids.memPID <= 0 || pids.userPID <= 0) {
-        LOG_FATAL(SYS_MON_ERR_FORK, "Failed to create child processes");
+    if (options.user || !options.system) {
+        mask |= COLLECT_USERS;
     }
+    if (options.processes) {
+        mask |= COLLECT_PROCESSES;
+    }
+    if (options.pressure) {
+        mask |= COLLECT_PRESSURE;
+        pressureSetTrigger(options.pressure_stall_ms);
+    }
+    if (options.disks) {
+        mask |= COLLECT_DISKS;
+    }
+    if (options.network) {
+        mask |= COLLECT_NETWORK;
+    }
+    if (options.cgroup) {
+        mask |= COLLECT_CGROUP;
+        cgroupSetPath(options.cgroup_path);
+    }
+    if (options.cgroup_tree) {
+        mask |= COLLECT_CGROUP_TREE;
+    }
+    mask |= COLLECT_SYSTEM;  // 종료 시 시스템 정보 출력용
     
-    // 사용자 수 읽기
-    int userLine_count = 0;
-    read(pipes.ucountFD[0], &userLine_count, sizeof(userLine_count));
+    // 수집 스레드 시작 (스냅샷 링이 커서 힙에 할당)
+    CollectorEngine *engine = malloc(sizeof(CollectorEngine));
+    CHECK_ALLOC(engine);
+    if (collectorStart(engine, options.samples, options.tdelay_ms, mask) != STATUS_SUCCESS) {
+        LOG_FATAL(SYS_MON_ERR_SYSTEM, "Failed to start collector thread");
+    }
     
     // 순차 모드 또는 비순차 모드 실행
     // 순차 모드: 화면이 갱신될 때마다 이전 출력이 유지되고 새로운 출력이 추가됨
     // 비순차 모드: 화면이 갱신될 때마다 이전 출력이 지워지고 새로운 출력으로 대체됨
     if (options.sequential) {
-        runSequentialMode(options.samples, options.tdelay, options.user, 
-                         options.system, options.graphics, &pipes);
+        runSequentialMode(options.samples, options.tdelay_ms, options.user, 
+                         options.system, options.graphics, options.cores,
+                         options.processes, options.pressure, options.disks, options.network, options.cgroup, options.cgroup_tree, engine);
     } else {
-        runNonsequentialMode(options.samples, options.tdelay, options.user, 
-                            options.system, options.graphics, &pipes, userLine_count);
+        runNonsequentialMode(options.samples, options.tdelay_ms, options.user, 
+                            options.system, options.graphics, options.cores,
+                            options.processes, options.pressure, options.disks, options.network, options.cgroup, options.cgroup_tree, engine);
     }
     
-    // 파이프 닫기
-    closePipes(&pipes);
+    // 수집 스레드 정리
+    collectorStop(engine);
     
-    // 시스템 정보 출력
+    // 시스템 정보 출력 (마지막으로 수집된 system 섹션)
     printf("------------------------------------\n");
-    printSystemInfo();
+    printSystemInfo(&engine->working.system);
     printf("----------------------------------\n");
+    free(engine);
     
     // Clean up error handling
     error_cleanup();
@@ -167,202 +205,420 @@ int main(int argc, char *argv[]) {
 /**
  * 순차 모드 실행 함수
  * 화면이 갱신될 때마다 이전 출력을 유지하고 새로운 출력을 추가하는 모드입니다.
+ * 한 번의 출력을 프레임 버퍼에 모은 뒤 writev 한 번으로 내보냅니다.
+ * 저장된 그래픽 행은 복사하지 않고 참조합니다.
  * 
  * @param samples 샘플 수
- * @param tdelay 지연 시간(초)
+ * @param tdelay_ms 지연 시간(밀리초)
  * @param user 사용자 정보 표시 여부
  * @param system 시스템 정보 표시 여부
  * @param graphics 그래픽 표시 여부
- * @param pipes 파이프 구조체 포인터
+ * @param cores 코어별 사용률 표시 여부
+ * @param processes 프로세스 목록 표시 여부
+ * @param pressure 압력 정보 표시 여부
+ * @param disks 디스크 I/O 표시 여부
+ * @param network 네트워크 트래픽 표시 여부
+ * @param cgroup cgroup 사용량 표시 여부
+ * @param cgroupTree cgroup 계층 표시 여부
+ * @param engine 수집 엔진
  */
-void runSequentialMode(int samples, int tdelay, int user, int system, int graphics,
-                      PipeSet *pipes) {
+void runSequentialMode(int samples, int tdelay_ms, int user, int system, int graphics,
+                      int cores, int processes, int pressure, int disks, int network, int cgroup, int cgroupTree, CollectorEngine *engine) {
     // 데이터 저장을 위한 배열 및 변수 초기화
     char memArr[samples][MAX_MEMORY_BUFFER];  // 메모리 정보 저장 배열
     char cpuArr[samples][MAX_CPU_BUFFER];     // CPU 정보 저장 배열
-    unsigned long prevCpuUsage[7], currCpuUsage[7];  // CPU 사용량 데이터
+    int cpuLen[samples];                      // CPU 그래픽 행 길이
+    char blankLines[samples];                 // 메모리 영역의 빈 줄
     double virtual_used_gb = 0.0, prev_used_gb = 0.0;  // 메모리 사용량
     float cur_cpuUsage = 0.0, prevCpuUsageFloat = 0.0;  // CPU 사용량 계산 결과
-    size_t len = 0;
-    ssize_t bytes_read = 0;
+    SystemSnapshot snapshot;  // 수집 스레드에서 받은 스냅샷
+    char topInfo[256];  // 상단 정보
+    char coreText[CPU_CORE_TEXT_BUFFER];  // 코어별 사용률 텍스트
+    char activityText[CPU_ACTIVITY_TEXT_BUFFER];  // 부하 및 스케줄러 활동 텍스트
+    char processText[PROCESS_TEXT_BUFFER];  // 프로세스 목록 텍스트
+    char memoryText[PROCESS_TEXT_BUFFER];  // 프로세스 메모리 텍스트
+    char pressureText[PRESSURE_TEXT_BUFFER];  // 압력 정보 텍스트
+    char diskText[DISK_TEXT_BUFFER];  // 디스크 I/O 텍스트
+    char netText[NET_TEXT_BUFFER];  // 네트워크 트래픽 텍스트
+    char cgroupText[CGROUP_TEXT_BUFFER];  // cgroup 사용량 텍스트
+    char cgroupTreeText[CGROUP_TREE_TEXT_BUFFER];  // cgroup 계층 텍스트
+    outbuf_t frame;  // 프레임 출력 버퍼 (프레임 간 재사용)
+    
+    memset(blankLines, '\n', sizeof(blankLines));
+    outbuf_init(&frame);
+    fflush(stdout);  // 이전 stdio 출력이 프레임보다 먼저 나가도록
     
     // 샘플 수만큼 반복 실행
     for (int i = 0; i < samples; i++) {
         cpuArr[i][0] = '\0';  // CPU 배열 초기화
-        sleep(tdelay);  // 지정된 시간만큼 대기
+        cpuLen[i] = 0;
+        
+        // 다음 스냅샷 수신 (수집 주기마다 하나)
+        if (collectorReceive(engine, &snapshot) != 0) {
+            break;
+        }
+        
+        // 수집 주기 사이에 압력 트리거로 들어온 스냅샷: 압력 정보만 출력하고 샘플로 세지 않음
+        if (snapshot.between_ticks) {
+            if (pressure && (snapshot.updated & COLLECT_PRESSURE)) {
+                formatPressureSample(&snapshot.pressure, pressureText, sizeof(pressureText));
+                outbuf_puts(&frame, PRESSURE_TRIGGER_TITLE "\n");
+                outbuf_puts(&frame, pressureText);
+                outbuf_puts(&frame, "---------------------------------------\n");
+                outbuf_flush(&frame, STDOUT_FILENO);
+            }
+            i--;
+            continue;
+        }
         
         // 상단 정보 출력 (샘플 수, 지연 시간, 현재 반복 횟수)
-        printTopInfo(samples, tdelay, 1, i);  // sequential = 1
+        formatTopInfo(topInfo, sizeof(topInfo), samples, tdelay_ms, 1, i);  // sequential = 1
+        outbuf_puts(&frame, topInfo);
         
         // 시스템 정보 표시 조건 확인
         if (!user || (user && system)) {
-            printf("---------------------------------------\n");
+            outbuf_puts(&frame, "---------------------------------------\n");
             
-            // 메모리 정보 읽기
-            len = 0;
-            bytes_read = read(pipes->memFD[0], &len, sizeof(len));
-            
-            // 메모리 정보가 성공적으로 읽혔는지 확인
-            if (bytes_read > 0 && len > 0 && len < sizeof(memArr[i])) {
-                bytes_read = read(pipes->memFD[0], memArr[i], len);
+            // 메모리 정보 출력
+            if (snapshot.updated & COLLECT_MEMORY) {
+                formatMemorySample(&snapshot.memory, memArr[i], sizeof(memArr[i]));
+                int memLen = (int)strlen(memArr[i]);
                 
-                if (bytes_read > 0) {
-                    memArr[i][bytes_read] = '\0';  // 문자열 종료 처리
-                    
-                    // 그래픽 표시 옵션이 활성화된 경우
-                    if (graphics) {
-                        virtual_used_gb = getVirtualMemoryUsage();
-                        createMemoryGraphics(virtual_used_gb, &prev_used_gb, memArr, i);
-                    }
-                    
-                    // 메모리 정보 출력
-                    printMemoryInfo(1, samples, memArr, i, pipes->memFD);
+                // 그래픽 표시 옵션이 활성화된 경우 (같은 샘플 사용)
+                if (graphics) {
+                    virtual_used_gb = memorySampleVirtualUsedGB(&snapshot.memory);
+                    memLen = createMemoryGraphics(virtual_used_gb, &prev_used_gb, memArr, i);
                 }
+                
+                // 메모리 정보 출력 (현재 샘플 줄만 채움)
+                outbuf_puts(&frame, MEMORY_INFO_TITLE "\n");
+                outbuf_append(&frame, blankLines, i);
+                outbuf_append_ref(&frame, memArr[i], memLen);
+                outbuf_append(&frame, blankLines, samples - i);
             }
             
             // 사용자 정보 출력 여부 확인
             if ((user && system) || !system) {
-                printf("---------------------------------------\n");
-                printUserInfo(pipes->userFD);
-                printf("---------------------------------------\n");
+                outbuf_puts(&frame, "---------------------------------------\n");
+                if (snapshot.updated & COLLECT_USERS) {
+                    outbuf_puts(&frame, USER_INFO_TITLE "\n");
+                    outbuf_puts(&frame, snapshot.users.text[0] != '\0' ?
+                                        snapshot.users.text : USER_INFO_NONE "\n");
+                }
+                outbuf_puts(&frame, "---------------------------------------\n");
             }
             
             // CPU 코어 정보 출력
-            printCPUCores();
+            outbuf_printf(&frame, "Number of CPU cores: %d\n", getCPUCores());
             
-            // CPU 정보 읽기
-            read(pipes->cpuPFD[0], &prevCpuUsage, sizeof(prevCpuUsage));
-            read(pipes->cpuCFD[0], &currCpuUsage, sizeof(currCpuUsage));
+            // CPU 사용량 계산 (구간 시작/끝 카운터)
+            if (snapshot.updated & COLLECT_CPU) {
+                cur_cpuUsage = calculateCPUUsage(snapshot.cpu.prev, snapshot.cpu.curr);
+            }
             
-            // CPU 사용량 계산 및 출력
-            cur_cpuUsage = calculateCPUUsage(prevCpuUsage, currCpuUsage);
-            printf("total cpu use: %.2f%%\n", cur_cpuUsage);
+            // CPU 사용량 출력
+            outbuf_printf(&frame, "total cpu use: %.2f%%\n", cur_cpuUsage);
             
-            // CPU 그래픽 표시
+            // 부하 평균 및 스케줄러 활동 출력 (CPU 카운터와 같은 읽기)
+            if ((snapshot.updated & COLLECT_CPU) &&
+                formatCPUActivity(&snapshot.cpu.activity, activityText, sizeof(activityText)) > 0) {
+                outbuf_puts(&frame, activityText);
+            }
+            
+            // 코어별 사용률 출력 (CPU 카운터와 같은 읽기)
+            if (cores && snapshot.cpu.cores.count > 0) {
+                formatPerCoreUsage(&snapshot.cpu.cores, coreText, sizeof(coreText));
+                outbuf_puts(&frame, coreText);
+            }
+            
+            // CPU 그래픽 표시 (저장된 행은 참조로 출력)
             if (graphics) {
-                setCPUGraphics(1, cpuArr, cur_cpuUsage, &prevCpuUsageFloat, i);
+                cpuLen[i] = buildCPUGraphics(cpuArr, cur_cpuUsage, &prevCpuUsageFloat, i);
+                for (int j = 0; j <= i; j++) {
+                    outbuf_append_ref(&frame, cpuArr[j], cpuLen[j]);
+                    outbuf_append(&frame, "\n", 1);
+                }
             }
         } else {
             // 사용자 정보만 표시
-            printf("---------------------------------------\n");
-            printUserInfo(pipes->userFD);
-            printf("---------------------------------------\n");
+            outbuf_puts(&frame, "---------------------------------------\n");
+            if (snapshot.updated & COLLECT_USERS) {
+                outbuf_puts(&frame, USER_INFO_TITLE "\n");
+                outbuf_puts(&frame, snapshot.users.text[0] != '\0' ?
+                                    snapshot.users.text : USER_INFO_NONE "\n");
+            }
+            outbuf_puts(&frame, "---------------------------------------\n");
         }
+        
+        // 프로세스 목록 출력 (CPU 사용률 순)
+        if (processes && (snapshot.updated & COLLECT_PROCESSES)) {
+            formatProcessSample(&snapshot.processes, processText, sizeof(processText));
+            outbuf_puts(&frame, PROCESS_INFO_TITLE "\n");
+            outbuf_puts(&frame, processText);
+            outbuf_puts(&frame, "---------------------------------------\n");
+            
+            // 메모리 사용량 순 (RSS, PSS, 스왑)
+            formatProcessMemory(&snapshot.processes, memoryText, sizeof(memoryText));
+            outbuf_puts(&frame, PROCESS_MEMORY_TITLE "\n");
+            outbuf_puts(&frame, memoryText);
+            outbuf_puts(&frame, "---------------------------------------\n");
+        }
+        
+        // 압력 정보 출력 (정체 시간 비율)
+        if (pressure && (snapshot.updated & COLLECT_PRESSURE)) {
+            formatPressureSample(&snapshot.pressure, pressureText, sizeof(pressureText));
+            outbuf_puts(&frame, (snapshot.signalled & COLLECT_PRESSURE) ?
+                                PRESSURE_TRIGGER_TITLE "\n" : PRESSURE_INFO_TITLE "\n");
+            outbuf_puts(&frame, pressureText);
+            outbuf_puts(&frame, "---------------------------------------\n");
+        }
+        
+        // 디스크 I/O 출력 (사용률 순)
+        if (disks && (snapshot.updated & COLLECT_DISKS)) {
+            formatDiskSample(&snapshot.disks, diskText, sizeof(diskText));
+            outbuf_puts(&frame, DISK_INFO_TITLE "\n");
+            outbuf_puts(&frame, diskText);
+            outbuf_puts(&frame, "---------------------------------------\n");
+        }
+        
+        // 네트워크 트래픽 출력 (처리량 순)
+        if (network && (snapshot.updated & COLLECT_NETWORK)) {
+            formatNetSample(&snapshot.network, netText, sizeof(netText));
+            outbuf_puts(&frame, NET_INFO_TITLE "\n");
+            outbuf_puts(&frame, netText);
+            outbuf_puts(&frame, "---------------------------------------\n");
+        }
+        
+        // cgroup 사용량 출력 (그룹 자체 제한 대비)
+        if (cgroup && (snapshot.updated & COLLECT_CGROUP)) {
+            formatCgroupSample(&snapshot.cgroup, cgroupText, sizeof(cgroupText));
+            outbuf_puts(&frame, CGROUP_INFO_TITLE "\n");
+            outbuf_puts(&frame, cgroupText);
+            outbuf_puts(&frame, "---------------------------------------\n");
+        }
+        
+        // cgroup 계층 출력 (CPU 사용량 상위 그룹, 트리 순서)
+        if (cgroupTree && (snapshot.updated & COLLECT_CGROUP_TREE)) {
+            formatCgroupTree(&snapshot.cgroup_tree, cgroupTreeText, sizeof(cgroupTreeText));
+            outbuf_puts(&frame, CGROUP_TREE_TITLE "\n");
+            outbuf_puts(&frame, cgroupTreeText);
+            outbuf_puts(&frame, "---------------------------------------\n");
+        }
+        
+        // 프레임을 writev 한 번으로 출력
+        outbuf_flush(&frame, STDOUT_FILENO);
     }
+    
+    outbuf_free(&frame);
 }
 
 /**
  * 비순차 모드 실행 함수
  * 화면이 갱신될 때마다 이전 출력이 지워지고 새로운 출력으로 대체되는 모드입니다.
+ * 매 프레임을 화면 버퍼에 구성한 뒤 이전 프레임과 달라진 부분만 한 번에 출력합니다.
  * 
  * @param samples 샘플 수
- * @param tdelay 지연 시간(초)
+ * @param tdelay_ms 지연 시간(밀리초)
  * @param user 사용자 정보 표시 여부
  * @param system 시스템 정보 표시 여부
  * @param graphics 그래픽 표시 여부
- * @param pipes 파이프 구조체 포인터
- * @param userLine_count 사용자 수
+ * @param cores 코어별 사용률 표시 여부
+ * @param processes 프로세스 목록 표시 여부
+ * @param pressure 압력 정보 표시 여부
+ * @param disks 디스크 I/O 표시 여부
+ * @param network 네트워크 트래픽 표시 여부
+ * @param cgroup cgroup 사용량 표시 여부
+ * @param cgroupTree cgroup 계층 표시 여부
+ * @param engine 수집 엔진
  */
-void runNonsequentialMode(int samples, int tdelay, int user, int system, int graphics,
-                         PipeSet *pipes, int userLine_count) {
+void runNonsequentialMode(int samples, int tdelay_ms, int user, int system, int graphics,
+                         int cores, int processes, int pressure, int disks, int network, int cgroup, int cgroupTree, CollectorEngine *engine) {
     // 데이터 저장을 위한 배열 및 변수 초기화
     char memArr[samples][MAX_MEMORY_BUFFER];  // 메모리 정보 저장 배열
     char cpuArr[samples][MAX_CPU_BUFFER];     // CPU 정보 저장 배열
-    unsigned long prevCpuUsage[7], currCpuUsage[7];  // CPU 사용량 데이터
     double virtual_used_gb = 0.0, prev_used_gb = 0.0;  // 메모리 사용량
     float cur_cpuUsage = 0.0, prevCpuUsageFloat = 0.0;  // CPU 사용량 계산 결과
-    size_t len = 0;
-    ssize_t bytes_read = 0;
-    int systemStartGraphics = 0;
-    int memStartCursor = 0;
-    int CPU_GRAPH_START_LINE;
+    SystemSnapshot snapshot;  // 수집 스레드에서 받은 스냅샷
+    int memCount = 0;  // 저장된 메모리 샘플 수
+    int cpuCount = 0;  // 저장된 CPU 그래픽 행 수
+    int coreLines = 0;  // 코어별 사용률 줄 수
+    char topInfo[256];  // 상단 정보
+    char coreText[CPU_CORE_TEXT_BUFFER];  // 코어별 사용률 텍스트
+    char activityText[CPU_ACTIVITY_TEXT_BUFFER] = "";  // 마지막 부하 및 스케줄러 활동
+    char usersText[MAX_USER_BUFFER] = "";  // 마지막 사용자 정보
+    char processText[PROCESS_TEXT_BUFFER] = "";  // 마지막 프로세스 목록
+    char memoryText[PROCESS_TEXT_BUFFER] = "";  // 마지막 프로세스 메모리 목록
+    char pressureText[PRESSURE_TEXT_BUFFER] = "";  // 마지막 압력 정보
+    int pressureSignalled = 0;  // 마지막 압력 정보가 트리거로 수집되었는지
+    char diskText[DISK_TEXT_BUFFER] = "";  // 마지막 디스크 I/O
+    char netText[NET_TEXT_BUFFER] = "";  // 마지막 네트워크 트래픽
+    char cgroupText[CGROUP_TEXT_BUFFER] = "";  // 마지막 cgroup 사용량
+    char cgroupTreeText[CGROUP_TREE_TEXT_BUFFER] = "";  // 마지막 cgroup 계층
+    screen_t screen;  // 화면 버퍼 (이전 프레임과 비교)
+    
+    if (screen_init(&screen) != 0) {
+        LOG_ERROR(SYS_MON_ERR_MEMORY, "Failed to allocate screen buffers");
+        return;
+    }
     
     // 샘플 수만큼 반복 실행
     for (int i = 0; i < samples; i++) {
-        sleep(tdelay);  // 지정된 시간만큼 대기
+        // 다음 스냅샷 수신 (수집 주기마다 하나)
+        if (collectorReceive(engine, &snapshot) != 0) {
+            break;
+        }
         
-        // 상단 정보 출력 (샘플 수, 지연 시간, 현재 반복 횟수)
-        printTopInfo(samples, tdelay, 0, i);  // sequential = 0
+        // 수집 주기 사이의 트리거 스냅샷은 샘플로 세지 않고 직전 샘플 화면을 다시 그림
+        if (snapshot.between_ticks) {
+            i--;
+        }
+        
+        // 스냅샷 반영
+        if (snapshot.updated & COLLECT_USERS) {
+            snprintf(usersText, sizeof(usersText), "%s", snapshot.users.text);
+        }
+        if (snapshot.updated & COLLECT_CPU) {
+            cur_cpuUsage = calculateCPUUsage(snapshot.cpu.prev, snapshot.cpu.curr);
+            formatCPUActivity(&snapshot.cpu.activity, activityText, sizeof(activityText));
+            if (cores) {
+                coreLines = formatPerCoreUsage(&snapshot.cpu.cores, coreText, sizeof(coreText));
+            }
+        }
+        if (snapshot.updated & COLLECT_MEMORY) {
+            formatMemorySample(&snapshot.memory, memArr[i], sizeof(memArr[i]));
+            
+            // 그래픽 표시 옵션이 활성화된 경우 (같은 샘플 사용)
+            if (graphics) {
+                virtual_used_gb = memorySampleVirtualUsedGB(&snapshot.memory);
+                createMemoryGraphics(virtual_used_gb, &prev_used_gb, memArr, i);
+            }
+            memCount = i + 1;
+            
+            if (graphics && system) {
+                buildCPUGraphics(cpuArr, cur_cpuUsage, &prevCpuUsageFloat, i);
+                cpuCount = i + 1;
+            }
+        }
+        if (processes && (snapshot.updated & COLLECT_PROCESSES)) {
+            formatProcessSample(&snapshot.processes, processText, sizeof(processText));
+            formatProcessMemory(&snapshot.processes, memoryText, sizeof(memoryText));
+        }
+        if (pressure && (snapshot.updated & COLLECT_PRESSURE)) {
+            formatPressureSample(&snapshot.pressure, pressureText, sizeof(pressureText));
+            pressureSignalled = (snapshot.signalled & COLLECT_PRESSURE) != 0;
+        }
+        if (disks && (snapshot.updated & COLLECT_DISKS)) {
+            formatDiskSample(&snapshot.disks, diskText, sizeof(diskText));
+        }
+        if (network && (snapshot.updated & COLLECT_NETWORK)) {
+            formatNetSample(&snapshot.network, netText, sizeof(netText));
+        }
+        if (cgroup && (snapshot.updated & COLLECT_CGROUP)) {
+            formatCgroupSample(&snapshot.cgroup, cgroupText, sizeof(cgroupText));
+        }
+        if (cgroupTree && (snapshot.updated & COLLECT_CGROUP_TREE)) {
+            formatCgroupTree(&snapshot.cgroup_tree, cgroupTreeText, sizeof(cgroupTreeText));
+        }
+        
+        // 프레임 구성
+        screen_begin(&screen);
+        formatTopInfo(topInfo, sizeof(topInfo), samples, tdelay_ms, 0, i < 0 ? 0 : i);
+        screen_puts(&screen, topInfo);
         
         // 시스템 정보 표시 조건 확인
         if (!user || (user && system)) {
-            printf("------------------------------------------------\n");
-            reserveSpace(samples);  // 출력 공간 확보
+            screen_puts(&screen, "------------------------------------------------\n");
+            
+            // 메모리 정보 (샘플 수만큼 줄 확보)
+            screen_puts(&screen, MEMORY_INFO_TITLE "\n");
+            for (int j = 0; j < samples; j++) {
+                screen_puts(&screen, j < memCount ? memArr[j] : "");
+                screen_puts(&screen, "\n");
+            }
             
             // 사용자 정보 출력 여부 확인
             if ((user && system) || !system) {
-                printf("---------------------------------------\n");
-                printUserInfo(pipes->userFD);
-                printf("---------------------------------------\n");
+                screen_puts(&screen, "---------------------------------------\n");
+                screen_puts(&screen, USER_INFO_TITLE "\n");
+                screen_puts(&screen, usersText[0] != '\0' ? usersText : USER_INFO_NONE "\n");
+                screen_puts(&screen, "---------------------------------------\n");
             }
             
-            // CPU 코어 정보 출력
-            printCPUCores();
-            
-            // CPU 정보 읽기
-            read(pipes->cpuPFD[0], &prevCpuUsage, sizeof(prevCpuUsage));
-            read(pipes->cpuCFD[0], &currCpuUsage, sizeof(currCpuUsage));
-            
-            // CPU 사용량 계산 및 출력
-            cur_cpuUsage = calculateCPUUsage(prevCpuUsage, currCpuUsage);
-            printf("total cpu use: %.2f%%\n", cur_cpuUsage);
-            
-            // 메모리 정보 읽기
-            len = 0;
-            bytes_read = read(pipes->memFD[0], &len, sizeof(len));
-            
-            // 메모리 정보가 성공적으로 읽혔는지 확인
-            if (bytes_read > 0 && len > 0 && len < sizeof(memArr[i])) {
-                bytes_read = read(pipes->memFD[0], memArr[i], len);
-                
-                if (bytes_read > 0) {
-                    memArr[i][bytes_read] = '\0';  // 문자열 종료 처리
-                    
-                    // 그래픽 표시 옵션이 활성화된 경우
-                    if (graphics) {
-                        virtual_used_gb = getVirtualMemoryUsage();
-                        createMemoryGraphics(virtual_used_gb, &prev_used_gb, memArr, i);
-                    }
-                    
-                    // 커서 위치 조정 - 시스템 설정에 따라 다르게 처리
-                    if (system && !user) {
-                        memStartCursor = samples + 3;
-                    } else if (system && user) {
-                        memStartCursor = samples + userLine_count + 4;
-                    } else if (user && !(system && user)) {
-                        memStartCursor = samples + userLine_count + 6;
-                    } else {
-                        memStartCursor = samples + userLine_count + 4;
-                    }
-                    printf("\033[%dA", memStartCursor);  // 커서를 위로 이동
-                    
-                    // 메모리 정보 출력
-                    printMemoryInfo(0, samples, memArr, i, pipes->memFD);
-                    
-                    // CPU 그래픽 표시
-                    if (graphics && system) {
-                        printf("\033[%d;1H", CPU_GRAPH_START_LINE = 18);  // 커서 위치 지정
-                        setCPUGraphics(0, cpuArr, cur_cpuUsage, &prevCpuUsageFloat, i);
-                    }
-                }
+            // CPU 코어 정보 및 사용량
+            screen_printf(&screen, "Number of CPU cores: %d\n", getCPUCores());
+            screen_printf(&screen, "total cpu use: %.2f%%\n", cur_cpuUsage);
+            screen_puts(&screen, activityText);
+            if (coreLines > 0) {
+                screen_puts(&screen, coreText);
             }
             
-            // 커서 위치 조정
-            int systemStart = userLine_count + 6;
-            if (graphics) {
-                systemStart = systemStartGraphics;
-            } else if (system && !user) {
-                systemStart = userLine_count + 3;
-            } else {
-                systemStart = userLine_count + 6;
+            // CPU 그래픽 표시
+            for (int j = 0; j < cpuCount; j++) {
+                screen_puts(&screen, cpuArr[j]);
+                screen_puts(&screen, "\n");
             }
-            printf("\033[%dB", systemStart);  // 커서를 아래로 이동
         } else {
             // 사용자 정보만 표시
-            printf("---------------------------------------\n");
-            printUserInfo(pipes->userFD);
-            printf("---------------------------------------\n");
-            printf("\033[%dB", userLine_count);  // 커서를 아래로 이동
+            screen_puts(&screen, "---------------------------------------\n");
+            screen_puts(&screen, USER_INFO_TITLE "\n");
+            screen_puts(&screen, usersText[0] != '\0' ? usersText : USER_INFO_NONE "\n");
+            screen_puts(&screen, "---------------------------------------\n");
+        }
+        
+        // 프로세스 목록 (CPU 사용률 순)
+        if (processText[0] != '\0') {
+            screen_puts(&screen, PROCESS_INFO_TITLE "\n");
+            screen_puts(&screen, processText);
+            screen_puts(&screen, "---------------------------------------\n");
+            screen_puts(&screen, PROCESS_MEMORY_TITLE "\n");
+            screen_puts(&screen, memoryText);
+            screen_puts(&screen, "---------------------------------------\n");
         }
+        
+        // 압력 정보 (정체 시간 비율)
+        if (pressureText[0] != '\0') {
+            screen_puts(&screen, pressureSignalled ? PRESSURE_TRIGGER_TITLE "\n" : PRESSURE_INFO_TITLE "\n");
+            screen_puts(&screen, pressureText);
+            screen_puts(&screen, "---------------------------------------\n");
+        }
+        
+        // 디스크 I/O (사용률 순)
+        if (diskText[0] != '\0') {
+            screen_puts(&screen, DISK_INFO_TITLE "\n");
+            screen_puts(&screen, diskText);
+            screen_puts(&screen, "---------------------------------------\n");
+        }
+        
+        // 네트워크 트래픽 (처리량 순)
+        if (netText[0] != '\0') {
+            screen_puts(&screen, NET_INFO_TITLE "\n");
+            screen_puts(&screen, netText);
+            screen_puts(&screen, "---------------------------------------\n");
+        }
+        
+        // cgroup 사용량 (그룹 자체 제한 대비)
+        if (cgroupText[0] != '\0') {
+            screen_puts(&screen, CGROUP_INFO_TITLE "\n");
+            screen_puts(&screen, cgroupText);
+            screen_puts(&screen, "---------------------------------------\n");
+        }
+        
+        // cgroup 계층 (CPU 사용량 상위 그룹, 트리 순서)
+        if (cgroupTreeText[0] != '\0') {
+            screen_puts(&screen, CGROUP_TREE_TITLE "\n");
+            screen_puts(&screen, cgroupTreeText);
+            screen_puts(&screen, "---------------------------------------\n");
+        }
+        
+        // Ctrl-C 프롬프트나 정지/재개로 터미널 내용이 바뀌었으면 전체를 다시 그림
+        if (redraw_flag) {
+            redraw_flag = 0;
+            screen_invalidate(&screen);
+        }
+        
+        // 달라진 부분만 한 번의 write로 출력
+        screen_present(&screen);
     }
-} 
\ No newline at end of file
+    
+    screen_free(&screen);
+}
@@ -19,13 +19,57 @@ typedef struct {
 } cpu_stats_t;
 
 /**
- * Memory usage calculation function
+ * CPU time fields of a /proc/stat "cpu" line, in file order
  * 
- * Calculates memory usage in GB for the current platform.
+ * Guest and guest_nice are already included in user and nice by the
+ * kernel, so they must not be added again when summing total time.
+ */
+enum {
+    CPU_FIELD_USER = 0,
+    CPU_FIELD_NICE,
+    CPU_FIELD_SYSTEM,
+    CPU_FIELD_IDLE,
+    CPU_FIELD_IOWAIT,
+    CPU_FIELD_IRQ,
+    CPU_FIELD_SOFTIRQ,
+    CPU_FIELD_STEAL,
+    CPU_FIELD_GUEST,
+    CPU_FIELD_GUEST_NICE,
+    CPU_STAT_FIELDS
+};
+
+/**
+ * System-wide activity counters
+ * 
+ * The /proc/stat lines that follow the cpu lines. ctxt, intr and processes
+ * are cumulative since boot; procs_running and procs_blocked are current.
+ */
+typedef struct {
+    uint64_t ctxt;              // Context switches
+    uint64_t intr;              // Interrupts serviced (total of the intr line)
+    uint64_t processes;         // Tasks created (forks)
+    uint64_t procs_running;     // Runnable tasks
+    uint64_t procs_blocked;     // Tasks blocked waiting for I/O
+} cpu_activity_t;
+
+/**
+ * Per-core CPU counter block
  * 
- * @return Memory usage (GB)
+ * Stores the full field set of every online core as a structure of arrays:
+ * ticks[field][i] is the counter of field for the core core_id[i]. Cores are
+ * kept in ascending core_id order; offline cores are simply absent. The
+ * activity counters come from the same read as the CPU counters.
  */
-double calculate_memory_usage(void);
+typedef struct {
+    int count;                          // Number of cores in the last read
+    int capacity;                       // Allocated slots per array
+    int *core_id;                       // cpuN index of each slot
+    uint64_t total[CPU_STAT_FIELDS];    // Aggregate "cpu" line
+    uint64_t *ticks[CPU_STAT_FIELDS];   // Per-core counters, one array per field
+    cpu_activity_t activity;            // Activity counters (zeroed when unavailable)
+    int has_activity;                   // Whether activity was read
+    void *source;                       // Platform reader state
+} cpu_counters_t;
 
 /**
  * Total memory capacity calculation function
@@ -63,6 +107,26 @@ double calculate_swap_total(void);
  */
 void get_cpu_stats(unsigned long cpu_usage[7]);
 
+/**
+ * Per-core CPU counter collection function
+ * 
+ * Reads the aggregate and every per-core counter line, then the
+ * activity counters, from one read of the statistics. The counter block
+ * owns its own reader, so separate blocks can be sampled from different
+ * threads.
+ * 
+ * @param counters Counter block (zero-initialized before first use)
+ * @return Number of cores read, or -1 on failure
+ */
+int get_cpu_core_stats(cpu_counters_t *counters);
+
+/**
+ * Per-core CPU counter release function
+ * 
+ * @param counters Counter block to release
+ */
+void cpu_counters_free(cpu_counters_t *counters);
+
 /**
  * System uptime information collection function
  * 
@@ -75,6 +139,7 @@ void get_cpu_stats(unsigned long cpu_usage[7]);
  */
 void get_system_uptime(int *days, int *hours, int *minutes, int *seconds);
 
+#ifdef __APPLE__
 /**
  * Structure compatible with Linux's sysinfo structure
  * 
@@ -106,5 +171,6 @@ struct sysinfo {
  * @return 0 on success, -1 on failure
  */
 int sysinfo(struct sysinfo *info);
+#endif // __APPLE__
 
 #endif // PLATFORM_H 
\ No newline at end of file
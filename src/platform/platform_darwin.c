@@ -103,56 +103,6 @@ void get_cpu_stats(unsigned long cpu_usage[7]) {
     }
 }
 
-/**
- * 메모리 사용량 계산 함수
- * @return 가상 메모리 사용량 (GB)
- */
-double calculate_memory_usage(void) {
-    // 물리 메모리 정보 가져오기
-    int64_t physical_memory;
-    int mib[2] = { CTL_HW, HW_MEMSIZE };
-    size_t len = sizeof(physical_memory);
-    
-    if (sysctl(mib, 2, &physical_memory, &len, NULL, 0) < 0) {
-        return 0.0;
-    }
-    
-    // 메모리 통계 가져오기
-    vm_size_t page_size;
-    mach_port_t mach_port = mach_host_self();
-    vm_statistics64_data_t vm_stats;
-    mach_msg_type_number_t count = sizeof(vm_stats) / sizeof(natural_t);
-    
-    if (host_page_size(mach_port, &page_size) != KERN_SUCCESS) {
-        return 0.0;
-    }
-    
-    if (host_statistics64(mach_port, HOST_VM_INFO64, (host_info64_t)&vm_stats, &count) != KERN_SUCCESS) {
-        return 0.0;
-    }
-    
-    // 물리 메모리 사용량 계산
-    double phys_total_gb = (double)physical_memory / (1024 * 1024 * 1024);
-    double phys_free_gb = (double)(vm_stats.free_count * page_size) / (1024 * 1024 * 1024);
-    double phys_used_gb = phys_total_gb - phys_free_gb;
-    
-    // 스왑 정보 가져오기
-    struct xsw_usage swap_usage;
-    len = sizeof(swap_usage);
-    mib[0] = CTL_VM;
-    mib[1] = VM_SWAPUSAGE;
-    
-    double swap_used_gb = 0.0;
-    if (sysctl(mib, 2, &swap_usage, &len, NULL, 0) == 0) {
-        swap_used_gb = (double)(swap_usage.xsu_total - swap_usage.xsu_avail) / (1024 * 1024 * 1024);
-    }
-    
-    // 가상 메모리 사용량 = 물리 메모리 사용량 + 스왑 사용량
-    double virtual_used_gb = phys_used_gb + swap_used_gb;
-    
-    return virtual_used_gb;
-}
-
 /**
  * 시스템 가동 시간 정보 가져오기
  * @param days 일 수를 저장할 포인터
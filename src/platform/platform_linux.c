@@ -1,53 +1,227 @@
 #ifndef __APPLE__
 
 #include "platform.h"
+#include "proc_file.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/sysinfo.h>
 #include <unistd.h>
 
+// /proc/stat reader kept open between samples
+static proc_file_t stat_file = { .fd = -1 };
+
+/**
+ * Parse the activity lines of /proc/stat
+ *
+ * Starts after the cpu lines and stops at procs_blocked, before the long
+ * softirq line. The intr line is skipped with memchr: on large machines
+ * it alone carries thousands of counters.
+ *
+ * @param p Start of the line after the last cpu line
+ * @param end End of the file content
+ * @param activity Output counters
+ * @return 0 if every counter was found, -1 otherwise
+ */
+static int parse_cpu_activity(const char *p, const char *end, cpu_activity_t *activity) {
+    int found = 0;
+
+    while (p < end && found < 5) {
+        uint64_t *field = NULL;
+        size_t key = 0;
+
+        if (p[0] == 'c' && strncmp(p, "ctxt ", 5) == 0) {
+            field = &activity->ctxt;
+            key = 5;
+        } else if (p[0] == 'i' && strncmp(p, "intr ", 5) == 0) {
+            field = &activity->intr;
+            key = 5;
+        } else if (p[0] == 'p' && strncmp(p, "processes ", 10) == 0) {
+            field = &activity->processes;
+            key = 10;
+        } else if (p[0] == 'p' && strncmp(p, "procs_running ", 14) == 0) {
+            field = &activity->procs_running;
+            key = 14;
+        } else if (p[0] == 'p' && strncmp(p, "procs_blocked ", 14) == 0) {
+            field = &activity->procs_blocked;
+            key = 14;
+        }
+        if (field != NULL && proc_scan_u64(p + key, field) != NULL) {
+            found++;
+        }
+
+        const char *newline = memchr(p, '\n', (size_t)(end - p));
+        if (newline == NULL) {
+            break;
+        }
+        p = newline + 1;
+    }
+    return found == 5 ? 0 : -1;
+}
+
 /**
  * CPU statistics collection function
+ *
+ * Re-reads /proc/stat through a persistent descriptor and parses the
+ * aggregate "cpu" line with a hand-written scanner. Not reentrant: callers
+ * on different threads must serialize access.
+ *
  * @param cpu_usage Array to store CPU usage
  */
 void get_cpu_stats(unsigned long cpu_usage[7]) {
-    FILE *fp = fopen("/proc/stat", "r");
-    
-    if (!fp) {
+    if (stat_file.path == NULL) {
+        proc_file_open(&stat_file, "/proc/stat");
+    }
+
+    if (proc_file_read(&stat_file) < 0 || strncmp(stat_file.buf, "cpu ", 4) != 0) {
         memset(cpu_usage, 0, 7 * sizeof(unsigned long));
         return;
     }
+
+    const char *p = stat_file.buf + 4;
+    for (int i = 0; i < 7; i++) {
+        uint64_t value;
+        p = proc_scan_u64(p, &value);
+        if (p == NULL) {
+            memset(cpu_usage, 0, 7 * sizeof(unsigned long));
+            return;
+        }
+        cpu_usage[i] = (unsigned long)value;
+    }
+}
+
+/**
+ * Make room for at least the given number of cores
+ * @param counters Counter block
+ * @param needed Required slot count
+ * @return 0 on success, -1 on allocation failure
+ */
+static int cpu_counters_reserve(cpu_counters_t *counters, int needed) {
+    if (needed <= counters->capacity) {
+        return 0;
+    }
     
-    if (fscanf(fp, "cpu %lu %lu %lu %lu %lu %lu %lu", 
-              &cpu_usage[0], &cpu_usage[1], &cpu_usage[2], &cpu_usage[3], 
-              &cpu_usage[4], &cpu_usage[5], &cpu_usage[6]) != 7) {
-        memset(cpu_usage, 0, 7 * sizeof(unsigned long));
+    int capacity = counters->capacity > 0 ? counters->capacity : 16;
+    while (capacity < needed) {
+        capacity *= 2;
     }
     
-    fclose(fp);
+    int *ids = realloc(counters->core_id, capacity * sizeof(int));
+    if (ids == NULL) {
+        return -1;
+    }
+    counters->core_id = ids;
+    
+    for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+        uint64_t *field = realloc(counters->ticks[f], capacity * sizeof(uint64_t));
+        if (field == NULL) {
+            return -1;
+        }
+        counters->ticks[f] = field;
+    }
+    
+    counters->capacity = capacity;
+    return 0;
+}
+
+/**
+ * Parse the counter fields of one "cpu" line
+ * @param p Position after the cpu label
+ * @param values Output array (missing trailing fields are set to 0)
+ * @return Position after the parsed fields
+ */
+static const char *parse_cpu_fields(const char *p, uint64_t values[CPU_STAT_FIELDS]) {
+    for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+        const char *next = proc_scan_u64(p, &values[f]);
+        if (next == NULL) {
+            // Older kernels report fewer columns
+            for (; f < CPU_STAT_FIELDS; f++) {
+                values[f] = 0;
+            }
+            break;
+        }
+        p = next;
+    }
+    return p;
 }
 
 /**
- * Memory usage calculation function
- * @return Virtual memory usage (GB)
+ * Per-core CPU counter collection function
+ * @param counters Counter block (zero-initialized before first use)
+ * @return Number of cores read, or -1 on failure
  */
-double calculate_memory_usage(void) {
-    struct sysinfo sys_info;
+int get_cpu_core_stats(cpu_counters_t *counters) {
+    proc_file_t *reader = counters->source;
+    
+    if (reader == NULL) {
+        reader = calloc(1, sizeof(proc_file_t));
+        if (reader == NULL) {
+            return -1;
+        }
+        proc_file_open(reader, "/proc/stat");
+        counters->source = reader;
+    }
     
-    if (sysinfo(&sys_info) != 0) {
-        return 0.0;
+    if (proc_file_read(reader) < 0) {
+        counters->count = 0;
+        counters->has_activity = 0;
+        return -1;
     }
     
-    double phys_total_gb = (double)sys_info.totalram / (1024 * 1024 * 1024); 
-    double phys_free_gb = (double)sys_info.freeram / (1024 * 1024 * 1024);
-    double phys_used_gb = phys_total_gb - phys_free_gb;
-    double swap_total_gb = (double)sys_info.totalswap / (1024 * 1024 * 1024);
-    double swap_free_gb = (double)sys_info.freeswap / (1024 * 1024 * 1024);
+    int count = 0;
+    const char *p = reader->buf;
     
-    double virtual_used_gb = phys_used_gb + (swap_total_gb - swap_free_gb);
+    // All cpu lines come first; stop at the first line that is not one
+    while (p[0] == 'c' && p[1] == 'p' && p[2] == 'u') {
+        p += 3;
+        
+        if (*p == ' ') {
+            p = parse_cpu_fields(p, counters->total);
+        } else {
+            uint64_t id;
+            p = proc_scan_u64(p, &id);
+            if (p == NULL || cpu_counters_reserve(counters, count + 1) != 0) {
+                break;
+            }
+            
+            uint64_t values[CPU_STAT_FIELDS];
+            p = parse_cpu_fields(p, values);
+            
+            counters->core_id[count] = (int)id;
+            for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+                counters->ticks[f][count] = values[f];
+            }
+            count++;
+        }
+        
+        p = proc_next_line(p);
+    }
+    
+    counters->count = count;
+    
+    // Activity lines follow the cpu lines in the same buffer
+    memset(&counters->activity, 0, sizeof(counters->activity));
+    counters->has_activity = p != NULL &&
+        parse_cpu_activity(p, reader->buf + reader->len, &counters->activity) == 0;
+    return count;
+}
+
+/**
+ * Per-core CPU counter release function
+ * @param counters Counter block to release
+ */
+void cpu_counters_free(cpu_counters_t *counters) {
+    if (counters->source != NULL) {
+        proc_file_close(counters->source);
+        free(counters->source);
+    }
+    
+    free(counters->core_id);
+    for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+        free(counters->ticks[f]);
+    }
     
-    return virtual_used_gb;
+    memset(counters, 0, sizeof(*counters));
 }
 
 /**
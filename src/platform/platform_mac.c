@@ -1,5 +1,6 @@
 #include "platform.h"
 #include "common.h"
+#include "../utils/trace.h"
 
 #ifdef __APPLE__
 #include <mach/mach.h>
@@ -12,6 +13,7 @@
 #include <time.h>
 #include <unistd.h>
 #include <string.h>
+#include <stdlib.h>
 
 // Store previous CPU data for delta calculation
 static host_cpu_load_info_data_t prev_cpu_load;
@@ -154,7 +156,7 @@ void get_cpu_stats(unsigned long cpu_usage[7]) {
         cpu_usage[5] = 0;  // IRQ (not available on macOS)
         cpu_usage[6] = 0;  // SOFTIRQ (not available on macOS)
         
-        printf("First CPU reading - initialized baseline values\n");
+        TRACE_INFO("First CPU reading - initialized baseline values");
         return;
     }
     
@@ -169,7 +171,7 @@ void get_cpu_stats(unsigned long cpu_usage[7]) {
     
     // If no time has passed between calls, use the current values directly
     if (total_diff == 0) {
-        printf("Warning: No CPU time difference detected\n");
+        TRACE_INFO("No CPU time difference detected");
         // Set some reasonable values to avoid division by zero
         total_diff = 100;
         idle_diff = 95; // Assume 5% usage when no difference
@@ -187,15 +189,114 @@ void get_cpu_stats(unsigned long cpu_usage[7]) {
     cpu_usage[5] = 0;            // IRQ (not available on macOS)
     cpu_usage[6] = 0;            // SOFTIRQ (not available on macOS)
     
-    // Print debug information
-    double user_pct = (double)user_diff * 100.0 / total_diff;
-    double system_pct = (double)system_diff * 100.0 / total_diff;
-    double idle_pct = (double)idle_diff * 100.0 / total_diff;
+    TRACE_DEBUG("CPU Usage - User: %.1f%%, System: %.1f%%, Idle: %.1f%%",
+                (double)user_diff * 100.0 / total_diff,
+                (double)system_diff * 100.0 / total_diff,
+                (double)idle_diff * 100.0 / total_diff);
+    TRACE_DEBUG("Raw values - User: %lu, System: %lu, Idle: %lu, Total: %lu",
+                user_diff, system_diff, idle_diff, total_diff);
+}
+
+/**
+ * Make room for at least the given number of cores
+ * 
+ * @param counters Counter block
+ * @param needed Required slot count
+ * @return 0 on success, -1 on allocation failure
+ */
+static int cpu_counters_reserve(cpu_counters_t *counters, int needed) {
+    if (needed <= counters->capacity) {
+        return 0;
+    }
+    
+    int *ids = realloc(counters->core_id, needed * sizeof(int));
+    if (ids == NULL) {
+        return -1;
+    }
+    counters->core_id = ids;
+    
+    for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+        uint64_t *field = realloc(counters->ticks[f], needed * sizeof(uint64_t));
+        if (field == NULL) {
+            return -1;
+        }
+        counters->ticks[f] = field;
+    }
+    
+    counters->capacity = needed;
+    return 0;
+}
+
+/**
+ * Per-core CPU counter collection function
+ * 
+ * Reads per-processor tick counters from the Mach host. Only user, nice,
+ * system and idle are available on macOS; the other fields are reported as 0.
+ * There is no equivalent of the context switch, interrupt and run-queue
+ * counters, so the activity is never available.
+ * 
+ * @param counters Counter block (zero-initialized before first use)
+ * @return Number of cores read, or -1 on failure
+ */
+int get_cpu_core_stats(cpu_counters_t *counters) {
+    natural_t processor_count = 0;
+    processor_info_array_t info = NULL;
+    mach_msg_type_number_t info_count = 0;
+    
+    memset(&counters->activity, 0, sizeof(counters->activity));
+    counters->has_activity = 0;
+    
+    kern_return_t ret = host_processor_info(mach_host_self(), PROCESSOR_CPU_LOAD_INFO,
+                                            &processor_count, &info, &info_count);
+    if (ret != KERN_SUCCESS) {
+        counters->count = 0;
+        return -1;
+    }
+    
+    if (cpu_counters_reserve(counters, (int)processor_count) != 0) {
+        vm_deallocate(mach_task_self(), (vm_address_t)info, info_count * sizeof(integer_t));
+        counters->count = 0;
+        return -1;
+    }
     
-    printf("CPU Usage - User: %.1f%%, System: %.1f%%, Idle: %.1f%%\n", 
-           user_pct, system_pct, idle_pct);
-    printf("Raw values - User: %lu, System: %lu, Idle: %lu, Total: %lu\n",
-           user_diff, system_diff, idle_diff, total_diff);
+    processor_cpu_load_info_t loads = (processor_cpu_load_info_t)info;
+    memset(counters->total, 0, sizeof(counters->total));
+    
+    for (natural_t i = 0; i < processor_count; i++) {
+        counters->core_id[i] = (int)i;
+        for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+            counters->ticks[f][i] = 0;
+        }
+        
+        counters->ticks[CPU_FIELD_USER][i] = loads[i].cpu_ticks[CPU_STATE_USER];
+        counters->ticks[CPU_FIELD_NICE][i] = loads[i].cpu_ticks[CPU_STATE_NICE];
+        counters->ticks[CPU_FIELD_SYSTEM][i] = loads[i].cpu_ticks[CPU_STATE_SYSTEM];
+        counters->ticks[CPU_FIELD_IDLE][i] = loads[i].cpu_ticks[CPU_STATE_IDLE];
+        
+        counters->total[CPU_FIELD_USER] += counters->ticks[CPU_FIELD_USER][i];
+        counters->total[CPU_FIELD_NICE] += counters->ticks[CPU_FIELD_NICE][i];
+        counters->total[CPU_FIELD_SYSTEM] += counters->ticks[CPU_FIELD_SYSTEM][i];
+        counters->total[CPU_FIELD_IDLE] += counters->ticks[CPU_FIELD_IDLE][i];
+    }
+    
+    vm_deallocate(mach_task_self(), (vm_address_t)info, info_count * sizeof(integer_t));
+    
+    counters->count = (int)processor_count;
+    return counters->count;
+}
+
+/**
+ * Per-core CPU counter release function
+ * 
+ * @param counters Counter block to release
+ */
+void cpu_counters_free(cpu_counters_t *counters) {
+    free(counters->core_id);
+    for (int f = 0; f < CPU_STAT_FIELDS; f++) {
+        free(counters->ticks[f]);
+    }
+    
+    memset(counters, 0, sizeof(*counters));
 }
 
 /**
@@ -234,46 +335,6 @@ void get_system_uptime(int *days, int *hours, int *minutes, int *seconds) {
     *seconds = uptime % 60;
 }
 
-/**
- * Current memory usage calculation function
- * 
- * Calculates the current memory usage on macOS in GB.
- * 
- * @return Memory usage in GB
- */
-double calculate_memory_usage(void) {
-    // Get VM statistics
-    vm_statistics64_data_t vm_stats;
-    mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
-    kern_return_t ret;
-    
-    ret = host_statistics64(mach_host_self(), HOST_VM_INFO64, 
-                          (host_info64_t)&vm_stats, &count);
-    if (ret != KERN_SUCCESS) {
-        fprintf(stderr, "Error: %s\n", mach_error_string(ret));
-        return 0.0;
-    }
-    
-    // Get page size
-    int mib[2] = { CTL_HW, HW_PAGESIZE };
-    int64_t pagesize;
-    size_t len = sizeof(pagesize);
-    
-    if (sysctl(mib, 2, &pagesize, &len, NULL, 0) < 0) {
-        perror("sysctl pagesize failed");
-        return 0.0;
-    }
-    
-    // Calculate used memory (Active + Wired)
-    uint64_t used_memory = (vm_stats.active_count + 
-                          vm_stats.wire_count) * pagesize;
-    
-    // Convert to GB
-    double used_memory_gb = (double)used_memory / (1024 * 1024 * 1024);
-    
-    return used_memory_gb;
-}
-
 /**
  * Total memory capacity calculation function
  * 
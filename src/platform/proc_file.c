@@ -0,0 +1,106 @@
+#ifndef __APPLE__
+
+#include "proc_file.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Initial buffer size; /proc/stat on small hosts fits in one page
+#define PROC_FILE_INITIAL_SIZE 4096
+
+/**
+ * Open a procfs file for repeated reading
+ * @param pf Reader to initialize
+ * @param path File path
+ * @return 0 on success, -1 on failure
+ */
+int proc_file_open(proc_file_t *pf, const char *path) {
+    pf->path = path;
+    pf->buf = NULL;
+    pf->cap = 0;
+    pf->len = 0;
+    pf->fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    return pf->fd < 0 ? -1 : 0;
+}
+
+/**
+ * Read the file into the buffer, growing it until the content fits
+ * @param pf Open reader
+ * @return Number of bytes read, or -1 on failure
+ */
+static ssize_t read_whole(proc_file_t *pf) {
+    for (;;) {
+        if (pf->cap == 0) {
+            pf->buf = malloc(PROC_FILE_INITIAL_SIZE);
+            if (pf->buf == NULL) {
+                return -1;
+            }
+            pf->cap = PROC_FILE_INITIAL_SIZE;
+        }
+
+        ssize_t n = pread(pf->fd, pf->buf, pf->cap - 1, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        // procfs returns the whole file in one read when it fits;
+        // a full buffer means the content may have been truncated
+        if ((size_t)n < pf->cap - 1) {
+            pf->buf[n] = '\0';
+            pf->len = (size_t)n;
+            return n;
+        }
+
+        char *grown = realloc(pf->buf, pf->cap * 2);
+        if (grown == NULL) {
+            return -1;
+        }
+        pf->buf = grown;
+        pf->cap *= 2;
+    }
+}
+
+/**
+ * Re-read the whole file from offset 0
+ * @param pf Open reader
+ * @return Number of bytes read, or -1 on failure
+ */
+ssize_t proc_file_read(proc_file_t *pf) {
+    if (pf->fd >= 0) {
+        ssize_t n = read_whole(pf);
+        if (n >= 0) {
+            return n;
+        }
+        close(pf->fd);
+    }
+
+    // Descriptor was closed or went stale: reopen once and retry
+    pf->fd = open(pf->path, O_RDONLY | O_CLOEXEC);
+    if (pf->fd < 0) {
+        return -1;
+    }
+    return read_whole(pf);
+}
+
+/**
+ * Close the descriptor and release the buffer
+ * @param pf Reader to close
+ */
+void proc_file_close(proc_file_t *pf) {
+    if (pf->fd >= 0) {
+        close(pf->fd);
+        pf->fd = -1;
+    }
+    free(pf->buf);
+    pf->buf = NULL;
+    pf->cap = 0;
+    pf->len = 0;
+}
+
+#endif // !__APPLE__
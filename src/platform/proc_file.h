@@ -0,0 +1,100 @@
+#ifndef PROC_FILE_H
+#define PROC_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/**
+ * Persistent procfs file reader
+ *
+ * Keeps a /proc file descriptor open across samples and re-reads it with
+ * pread() at offset 0 into a reusable buffer, so sampling does not pay for
+ * fopen/fclose, stdio buffering or any allocation after the first read.
+ * The buffer is always NUL-terminated after a successful read.
+ */
+typedef struct {
+    const char *path;   // Path the descriptor was opened from
+    int fd;             // Open descriptor (-1 when closed)
+    char *buf;          // Reusable read buffer
+    size_t cap;         // Buffer capacity in bytes
+    size_t len;         // Length of the last read
+} proc_file_t;
+
+/**
+ * Open a procfs file for repeated reading
+ *
+ * @param pf Reader to initialize
+ * @param path File path (must stay valid while the reader is open)
+ * @return 0 on success, -1 on failure
+ */
+int proc_file_open(proc_file_t *pf, const char *path);
+
+/**
+ * Re-read the whole file from offset 0
+ *
+ * Grows the buffer when the file no longer fits, then keeps it for later
+ * reads. Reopens the descriptor once if the read fails.
+ *
+ * @param pf Open reader
+ * @return Number of bytes read, or -1 on failure
+ */
+ssize_t proc_file_read(proc_file_t *pf);
+
+/**
+ * Close the descriptor and release the buffer
+ *
+ * @param pf Reader to close
+ */
+void proc_file_close(proc_file_t *pf);
+
+/**
+ * Skip blanks (spaces and tabs) without crossing a line break
+ */
+static inline const char *proc_skip_blanks(const char *p) {
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * Parse an unsigned decimal integer
+ *
+ * Leading blanks are skipped. Used instead of scanf so that no format
+ * string has to be interpreted on every sample.
+ *
+ * @param p Current position
+ * @param out Parsed value
+ * @return Position after the last digit, or NULL if no digit was found
+ */
+static inline const char *proc_scan_u64(const char *p, uint64_t *out) {
+    uint64_t value = 0;
+
+    p = proc_skip_blanks(p);
+    if (*p < '0' || *p > '9') {
+        return NULL;
+    }
+
+    while (*p >= '0' && *p <= '9') {
+        value = value * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+
+    *out = value;
+    return p;
+}
+
+/**
+ * Advance to the first character of the next line
+ *
+ * @return Start of the next line, or the terminating NUL
+ */
+static inline const char *proc_next_line(const char *p) {
+    while (*p != '\0' && *p != '\n') {
+        p++;
+    }
+    return *p == '\n' ? p + 1 : p;
+}
+
+#endif // PROC_FILE_H
@@ -0,0 +1,143 @@
+#ifndef __APPLE__
+
+#include "proc_scan.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * Open /proc for scanning
+ * @param scan Scanner to initialize
+ * @return 0 on success, -1 on failure
+ */
+int proc_scan_open(proc_scan_t *scan) {
+    scan->len = 0;
+    scan->buf[0] = '\0';
+    scan->dir = opendir("/proc");
+    if (scan->dir == NULL) {
+        scan->dir_fd = -1;
+        return -1;
+    }
+    scan->dir_fd = dirfd(scan->dir);
+    return 0;
+}
+
+/**
+ * Start a new pass over the process directories
+ * @param scan Open scanner
+ */
+void proc_scan_rewind(proc_scan_t *scan) {
+    rewinddir(scan->dir);
+}
+
+/**
+ * Next process of the current pass
+ * @param scan Open scanner
+ * @return Process id, or 0 at the end of the pass
+ */
+int proc_scan_next(proc_scan_t *scan) {
+    struct dirent *entry;
+
+    while ((entry = readdir(scan->dir)) != NULL) {
+        const char *name = entry->d_name;
+        if (*name < '1' || *name > '9') {
+            continue;
+        }
+
+        int pid = 0;
+        while (*name >= '0' && *name <= '9') {
+            pid = pid * 10 + (*name++ - '0');
+        }
+        if (*name == '\0') {
+            return pid;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Open /proc/<pid>/<name> relative to the cached /proc descriptor
+ * @param scan Open scanner
+ * @param pid Process id
+ * @param name File name inside the process directory
+ * @return Descriptor, or -1 if the process is gone
+ */
+int proc_scan_open_file(proc_scan_t *scan, int pid, const char *name) {
+    char path[64];
+    char digits[12];
+    int ndigits = 0;
+    size_t len = 0;
+
+    // "<pid>/<name>" without going through printf for every process
+    do {
+        digits[ndigits++] = (char)('0' + pid % 10);
+        pid /= 10;
+    } while (pid > 0);
+    while (ndigits > 0) {
+        path[len++] = digits[--ndigits];
+    }
+    path[len++] = '/';
+    size_t name_len = strlen(name);
+    if (len + name_len >= sizeof(path)) {
+        return -1;
+    }
+    memcpy(path + len, name, name_len + 1);
+
+    return openat(scan->dir_fd, path, O_RDONLY | O_CLOEXEC);
+}
+
+/**
+ * Re-read an open per-process file from offset 0 into the scanner buffer
+ * @param scan Open scanner
+ * @param fd Descriptor from proc_scan_open_file
+ * @return Bytes read, or -1 if the process is gone or the read failed
+ */
+ssize_t proc_scan_pread(proc_scan_t *scan, int fd) {
+    ssize_t n;
+
+    do {
+        n = pread(fd, scan->buf, sizeof(scan->buf) - 1, 0);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        scan->len = 0;
+        scan->buf[0] = '\0';
+        return -1;
+    }
+    scan->buf[n] = '\0';
+    scan->len = (size_t)n;
+    return n;
+}
+
+/**
+ * Read /proc/<pid>/<name> into the scanner buffer
+ * @param scan Open scanner
+ * @param pid Process id
+ * @param name File name inside the process directory
+ * @return Bytes read, or -1 if the process is gone or the read failed
+ */
+ssize_t proc_scan_read(proc_scan_t *scan, int pid, const char *name) {
+    int fd = proc_scan_open_file(scan, pid, name);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ssize_t n = proc_scan_pread(scan, fd);
+    close(fd);
+    return n;
+}
+
+/**
+ * Close /proc
+ * @param scan Scanner to close
+ */
+void proc_scan_close(proc_scan_t *scan) {
+    if (scan->dir != NULL) {
+        closedir(scan->dir);
+        scan->dir = NULL;
+        scan->dir_fd = -1;
+    }
+}
+
+#endif // !__APPLE__
@@ -0,0 +1,92 @@
+#ifndef PROC_SCAN_H
+#define PROC_SCAN_H
+
+#include <dirent.h>
+#include <sys/types.h>
+
+// Per-process file read buffer; /proc/[pid]/stat is well under 1 KiB
+#define PROC_SCAN_BUFFER_SIZE 4096
+
+/**
+ * /proc process directory scanner
+ *
+ * Keeps /proc open across scans: each scan rewinds the same directory
+ * stream instead of reopening it, and per-process files are opened with
+ * openat() relative to its descriptor, so the kernel only resolves
+ * "<pid>/<file>" and never the /proc prefix. Files are read into one
+ * reusable buffer; nothing is allocated per process.
+ */
+typedef struct {
+    DIR *dir;                           // /proc directory stream
+    int dir_fd;                         // Its descriptor, for openat()
+    char buf[PROC_SCAN_BUFFER_SIZE];    // Last file read, NUL-terminated
+    size_t len;                         // Length of the last read
+} proc_scan_t;
+
+/**
+ * Open /proc for scanning
+ *
+ * @param scan Scanner to initialize
+ * @return 0 on success, -1 on failure
+ */
+int proc_scan_open(proc_scan_t *scan);
+
+/**
+ * Start a new pass over the process directories
+ *
+ * @param scan Open scanner
+ */
+void proc_scan_rewind(proc_scan_t *scan);
+
+/**
+ * Next process of the current pass
+ *
+ * Entries that are not process directories are skipped.
+ *
+ * @param scan Open scanner
+ * @return Process id, or 0 at the end of the pass
+ */
+int proc_scan_next(proc_scan_t *scan);
+
+/**
+ * Open /proc/<pid>/<name> relative to the cached /proc descriptor
+ *
+ * A descriptor kept open stays bound to that process: once it has been
+ * reaped, reads fail with ESRCH even if the pid is reused.
+ *
+ * @param scan Open scanner
+ * @param pid Process id
+ * @param name File name inside the process directory ("stat", ...)
+ * @return Descriptor, or -1 if the process is gone
+ */
+int proc_scan_open_file(proc_scan_t *scan, int pid, const char *name);
+
+/**
+ * Re-read an open per-process file from offset 0 into the scanner buffer
+ *
+ * @param scan Open scanner
+ * @param fd Descriptor from proc_scan_open_file
+ * @return Bytes read, or -1 if the process is gone or the read failed
+ */
+ssize_t proc_scan_pread(proc_scan_t *scan, int fd);
+
+/**
+ * Read /proc/<pid>/<name> into the scanner buffer
+ *
+ * Content that does not fit is truncated.
+ *
+ * @param scan Open scanner
+ * @param pid Process id
+ * @param name File name inside the process directory ("stat", ...)
+ * @return Bytes read, or -1 if the process is gone or the read failed
+ */
+ssize_t proc_scan_read(proc_scan_t *scan, int pid, const char *name);
+
+/**
+ * Close /proc
+ *
+ * @param scan Scanner to close
+ */
+void proc_scan_close(proc_scan_t *scan);
+
+#endif // PROC_SCAN_H
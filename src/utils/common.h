@@ -36,7 +36,7 @@
 #define MAX_CPU_BUFFER 1024     // Maximum CPU buffer size
 #define MAX_USER_BUFFER 4096    // Maximum user buffer size
 #define DEFAULT_SAMPLES 10      // Default number of samples
-#define DEFAULT_DELAY 1         // Default delay in seconds
+#define DEFAULT_DELAY_MS 1000   // Default delay in milliseconds
 
 /**
  * Program options structure
@@ -44,35 +44,22 @@
  */
 typedef struct {
     int samples;     // Number of samples
-    int tdelay;      // Delay in seconds
+    int tdelay_ms;   // Delay in milliseconds
     int user;        // Whether to display user information
     int system;      // Whether to display system information
     int sequential;  // Whether to use sequential mode
     int graphics;    // Whether to display graphics
+    int cores;       // Whether to display per-core CPU usage
+    int processes;   // Whether to display the busiest processes
+    int pressure;    // Whether to display pressure stall information
+    int pressure_stall_ms;  // Pressure trigger threshold (0: no triggers)
+    int disks;       // Whether to display block device I/O
+    int network;     // Whether to display network interface traffic
+    int cgroup;      // Whether to display cgroup accounting
+    const char *cgroup_path;  // Cgroup to report on (NULL: own cgroup)
+    int cgroup_tree; // Whether to display the cgroup hierarchy
 } ProgramOptions;
 
-/**
- * Pipe structure
- * Manages pipes used for inter-process communication.
- */
-typedef struct {
-    int cpuPFD[2];   // CPU previous state pipe
-    int cpuCFD[2];   // CPU current state pipe
-    int userFD[2];   // User information pipe
-    int memFD[2];    // Memory information pipe
-    int ucountFD[2]; // User count pipe
-} PipeSet;
-
-/**
- * Process ID structure
- * Stores PIDs for each child process.
- */
-typedef struct {
-    pid_t memPID;    // Memory information collection process ID
-    pid_t userPID;   // User information collection process ID
-    pid_t cpuPID;    // CPU information collection process ID
-} ProcessIDs;
-
 /**
  * CPU usage data structure
  * Stores data needed for CPU usage calculation.
@@ -108,17 +95,11 @@ enum StatusCode {
 
 // External global variable declaration
 extern volatile sig_atomic_t exit_flag;  // Exit flag
+extern volatile sig_atomic_t redraw_flag;  // Set when the terminal was written outside the screen buffer
 
 // Function declarations
 void setupSignalHandlers(void);  // Signal handler setup function
 ProgramOptions parseCommandLineOptions(int argc, char *argv[]);  // Command line options parsing function
-void printTopInfo(int samples, int tdelay, int sequential, int count);  // Top information output function
-void reserveSpace(int samples);  // Output space reservation function
-double getVirtualMemoryUsage(void);  // Virtual memory usage calculation function
-void createMemoryGraphics(double virtual_used_gb, double *prev_used_gb, char memArr[][MAX_MEMORY_BUFFER], int idx);  // Memory graphics creation function
-void printMemoryInfo(int sequential, int samples, char memArr[][MAX_MEMORY_BUFFER], int idx, int *memFD);  // Memory information output function
-void printUserInfo(int *userFD);  // User information output function
-void printCPUCores(void);  // CPU core information output function
-void setCPUGraphics(int sequential, char cpuArr[][MAX_CPU_BUFFER], float cur_cpuUsage, float *prevCpuUsageFloat, int i);  // CPU graphics setting function
+int createMemoryGraphics(double virtual_used_gb, double *prev_used_gb, char memArr[][MAX_MEMORY_BUFFER], int idx);  // Memory graphics creation function
 
 #endif // COMMON_H 
\ No newline at end of file
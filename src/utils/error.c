@@ -1,10 +1,61 @@
 #include "error.h"
 #include <time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+
+// Log queue geometry
+#define LOG_QUEUE_CAPACITY 512      // Records (power of two)
+#define LOG_MESSAGE_SIZE   480      // Formatted message bytes per record
+#define LOG_ENTRY_SIZE     1024     // Longest formatted log line
+#define LOG_BATCH_SIZE     (64 * 1024)
 
 // Global variables
 int g_verbose_mode = 0;  // Default: not verbose
 FILE* g_log_file = NULL; // Default: no log file
 
+/**
+ * One queued log record
+ * The message is formatted by the caller; the timestamp is only turned
+ * into text by the writer. file and func point at string literals.
+ */
+typedef struct {
+    _Atomic uint64_t sequence;  // Slot ownership (bounded MPMC queue protocol)
+    struct timespec time;
+    ErrorLevel level;
+    ErrorCode code;
+    const char* file;
+    const char* func;
+    int line;
+    char message[LOG_MESSAGE_SIZE];
+} LogRecord;
+
+// Bounded lock-free queue: producers claim slots with a CAS on the enqueue
+// position, the writer thread is the only consumer
+static LogRecord log_queue[LOG_QUEUE_CAPACITY];
+static _Atomic uint64_t log_enqueue_pos;
+static _Atomic uint64_t log_dequeue_pos;
+static _Atomic unsigned long log_dropped;
+
+// Writer thread state
+static pthread_t log_writer;
+static atomic_int log_writer_running;   // Producers queue records while set
+static atomic_int log_writer_stopping;
+static atomic_int log_writer_idle;      // Writer is (about to be) asleep in poll
+static atomic_int log_urgent;           // An urgent record is waiting
+static atomic_int log_wakeup_sent;      // A wakeup byte is already in the pipe
+static int log_wake_pipe[2] = { -1, -1 };
+
+// Flush policy
+static atomic_int log_batch_records = LOG_DEFAULT_BATCH_RECORDS;
+static atomic_int log_max_delay_ms = LOG_DEFAULT_MAX_DELAY_MS;
+static atomic_int log_urgent_level = ERROR_WARNING;
+
 // Error level strings for display
 static const char* error_level_strings[] = {
     "DEBUG",
@@ -29,10 +80,230 @@ static const char* error_code_strings[] = {
     "UNKNOWN"
 };
 
+/**
+ * Format one log line
+ */
+static int format_entry(char* out, size_t size, const char* time_str, ErrorLevel level,
+                        ErrorCode code, const char* file, int line, const char* func,
+                        const char* message) {
+    int len = snprintf(out, size,
+                       "[%s] %s [%s] [%s:%d:%s] %s\n",
+                       time_str,
+                       error_level_strings[level],
+                       error_code_strings[code],
+                       file, line, func,
+                       message);
+    if (len < 0) {
+        return 0;
+    }
+    if ((size_t)len >= size) {
+        // Truncated: keep the line terminated
+        len = (int)size - 1;
+        out[len - 1] = '\n';
+    }
+    return len;
+}
+
+/**
+ * Print a log line to the console based on its level
+ */
+static void print_console(ErrorLevel level, const char* entry) {
+    if (level >= ERROR_WARNING) {
+        fputs(entry, stderr);
+    } else if (g_verbose_mode) {
+        fputs(entry, stdout);
+    }
+}
+
+/**
+ * Wake the writer thread if it is asleep
+ */
+static void wake_writer(void) {
+    if (!atomic_exchange(&log_wakeup_sent, 1)) {
+        char byte = 1;
+        ssize_t ignored = write(log_wake_pipe[1], &byte, 1);
+        (void)ignored;
+    }
+}
+
+/**
+ * Take the oldest record off the queue if it has been published
+ * Writer thread only.
+ */
+static LogRecord* peek_record(void) {
+    uint64_t pos = atomic_load_explicit(&log_dequeue_pos, memory_order_relaxed);
+    LogRecord* record = &log_queue[pos & (LOG_QUEUE_CAPACITY - 1)];
+    if (atomic_load_explicit(&record->sequence, memory_order_acquire) != pos + 1) {
+        return NULL;
+    }
+    return record;
+}
+
+/**
+ * Hand a consumed record's slot back to the producers
+ */
+static void release_record(LogRecord* record) {
+    uint64_t pos = atomic_load_explicit(&log_dequeue_pos, memory_order_relaxed);
+    atomic_store_explicit(&record->sequence, pos + LOG_QUEUE_CAPACITY, memory_order_release);
+    atomic_store_explicit(&log_dequeue_pos, pos + 1, memory_order_release);
+}
+
+/**
+ * Write every published record as one batch
+ * Writer thread only.
+ */
+static void drain_queue(void) {
+    static char batch[LOG_BATCH_SIZE];
+    static unsigned long reported_drops = 0;
+    static time_t cached_second = (time_t)-1;
+    static char time_str[32];
+    size_t used = 0;
+    LogRecord* record;
+
+    while ((record = peek_record()) != NULL) {
+        // localtime_r/strftime once per second instead of once per record
+        if (record->time.tv_sec != cached_second) {
+            struct tm tm_now;
+            cached_second = record->time.tv_sec;
+            localtime_r(&cached_second, &tm_now);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &tm_now);
+        }
+
+        if (used + LOG_ENTRY_SIZE > sizeof(batch)) {
+            if (g_log_file != NULL) {
+                fwrite(batch, 1, used, g_log_file);
+            }
+            used = 0;
+        }
+        char* entry = batch + used;
+        int len = format_entry(entry, LOG_ENTRY_SIZE, time_str, record->level, record->code,
+                               record->file, record->line, record->func, record->message);
+        ErrorLevel level = record->level;
+        release_record(record);
+
+        print_console(level, entry);
+        used += len;
+    }
+
+    unsigned long dropped = atomic_load_explicit(&log_dropped, memory_order_relaxed);
+    if (dropped != reported_drops) {
+        int len = snprintf(batch + used, sizeof(batch) - used,
+                           "[%s] WARNING [IO] %lu log records dropped (queue full)\n",
+                           time_str, dropped - reported_drops);
+        if (len > 0 && (size_t)len < sizeof(batch) - used) {
+            used += len;
+        }
+        reported_drops = dropped;
+    }
+
+    if (used > 0 && g_log_file != NULL) {
+        fwrite(batch, 1, used, g_log_file);
+        fflush(g_log_file);
+    }
+}
+
+/**
+ * Log writer thread: sleeps until the flush policy asks for a batch
+ */
+static void* log_writer_thread(void* arg) {
+    (void)arg;
+    struct pollfd wake = { .fd = log_wake_pipe[0], .events = POLLIN };
+
+    for (;;) {
+        drain_queue();
+
+        uint64_t pending = atomic_load(&log_enqueue_pos) - atomic_load(&log_dequeue_pos);
+        if (atomic_load(&log_writer_stopping)) {
+            if (pending == 0) {
+                break;
+            }
+            // A producer claimed a slot but has not published it yet
+            sched_yield();
+            continue;
+        }
+
+        // Announce the sleep first, then re-check, so a producer that queued
+        // in between either sees the flag or is seen here
+        atomic_store(&log_writer_idle, 1);
+        pending = atomic_load(&log_enqueue_pos) - atomic_load(&log_dequeue_pos);
+        if (!atomic_load(&log_urgent) && !atomic_load(&log_writer_stopping) &&
+            pending < (uint64_t)atomic_load_explicit(&log_batch_records, memory_order_relaxed)) {
+            poll(&wake, 1, atomic_load_explicit(&log_max_delay_ms, memory_order_relaxed));
+        }
+        atomic_store(&log_writer_idle, 0);
+
+        char bytes[64];
+        while (read(log_wake_pipe[0], bytes, sizeof(bytes)) > 0) {
+        }
+        atomic_store(&log_wakeup_sent, 0);
+        atomic_store(&log_urgent, 0);
+    }
+    return NULL;
+}
+
+/**
+ * Start the log writer thread
+ * On failure logging stays synchronous.
+ */
+static void start_writer(void) {
+    if (atomic_load(&log_writer_running)) {
+        return;
+    }
+    if (pipe(log_wake_pipe) == -1) {
+        return;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(log_wake_pipe[i], F_SETFL, fcntl(log_wake_pipe[i], F_GETFL) | O_NONBLOCK);
+        fcntl(log_wake_pipe[i], F_SETFD, FD_CLOEXEC);
+    }
+
+    for (uint64_t i = 0; i < LOG_QUEUE_CAPACITY; i++) {
+        atomic_store_explicit(&log_queue[i].sequence, i, memory_order_relaxed);
+    }
+    atomic_store(&log_enqueue_pos, 0);
+    atomic_store(&log_dequeue_pos, 0);
+    atomic_store(&log_writer_stopping, 0);
+
+    // Terminal signals stay with the main thread
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTSTP);
+    sigaddset(&blocked, SIGCONT);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+    int created = pthread_create(&log_writer, NULL, log_writer_thread, NULL) == 0;
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (!created) {
+        close(log_wake_pipe[0]);
+        close(log_wake_pipe[1]);
+        log_wake_pipe[0] = log_wake_pipe[1] = -1;
+        return;
+    }
+    atomic_store(&log_writer_running, 1);
+}
+
+/**
+ * Drain the queue and stop the log writer thread
+ */
+static void stop_writer(void) {
+    if (!atomic_exchange(&log_writer_running, 0)) {
+        return;
+    }
+    atomic_store(&log_writer_stopping, 1);
+    wake_writer();
+    pthread_join(log_writer, NULL);
+
+    close(log_wake_pipe[0]);
+    close(log_wake_pipe[1]);
+    log_wake_pipe[0] = log_wake_pipe[1] = -1;
+}
+
 /**
  * Initialize the error handling system
  */
 int error_init(const char* log_filename, int verbose) {
+    static int cleanup_registered = 0;
     g_verbose_mode = verbose;
     
     if (log_filename != NULL) {
@@ -54,6 +325,15 @@ int error_init(const char* log_filename, int verbose) {
                 time_str);
     }
     
+    start_writer();
+
+    // Records still queued when the program exits without error_cleanup
+    // (e.g. from a signal handler) are written on the way out
+    if (!cleanup_registered) {
+        atexit(error_cleanup);
+        cleanup_registered = 1;
+    }
+    
     return 0;
 }
 
@@ -61,6 +341,8 @@ int error_init(const char* log_filename, int verbose) {
  * Clean up the error handling system
  */
 void error_cleanup(void) {
+    stop_writer();
+
     if (g_log_file != NULL) {
         time_t now = time(NULL);
         char time_str[32];
@@ -77,6 +359,77 @@ void error_cleanup(void) {
     }
 }
 
+/**
+ * Change the flush policy of the log writer
+ */
+void error_set_flush_policy(const LogFlushPolicy *policy) {
+    if (policy->batch_records > 0) {
+        int batch = policy->batch_records < LOG_QUEUE_CAPACITY ?
+                    policy->batch_records : LOG_QUEUE_CAPACITY;
+        atomic_store(&log_batch_records, batch);
+    }
+    if (policy->max_delay_ms > 0) {
+        atomic_store(&log_max_delay_ms, policy->max_delay_ms);
+    }
+    if (policy->urgent_level >= ERROR_DEBUG && policy->urgent_level <= ERROR_FATAL) {
+        atomic_store(&log_urgent_level, policy->urgent_level);
+    }
+}
+
+/**
+ * Number of records dropped because the log queue was full
+ */
+unsigned long error_dropped_count(void) {
+    return atomic_load_explicit(&log_dropped, memory_order_relaxed);
+}
+
+/**
+ * Queue a record for the writer thread (never blocks)
+ */
+static void enqueue_record(ErrorLevel level, ErrorCode code, const char* file,
+                           int line, const char* func, const char* fmt, va_list args) {
+    uint64_t pos = atomic_load_explicit(&log_enqueue_pos, memory_order_relaxed);
+    LogRecord* record;
+
+    for (;;) {
+        record = &log_queue[pos & (LOG_QUEUE_CAPACITY - 1)];
+        uint64_t sequence = atomic_load_explicit(&record->sequence, memory_order_acquire);
+        int64_t diff = (int64_t)(sequence - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak(&log_enqueue_pos, &pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full: count the loss instead of waiting for the writer
+            atomic_fetch_add_explicit(&log_dropped, 1, memory_order_relaxed);
+            return;
+        } else {
+            pos = atomic_load_explicit(&log_enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    clock_gettime(CLOCK_REALTIME, &record->time);
+    record->level = level;
+    record->code = code;
+    record->file = file;
+    record->line = line;
+    record->func = func;
+    vsnprintf(record->message, sizeof(record->message), fmt, args);
+    atomic_store_explicit(&record->sequence, pos + 1, memory_order_release);
+
+    // Wake the writer only when the policy asks for it and it is asleep
+    int urgent = (int)level >= atomic_load_explicit(&log_urgent_level, memory_order_relaxed);
+    if (urgent) {
+        atomic_store(&log_urgent, 1);
+    }
+    uint64_t pending = pos + 1 - atomic_load_explicit(&log_dequeue_pos, memory_order_relaxed);
+    if ((urgent ||
+         pending >= (uint64_t)atomic_load_explicit(&log_batch_records, memory_order_relaxed)) &&
+        atomic_load(&log_writer_idle)) {
+        wake_writer();
+    }
+}
+
 /**
  * Log an error message with the specified level
  */
@@ -86,40 +439,38 @@ void log_message(ErrorLevel level, ErrorCode code, const char* file,
     if (level == ERROR_DEBUG && !g_verbose_mode) {
         return;
     }
-    
-    // Prepare the timestamp
-    time_t now = time(NULL);
-    char time_str[32];
-    strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now));
-    
-    // Format the base message
-    char message[1024];
+
+    // Nothing would print or record the message
+    if (level < ERROR_WARNING && !g_verbose_mode && g_log_file == NULL) {
+        return;
+    }
+
     va_list args;
     va_start(args, fmt);
+    if (atomic_load_explicit(&log_writer_running, memory_order_acquire)) {
+        enqueue_record(level, code, file, line, func, fmt, args);
+        va_end(args);
+        return;
+    }
+
+    // No writer thread (error_init not called, or after error_cleanup): log synchronously
+    char message[LOG_MESSAGE_SIZE];
     vsnprintf(message, sizeof(message), fmt, args);
     va_end(args);
+
+    time_t now = time(NULL);
+    struct tm tm_now;
+    char time_str[32];
+    localtime_r(&now, &tm_now);
+    strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &tm_now);
+
+    char log_entry[LOG_ENTRY_SIZE];
+    format_entry(log_entry, sizeof(log_entry), time_str, level, code, file, line, func, message);
+    print_console(level, log_entry);
     
-    // Format the full log entry
-    char log_entry[2048];
-    snprintf(log_entry, sizeof(log_entry), 
-             "[%s] %s [%s] [%s:%d:%s] %s\n",
-             time_str,
-             error_level_strings[level],
-             error_code_strings[code],
-             file, line, func,
-             message);
-    
-    // Print to console based on level
-    if (level >= ERROR_WARNING) {
-        fprintf(stderr, "%s", log_entry);
-    } else if (g_verbose_mode) {
-        printf("%s", log_entry);
-    }
-    
-    // Log to file if available
     if (g_log_file != NULL) {
-        fprintf(g_log_file, "%s", log_entry);
-        fflush(g_log_file); // Ensure the log is written immediately
+        fputs(log_entry, g_log_file);
+        fflush(g_log_file);
     }
 }
 
@@ -136,9 +487,9 @@ void fatal_error(ErrorCode code, const char* file, int line,
     va_end(args);
     
     // Log the fatal error
-    log_message(ERROR_FATAL, code, file, line, func, message);
+    log_message(ERROR_FATAL, code, file, line, func, "%s", message);
     
-    // Clean up before exit
+    // Clean up before exit (drains the log queue)
     error_cleanup();
     
     // Exit with the error code
@@ -160,7 +511,7 @@ ErrorCode check_error(int condition, ErrorLevel level, ErrorCode code,
         va_end(args);
         
         // Log the error
-        log_message(level, code, file, line, func, message);
+        log_message(level, code, file, line, func, "%s", message);
         
         return code;
     }
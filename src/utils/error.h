@@ -42,6 +42,24 @@ typedef enum {
 extern int g_verbose_mode;  // Control verbosity of error messages
 extern FILE* g_log_file;    // Log file handle
 
+/**
+ * Flush policy of the asynchronous log writer
+ *
+ * log_message only copies a record into a lock-free queue; a background
+ * thread formats queued records and writes them in batches. The writer
+ * wakes when enough records are pending, when an urgent record arrives,
+ * or when the oldest pending record has waited max_delay_ms.
+ */
+typedef struct {
+    int batch_records;      // Wake the writer once this many records are pending
+    int max_delay_ms;       // Longest a record waits before being written
+    int urgent_level;       // Records at or above this ErrorLevel wake the writer at once
+} LogFlushPolicy;
+
+// Default flush policy
+#define LOG_DEFAULT_BATCH_RECORDS 64
+#define LOG_DEFAULT_MAX_DELAY_MS  250
+
 /**
  * Initialize the error handling system
  * 
@@ -53,11 +71,28 @@ int error_init(const char* log_filename, int verbose);
 
 /**
  * Clean up the error handling system
+ * Drains the log queue and stops the writer thread before closing the file.
  */
 void error_cleanup(void);
 
+/**
+ * Change the flush policy of the log writer
+ *
+ * @param policy New policy (values <= 0 keep the current setting)
+ */
+void error_set_flush_policy(const LogFlushPolicy *policy);
+
+/**
+ * Number of records dropped because the log queue was full
+ *
+ * @return Total dropped since error_init
+ */
+unsigned long error_dropped_count(void);
+
 /**
  * Log an error message with the specified level
+ * Never blocks: once error_init has started the writer, the message is
+ * queued, and dropped (and counted) if the queue is full.
  * 
  * @param level Error level
  * @param code Error code
@@ -0,0 +1,137 @@
+#include "history.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Store a point in a tier's ring
+ * @param tier Tier to write
+ * @param point Point to store
+ */
+static void tier_push(history_tier_t *tier, history_point_t point) {
+    tier->points[tier->head] = point;
+    tier->head = tier->head + 1 == tier->capacity ? 0 : tier->head + 1;
+    tier->pushed++;
+    if (tier->count < tier->capacity) {
+        tier->count++;
+    }
+}
+
+/**
+ * Fold a point of the tier below into a tier's pending bucket
+ * @param tier Tier being rolled up into
+ * @param point Completed point of the tier below
+ * @return 1 if the bucket completed and was stored, 0 otherwise
+ */
+static int tier_fold(history_tier_t *tier, history_point_t point) {
+    if (tier->pending_count == 0) {
+        tier->pending = point;
+        tier->pending_sum = 0.0;
+    } else {
+        if (point.min < tier->pending.min) tier->pending.min = point.min;
+        if (point.max > tier->pending.max) tier->pending.max = point.max;
+    }
+    // Buckets of one tier are equal-sized, so the average of averages is exact
+    tier->pending_sum += point.avg;
+    tier->pending_count++;
+
+    if (tier->pending_count < tier->fan_in) {
+        return 0;
+    }
+
+    // pending keeps the completed point until the next fold
+    tier->pending.avg = (float)(tier->pending_sum / tier->pending_count);
+    tier_push(tier, tier->pending);
+    tier->pending_count = 0;
+    return 1;
+}
+
+/**
+ * Allocate a history
+ * @param history History to initialize
+ * @param interval_ms Sampling interval, used to size the minute buckets
+ * @param raw_capacity Raw samples to keep
+ * @return 0 on success, -1 on allocation failure
+ */
+int history_init(history_t *history, int interval_ms, int raw_capacity) {
+    memset(history, 0, sizeof(*history));
+    if (interval_ms <= 0 || raw_capacity <= 0) {
+        return -1;
+    }
+
+    history->tiers[HISTORY_RAW].capacity = raw_capacity;
+    history->tiers[HISTORY_RAW].fan_in = 1;
+    history->tiers[HISTORY_MINUTE].capacity = HISTORY_MINUTE_CAPACITY;
+    history->tiers[HISTORY_MINUTE].fan_in = interval_ms < 60000 ? 60000 / interval_ms : 1;
+    history->tiers[HISTORY_HOUR].capacity = HISTORY_HOUR_CAPACITY;
+    history->tiers[HISTORY_HOUR].fan_in = 60;
+
+    for (int i = 0; i < HISTORY_TIERS; i++) {
+        history_tier_t *tier = &history->tiers[i];
+        tier->points = malloc((size_t)tier->capacity * sizeof(history_point_t));
+        if (tier->points == NULL) {
+            history_free(history);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Release a history
+ * @param history History to free
+ */
+void history_free(history_t *history) {
+    for (int i = 0; i < HISTORY_TIERS; i++) {
+        free(history->tiers[i].points);
+        history->tiers[i].points = NULL;
+        history->tiers[i].count = 0;
+    }
+}
+
+/**
+ * Append one sample and update the rollup tiers
+ * @param history History to update
+ * @param value Sample value
+ */
+void history_append(history_t *history, float value) {
+    history_point_t point = { value, value, value };
+
+    if (history->tiers[HISTORY_RAW].points == NULL) {
+        return;
+    }
+
+    tier_push(&history->tiers[HISTORY_RAW], point);
+    history->appended++;
+
+    // Each completed bucket cascades one tier up
+    for (int i = HISTORY_MINUTE; i < HISTORY_TIERS; i++) {
+        if (!tier_fold(&history->tiers[i], point)) {
+            break;
+        }
+        point = history->tiers[i].pending;
+    }
+}
+
+/**
+ * Finest tier able to cover a window
+ * @param history History to query
+ * @param span Window length in raw samples
+ * @param points Output: number of points of the chosen tier covering the window
+ * @return Chosen tier
+ */
+history_tier_id_t history_tier_for_span(const history_t *history, int span, int *points) {
+    long per_point = 1;     // Raw samples per point of the tier
+
+    for (int i = HISTORY_RAW; i < HISTORY_TIERS; i++) {
+        const history_tier_t *tier = &history->tiers[i];
+        per_point *= tier->fan_in;
+
+        long needed = (span + per_point - 1) / per_point;
+        if (needed <= tier->capacity || i == HISTORY_TIERS - 1) {
+            *points = needed < 1 ? 1 : needed < tier->capacity ? (int)needed : tier->capacity;
+            return (history_tier_id_t)i;
+        }
+    }
+    *points = 1;
+    return HISTORY_RAW;
+}
@@ -0,0 +1,125 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+
+// Retention of the rollup tiers
+#define HISTORY_MINUTE_CAPACITY 1440    // One day of 1-minute points
+#define HISTORY_HOUR_CAPACITY   720     // 30 days of 1-hour points
+
+/**
+ * History tiers, finest first
+ */
+typedef enum {
+    HISTORY_RAW = 0,    // One point per sample
+    HISTORY_MINUTE,     // One point per minute of samples
+    HISTORY_HOUR,       // One point per hour of samples
+    HISTORY_TIERS
+} history_tier_id_t;
+
+/**
+ * One history point
+ * Raw points have min == avg == max.
+ */
+typedef struct {
+    float min;
+    float avg;
+    float max;
+} history_point_t;
+
+/**
+ * Fixed-capacity ring of points plus the bucket being rolled up into it
+ */
+typedef struct {
+    history_point_t *points;    // Ring storage
+    int capacity;               // Slots in the ring
+    int count;                  // Valid points (<= capacity)
+    int head;                   // Next slot to write
+    uint64_t pushed;            // Points ever stored (the newest has index pushed - 1)
+    int fan_in;                 // Points of the tier below per point of this tier
+
+    // Bucket under construction from the tier below
+    history_point_t pending;
+    double pending_sum;
+    int pending_count;
+} history_tier_t;
+
+/**
+ * Multi-resolution sample history
+ *
+ * Appending is O(1): the raw point goes into a ring and is folded into the
+ * pending minute bucket; a completed minute is folded into the pending
+ * hour bucket. Nothing is ever shifted, and memory is bounded by the tier
+ * capacities regardless of how long the monitor runs.
+ */
+typedef struct {
+    history_tier_t tiers[HISTORY_TIERS];
+    uint64_t appended;          // Samples appended since init
+} history_t;
+
+/**
+ * Allocate a history
+ *
+ * @param history History to initialize
+ * @param interval_ms Sampling interval, used to size the minute buckets
+ * @param raw_capacity Raw samples to keep
+ * @return 0 on success, -1 on allocation failure
+ */
+int history_init(history_t *history, int interval_ms, int raw_capacity);
+
+/**
+ * Release a history
+ *
+ * @param history History to free
+ */
+void history_free(history_t *history);
+
+/**
+ * Append one sample and update the rollup tiers
+ *
+ * @param history History to update
+ * @param value Sample value
+ */
+void history_append(history_t *history, float value);
+
+/**
+ * Number of points held by a tier
+ *
+ * @param history History to query
+ * @param tier Tier to query
+ * @return Point count
+ */
+static inline int history_count(const history_t *history, history_tier_id_t tier) {
+    return history->tiers[tier].count;
+}
+
+/**
+ * Point by age
+ *
+ * @param history History to query
+ * @param tier Tier to query
+ * @param index 0 for the oldest point, history_count() - 1 for the newest
+ * @return The point
+ */
+static inline history_point_t history_at(const history_t *history, history_tier_id_t tier,
+                                         int index) {
+    const history_tier_t *t = &history->tiers[tier];
+    int slot = t->head - t->count + index;
+    if (slot < 0) {
+        slot += t->capacity;
+    }
+    return t->points[slot];
+}
+
+/**
+ * Finest tier able to cover a window
+ *
+ * @param history History to query
+ * @param span Window length in raw samples
+ * @param points Output: number of points of the chosen tier covering the window
+ * @return Raw tier if it retains the whole window, otherwise the first rollup tier that does
+ *         (the coarsest tier when none does)
+ */
+history_tier_id_t history_tier_for_span(const history_t *history, int span, int *points);
+
+#endif // HISTORY_H
@@ -0,0 +1,233 @@
+#include "outbuf.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+// Segments per writev call (IOV_MAX on Linux and macOS)
+#define OUTBUF_IOV_MAX 1024
+
+/**
+ * One piece of the frame
+ */
+struct outbuf_segment {
+    const char *ref;        // Referenced text, or NULL for copied text
+    size_t offset;          // Offset of copied text in the buffer
+    size_t len;
+};
+
+/**
+ * Initialize an empty output buffer
+ * @param out Buffer to initialize
+ */
+void outbuf_init(outbuf_t *out) {
+    memset(out, 0, sizeof(*out));
+}
+
+/**
+ * Start a new frame (keeps the allocated storage)
+ * @param out Buffer to reset
+ */
+void outbuf_reset(outbuf_t *out) {
+    out->text_len = 0;
+    out->count = 0;
+}
+
+/**
+ * Make room for more copied text
+ * @param out Buffer to grow
+ * @param len Bytes needed past the current end
+ * @return 0 on success, -1 on allocation failure
+ */
+static int outbuf_reserve_text(outbuf_t *out, size_t len) {
+    if (out->text_len + len <= out->text_cap) {
+        return 0;
+    }
+    size_t capacity = out->text_cap ? out->text_cap : 4096;
+    while (capacity < out->text_len + len) {
+        capacity *= 2;
+    }
+    char *text = realloc(out->text, capacity);
+    if (text == NULL) {
+        return -1;
+    }
+    out->text = text;
+    out->text_cap = capacity;
+    return 0;
+}
+
+/**
+ * Add a segment
+ * @param out Buffer to append to
+ * @return New segment, or NULL on allocation failure
+ */
+static struct outbuf_segment *outbuf_add_segment(outbuf_t *out) {
+    if (out->count == out->capacity) {
+        int capacity = out->capacity ? out->capacity * 2 : 64;
+        struct outbuf_segment *segments = realloc(out->segments, capacity * sizeof(*segments));
+        if (segments == NULL) {
+            return NULL;
+        }
+        out->segments = segments;
+        out->capacity = capacity;
+    }
+    return &out->segments[out->count++];
+}
+
+/**
+ * Account for text just copied to the end of the buffer
+ * @param out Buffer appended to
+ * @param len Bytes copied
+ */
+static void outbuf_commit_text(outbuf_t *out, size_t len) {
+    struct outbuf_segment *last = out->count > 0 ? &out->segments[out->count - 1] : NULL;
+
+    // Copied text right after the previous copy extends its segment
+    if (last != NULL && last->ref == NULL && last->offset + last->len == out->text_len) {
+        last->len += len;
+    } else {
+        struct outbuf_segment *segment = outbuf_add_segment(out);
+        if (segment == NULL) {
+            return;
+        }
+        segment->ref = NULL;
+        segment->offset = out->text_len;
+        segment->len = len;
+    }
+    out->text_len += len;
+}
+
+/**
+ * Append a copy of some text
+ * @param out Buffer to append to
+ * @param text Text to copy
+ * @param len Number of bytes
+ */
+void outbuf_append(outbuf_t *out, const char *text, size_t len) {
+    if (len == 0 || outbuf_reserve_text(out, len) != 0) {
+        return;
+    }
+    memcpy(out->text + out->text_len, text, len);
+    outbuf_commit_text(out, len);
+}
+
+/**
+ * Append a copy of a string
+ * @param out Buffer to append to
+ * @param text NUL-terminated string
+ */
+void outbuf_puts(outbuf_t *out, const char *text) {
+    outbuf_append(out, text, strlen(text));
+}
+
+/**
+ * Append formatted text
+ * @param out Buffer to append to
+ * @param fmt Format string
+ * @param ... Format arguments
+ */
+void outbuf_printf(outbuf_t *out, const char *fmt, ...) {
+    va_list args;
+
+    // Format straight into the buffer, growing it once if the text does not fit
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (outbuf_reserve_text(out, 256) != 0) {
+            return;
+        }
+        size_t room = out->text_cap - out->text_len;
+
+        va_start(args, fmt);
+        int len = vsnprintf(out->text + out->text_len, room, fmt, args);
+        va_end(args);
+
+        if (len < 0) {
+            return;
+        }
+        if ((size_t)len < room) {
+            if (len > 0) {
+                outbuf_commit_text(out, (size_t)len);
+            }
+            return;
+        }
+        if (outbuf_reserve_text(out, (size_t)len + 1) != 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * Append text by reference
+ * @param out Buffer to append to
+ * @param text Text to reference (valid until outbuf_flush)
+ * @param len Number of bytes
+ */
+void outbuf_append_ref(outbuf_t *out, const char *text, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    struct outbuf_segment *segment = outbuf_add_segment(out);
+    if (segment == NULL) {
+        return;
+    }
+    segment->ref = text;
+    segment->offset = 0;
+    segment->len = len;
+}
+
+/**
+ * Write the frame with writev and start a new one
+ * @param out Buffer to flush
+ * @param fd Output descriptor
+ * @return 0 on success, -1 if the write failed
+ */
+int outbuf_flush(outbuf_t *out, int fd) {
+    struct iovec iov[OUTBUF_IOV_MAX];
+    int next = 0;           // First segment not fully written
+    size_t skip = 0;        // Bytes of that segment already written
+    int status = 0;
+
+    while (next < out->count) {
+        int count = 0;
+        for (int i = next; i < out->count && count < OUTBUF_IOV_MAX; i++, count++) {
+            const struct outbuf_segment *segment = &out->segments[i];
+            const char *base = segment->ref != NULL ? segment->ref : out->text + segment->offset;
+            size_t offset = i == next ? skip : 0;
+            iov[count].iov_base = (void *)(base + offset);
+            iov[count].iov_len = segment->len - offset;
+        }
+
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            status = -1;
+            break;
+        }
+
+        // Advance past what was written (a short write resumes mid-segment)
+        size_t left = (size_t)written;
+        while (next < out->count && left >= out->segments[next].len - skip) {
+            left -= out->segments[next].len - skip;
+            next++;
+            skip = 0;
+        }
+        skip += left;
+    }
+
+    outbuf_reset(out);
+    return status;
+}
+
+/**
+ * Release the buffer's storage
+ * @param out Buffer to free
+ */
+void outbuf_free(outbuf_t *out) {
+    free(out->text);
+    free(out->segments);
+    memset(out, 0, sizeof(*out));
+}
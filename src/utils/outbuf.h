@@ -0,0 +1,91 @@
+#ifndef OUTBUF_H
+#define OUTBUF_H
+
+#include <stddef.h>
+
+/**
+ * Per-frame output buffer
+ *
+ * Collects one frame of output as a list of segments and sends it with
+ * writev. Short formatted text is copied into the buffer (consecutive
+ * copies share one segment). Long rows that outlive the frame, such as
+ * stored graph rows, are referenced in place instead of copied. The
+ * storage is kept across frames, so a steady-state frame allocates
+ * nothing.
+ */
+typedef struct {
+    char *text;             // Copied text
+    size_t text_len;
+    size_t text_cap;
+
+    struct outbuf_segment *segments;
+    int count;
+    int capacity;
+} outbuf_t;
+
+/**
+ * Initialize an empty output buffer
+ *
+ * @param out Buffer to initialize
+ */
+void outbuf_init(outbuf_t *out);
+
+/**
+ * Start a new frame (keeps the allocated storage)
+ *
+ * @param out Buffer to reset
+ */
+void outbuf_reset(outbuf_t *out);
+
+/**
+ * Append a copy of some text
+ *
+ * @param out Buffer to append to
+ * @param text Text to copy
+ * @param len Number of bytes
+ */
+void outbuf_append(outbuf_t *out, const char *text, size_t len);
+
+/**
+ * Append a copy of a string
+ *
+ * @param out Buffer to append to
+ * @param text NUL-terminated string
+ */
+void outbuf_puts(outbuf_t *out, const char *text);
+
+/**
+ * Append formatted text
+ *
+ * @param out Buffer to append to
+ * @param fmt Format string
+ * @param ... Format arguments
+ */
+void outbuf_printf(outbuf_t *out, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * Append text by reference; it must stay valid until outbuf_flush
+ *
+ * @param out Buffer to append to
+ * @param text Text to reference
+ * @param len Number of bytes
+ */
+void outbuf_append_ref(outbuf_t *out, const char *text, size_t len);
+
+/**
+ * Write the frame with writev and start a new one
+ *
+ * @param out Buffer to flush
+ * @param fd Output descriptor
+ * @return 0 on success, -1 if the write failed
+ */
+int outbuf_flush(outbuf_t *out, int fd);
+
+/**
+ * Release the buffer's storage
+ *
+ * @param out Buffer to free
+ */
+void outbuf_free(outbuf_t *out);
+
+#endif // OUTBUF_H
@@ -0,0 +1,223 @@
+#include "pid_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Smallest table allocated
+#define PID_TABLE_MIN_BITS 6
+
+/**
+ * Row at a slot index
+ * @param table Table
+ * @param index Slot index
+ * @return Row key
+ */
+static pid_key_t *pid_table_row(const pid_table_t *table, uint32_t index) {
+    return (pid_key_t *)(table->slots + (size_t)index * table->row_size);
+}
+
+/**
+ * Home slot of a pid (Fibonacci hashing: pids are mostly sequential)
+ * @param table Table
+ * @param pid Process id
+ * @return Slot index
+ */
+static uint32_t pid_table_home(const pid_table_t *table, int pid) {
+    return ((uint32_t)pid * 2654435761u) >> (32 - table->bits);
+}
+
+/**
+ * Allocate an empty slot array
+ * @param table Table to set up
+ * @param bits log2 of the slot count
+ * @return 0 on success, -1 on allocation failure
+ */
+static int pid_table_alloc(pid_table_t *table, int bits) {
+    unsigned char *slots = calloc((size_t)1 << bits, table->row_size);
+    if (slots == NULL) {
+        return -1;
+    }
+    table->slots = slots;
+    table->bits = bits;
+    table->capacity = 1u << bits;
+    table->count = 0;
+    return 0;
+}
+
+/**
+ * Create a table
+ * @param table Table to initialize
+ * @param row_size Size of one row
+ * @param capacity Expected process count
+ * @return 0 on success, -1 on allocation failure
+ */
+int pid_table_init(pid_table_t *table, size_t row_size, uint32_t capacity) {
+    int bits = PID_TABLE_MIN_BITS;
+
+    // Room for the expected count below the 3/4 load limit
+    while (bits < 30 && (1u << bits) * 3 / 4 < capacity) {
+        bits++;
+    }
+
+    memset(table, 0, sizeof(*table));
+    table->row_size = row_size;
+    table->generation = 1;
+    return pid_table_alloc(table, bits);
+}
+
+/**
+ * Double the slot array and reinsert every row
+ * @param table Table to grow
+ * @return 0 on success, -1 on allocation failure (the table is unchanged)
+ */
+static int pid_table_grow(pid_table_t *table) {
+    pid_table_t old = *table;
+
+    if (pid_table_alloc(table, old.bits + 1) != 0) {
+        *table = old;
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < old.capacity; i++) {
+        const pid_key_t *row = pid_table_row(&old, i);
+        if (row->pid == 0) {
+            continue;
+        }
+        uint32_t slot = pid_table_home(table, row->pid);
+        while (pid_table_row(table, slot)->pid != 0) {
+            slot = (slot + 1) & (table->capacity - 1);
+        }
+        memcpy(pid_table_row(table, slot), row, table->row_size);
+        table->count++;
+    }
+    free(old.slots);
+    return 0;
+}
+
+/**
+ * Start a scan
+ * @param table Table to scan into
+ */
+void pid_table_begin(pid_table_t *table) {
+    table->generation++;
+}
+
+/**
+ * Find the row of a pid without marking it
+ * @param table Table to search
+ * @param pid Process id
+ * @return The row, or NULL if the pid has none
+ */
+void *pid_table_find(const pid_table_t *table, int pid) {
+    uint32_t mask = table->capacity - 1;
+
+    for (uint32_t slot = pid_table_home(table, pid);; slot = (slot + 1) & mask) {
+        pid_key_t *row = pid_table_row(table, slot);
+        if (row->pid == pid) {
+            return row;
+        }
+        if (row->pid == 0) {
+            return NULL;
+        }
+    }
+}
+
+/**
+ * Find or create the row of a process and mark it seen by this scan
+ * @param table Table being scanned into
+ * @param pid Process id
+ * @param starttime Process start time
+ * @param fresh Output: 1 if the row carries no history for this process
+ * @return The row, or NULL if the table could not grow
+ */
+void *pid_table_touch(pid_table_t *table, int pid, uint64_t starttime, int *fresh) {
+    if ((table->count + 1) * 4 > table->capacity * 3 && pid_table_grow(table) != 0) {
+        return NULL;
+    }
+
+    uint32_t mask = table->capacity - 1;
+    uint32_t slot = pid_table_home(table, pid);
+    pid_key_t *row;
+
+    for (;; slot = (slot + 1) & mask) {
+        row = pid_table_row(table, slot);
+        if (row->pid == pid || row->pid == 0) {
+            break;
+        }
+    }
+
+    *fresh = row->pid == 0 || row->starttime != starttime;
+    if (*fresh) {
+        if (row->pid == 0) {
+            table->count++;
+        }
+        memset(row, 0, table->row_size);
+        row->pid = pid;
+        row->starttime = starttime;
+    }
+    row->generation = table->generation;
+    return row;
+}
+
+/**
+ * Empty a slot, shifting later rows of its probe run back into the hole
+ * @param table Table
+ * @param hole Slot to empty
+ */
+static void pid_table_remove_at(pid_table_t *table, uint32_t hole) {
+    uint32_t mask = table->capacity - 1;
+    uint32_t next = hole;
+
+    for (;;) {
+        next = (next + 1) & mask;
+        pid_key_t *row = pid_table_row(table, next);
+        if (row->pid == 0) {
+            break;
+        }
+
+        // A row may move back only if its home is not in (hole, next]
+        uint32_t home = pid_table_home(table, row->pid);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            memcpy(pid_table_row(table, hole), row, table->row_size);
+            hole = next;
+        }
+    }
+
+    pid_table_row(table, hole)->pid = 0;
+    table->count--;
+}
+
+/**
+ * End a scan: remove every row the scan did not touch
+ * @param table Table that was scanned into
+ * @param evict Called for each removed row (NULL: nothing to release)
+ * @param context Passed to evict
+ * @return Number of rows removed
+ */
+uint32_t pid_table_sweep(pid_table_t *table, pid_table_evict_t evict, void *context) {
+    uint32_t removed = 0;
+    uint32_t i = 0;
+
+    while (i < table->capacity) {
+        const pid_key_t *row = pid_table_row(table, i);
+        if (row->pid != 0 && row->generation != table->generation) {
+            if (evict != NULL) {
+                evict((void *)row, context);
+            }
+            // The slot now holds a shifted row (or nothing): look at it again
+            pid_table_remove_at(table, i);
+            removed++;
+            continue;
+        }
+        i++;
+    }
+    return removed;
+}
+
+/**
+ * Release the slot array
+ * @param table Table to free
+ */
+void pid_table_free(pid_table_t *table) {
+    free(table->slots);
+    memset(table, 0, sizeof(*table));
+}
@@ -0,0 +1,112 @@
+#ifndef PID_TABLE_H
+#define PID_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Per-process row key
+ *
+ * Must be the first member of every row stored in a pid_table_t. A pid
+ * can be reused by a later process, so a row belongs to the process with
+ * this pid and start time; a different start time replaces the row.
+ */
+typedef struct {
+    int32_t pid;            // Process id (0: free slot)
+    uint32_t generation;    // Last scan that saw the process
+    uint64_t starttime;     // Start time in clock ticks after boot
+} pid_key_t;
+
+/**
+ * Called for each row removed by a sweep, before its slot is reused
+ */
+typedef void (*pid_table_evict_t)(void *row, void *context);
+
+/**
+ * Open-addressing table of per-process rows
+ *
+ * Linear probing over a power-of-two slot array of fixed-size rows.
+ * Every scan starts a new generation and touches the rows of the
+ * processes it finds; the sweep at the end removes the rows left on an
+ * older generation (exited processes) in place, with backward-shift
+ * deletion, so the table is never rebuilt and holds no tombstones.
+ * It only grows when the load factor passes 3/4.
+ */
+typedef struct {
+    unsigned char *slots;   // capacity rows of row_size bytes
+    size_t row_size;        // Bytes per row (starts with a pid_key_t)
+    uint32_t capacity;      // Slot count (power of two)
+    uint32_t count;         // Occupied slots
+    uint32_t generation;    // Current scan
+    int bits;               // log2(capacity)
+} pid_table_t;
+
+/**
+ * Create a table
+ *
+ * @param table Table to initialize
+ * @param row_size Size of one row, at least sizeof(pid_key_t)
+ * @param capacity Expected process count (rounded up to a power of two)
+ * @return 0 on success, -1 on allocation failure
+ */
+int pid_table_init(pid_table_t *table, size_t row_size, uint32_t capacity);
+
+/**
+ * Start a scan: rows not touched before the next sweep are evicted
+ *
+ * @param table Table to scan into
+ */
+void pid_table_begin(pid_table_t *table);
+
+/**
+ * Find the row of a pid without marking it
+ *
+ * @param table Table to search
+ * @param pid Process id
+ * @return The row, or NULL if the pid has none
+ */
+void *pid_table_find(const pid_table_t *table, int pid);
+
+/**
+ * Mark a row found with pid_table_find as seen by this scan
+ *
+ * @param table Table being scanned into
+ * @param row Row of a process known to be the same as before
+ */
+static inline void pid_table_keep(const pid_table_t *table, void *row) {
+    ((pid_key_t *)row)->generation = table->generation;
+}
+
+/**
+ * Find or create the row of a process and mark it seen by this scan
+ *
+ * A new row, or a row whose pid now belongs to a different process, is
+ * zeroed apart from its key and reported through fresh. The returned
+ * pointer is valid until the next touch or sweep.
+ *
+ * @param table Table being scanned into
+ * @param pid Process id (> 0)
+ * @param starttime Process start time
+ * @param fresh Output: 1 if the row carries no history for this process
+ * @return The row, or NULL if the table could not grow
+ */
+void *pid_table_touch(pid_table_t *table, int pid, uint64_t starttime, int *fresh);
+
+/**
+ * End a scan: remove every row the scan did not touch
+ *
+ * @param table Table that was scanned into
+ * @param evict Called for each removed row (NULL: nothing to release)
+ * @param context Passed to evict
+ * @return Number of rows removed
+ */
+uint32_t pid_table_sweep(pid_table_t *table, pid_table_evict_t evict, void *context);
+
+/**
+ * Release the slot array
+ *
+ * @param table Table to free
+ */
+void pid_table_free(pid_table_t *table);
+
+#endif // PID_TABLE_H
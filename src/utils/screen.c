@@ -0,0 +1,392 @@
+#include "screen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+// Size used when the output is not a terminal
+#define SCREEN_FALLBACK_ROWS 256
+#define SCREEN_FALLBACK_COLS 256
+
+// Unchanged cells a run may bridge: cheaper to resend than to move the cursor
+#define SCREEN_RUN_GAP 8
+
+static volatile sig_atomic_t screen_resized = 0;
+
+/**
+ * SIGWINCH handler: the next frame picks up the new size
+ * @param signal Signal number
+ */
+static void screen_on_resize(int signal) {
+    (void)signal;
+    screen_resized = 1;
+}
+
+/**
+ * Query the terminal size
+ * @param fd Output descriptor
+ * @param rows Output: rows
+ * @param cols Output: columns
+ */
+static void screen_query_size(int fd, int *rows, int *cols) {
+    struct winsize size;
+
+    if (ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+        *rows = size.ws_row;
+        *cols = size.ws_col;
+    } else {
+        *rows = SCREEN_FALLBACK_ROWS;
+        *cols = SCREEN_FALLBACK_COLS;
+    }
+}
+
+/**
+ * (Re)allocate the cell buffers for a size
+ * @param screen Screen to resize
+ * @param rows New rows
+ * @param cols New columns
+ * @return 0 on success, -1 on allocation failure (the old buffers are kept)
+ */
+static int screen_resize(screen_t *screen, int rows, int cols) {
+    size_t cells = (size_t)rows * (size_t)cols;
+    char *front = malloc(cells);
+    char *back = malloc(cells);
+
+    if (front == NULL || back == NULL) {
+        free(front);
+        free(back);
+        return -1;
+    }
+    memset(front, ' ', cells);
+    memset(back, ' ', cells);
+
+    free(screen->front);
+    free(screen->back);
+    screen->front = front;
+    screen->back = back;
+    screen->rows = rows;
+    screen->cols = cols;
+    screen->full_redraw = 1;
+    return 0;
+}
+
+/**
+ * Append bytes to the frame output
+ * @param screen Screen being presented
+ * @param data Bytes to append
+ * @param len Number of bytes
+ */
+static void screen_emit(screen_t *screen, const char *data, size_t len) {
+    if (screen->out_len + len > screen->out_cap) {
+        size_t capacity = screen->out_cap ? screen->out_cap : 4096;
+        while (capacity < screen->out_len + len) {
+            capacity *= 2;
+        }
+        char *out = realloc(screen->out, capacity);
+        if (out == NULL) {
+            return;
+        }
+        screen->out = out;
+        screen->out_cap = capacity;
+    }
+    memcpy(screen->out + screen->out_len, data, len);
+    screen->out_len += len;
+}
+
+/**
+ * Append a cursor move to the frame output
+ * @param screen Screen being presented
+ * @param row Target row (0-based)
+ * @param col Target column (0-based)
+ */
+static void screen_emit_move(screen_t *screen, int row, int col) {
+    char move[32];
+    int len = snprintf(move, sizeof(move), "\033[%d;%dH", row + 1, col + 1);
+    screen_emit(screen, move, (size_t)len);
+}
+
+/**
+ * Write the frame output in one write (looping only on partial writes)
+ * @param screen Screen being presented
+ * @return 0 on success, -1 if the write failed
+ */
+static int screen_flush(screen_t *screen) {
+    size_t written = 0;
+
+    while (written < screen->out_len) {
+        ssize_t n = write(screen->fd, screen->out + written, screen->out_len - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        written += (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * Set up a screen on standard output
+ * @param screen Screen to initialize
+ * @return 0 on success, -1 on allocation failure
+ */
+int screen_init(screen_t *screen) {
+    struct sigaction action;
+    int rows, cols;
+
+    memset(screen, 0, sizeof(*screen));
+    screen->fd = STDOUT_FILENO;
+
+    screen_query_size(screen->fd, &rows, &cols);
+    if (screen_resize(screen, rows, cols) != 0) {
+        return -1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = screen_on_resize;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &action, NULL);
+    return 0;
+}
+
+/**
+ * Start composing a frame
+ * @param screen Screen to compose on
+ */
+void screen_begin(screen_t *screen) {
+    if (screen_resized) {
+        int rows, cols;
+        screen_resized = 0;
+        screen_query_size(screen->fd, &rows, &cols);
+        if (rows != screen->rows || cols != screen->cols) {
+            screen_resize(screen, rows, cols);
+        }
+        // The terminal may have reflowed what it showed: repaint either way
+        screen->full_redraw = 1;
+    }
+
+    memset(screen->back, ' ', (size_t)screen->rows * (size_t)screen->cols);
+    screen->row = 0;
+    screen->col = 0;
+    screen->used_rows = 0;
+    screen->wanted_rows = 0;
+}
+
+/**
+ * Append text at the compose cursor
+ * @param screen Screen to compose on
+ * @param text Text to append
+ */
+void screen_puts(screen_t *screen, const char *text) {
+    for (const char *p = text; *p != '\0'; p++) {
+        if (*p == '\n') {
+            screen->row++;
+            screen->col = 0;
+            continue;
+        }
+        if (screen->row >= screen->rows) {
+            if (*p != ' ' && screen->row >= screen->wanted_rows) {
+                screen->wanted_rows = screen->row + 1;
+            }
+            continue;
+        }
+
+        // Never fill the bottom-right cell: the terminal would scroll
+        int limit = screen->row == screen->rows - 1 ? screen->cols - 1 : screen->cols;
+        if (screen->col < limit) {
+            char cell = (unsigned char)*p < ' ' ? ' ' : *p;
+            screen->back[screen->row * screen->cols + screen->col] = cell;
+            if (screen->row >= screen->used_rows) {
+                screen->used_rows = screen->row + 1;
+            }
+        }
+        screen->col++;
+    }
+}
+
+/**
+ * Append formatted text at the compose cursor
+ * @param screen Screen to compose on
+ * @param fmt Format string
+ * @param ... Format arguments
+ */
+void screen_printf(screen_t *screen, const char *fmt, ...) {
+    char text[1024];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    screen_puts(screen, text);
+}
+
+/**
+ * Replace the last row with a count of the rows that did not fit
+ * @param screen Screen being presented
+ */
+static void screen_mark_overflow(screen_t *screen) {
+    char *row = screen->back + (size_t)(screen->rows - 1) * screen->cols;
+    char marker[128];
+    int hidden = screen->wanted_rows - screen->rows + 1;
+    int len = snprintf(marker, sizeof(marker), "... %d more lines (enlarge the terminal or use -s)", hidden);
+
+    // Never fill the bottom-right cell: the terminal would scroll
+    if (len > screen->cols - 1) {
+        len = screen->cols - 1;
+    }
+    memset(row, ' ', (size_t)screen->cols);
+    if (len > 0) {
+        memcpy(row, marker, (size_t)len);
+    }
+    screen->used_rows = screen->rows;
+}
+
+/**
+ * Last non-blank column of a row
+ * @param row Row cells
+ * @param cols Row width
+ * @return Column index, -1 if the row is blank
+ */
+static int screen_row_end(const char *row, int cols) {
+    int end = cols - 1;
+    while (end >= 0 && row[end] == ' ') {
+        end--;
+    }
+    return end;
+}
+
+/**
+ * Emit one row of a differential update
+ * @param screen Screen being presented
+ * @param r Row index
+ * @param cursor_row In/out: terminal cursor row (-1 if unknown)
+ * @param cursor_col In/out: terminal cursor column (-1 if unknown)
+ */
+static void screen_diff_row(screen_t *screen, int r, int *cursor_row, int *cursor_col) {
+    const char *back = screen->back + (size_t)r * screen->cols;
+    const char *front = screen->front + (size_t)r * screen->cols;
+    int cols = screen->cols;
+    int last = screen_row_end(back, cols);
+    int c = 0;
+
+    while (c < cols) {
+        if (back[c] == front[c]) {
+            c++;
+            continue;
+        }
+
+        // Extend the run until SCREEN_RUN_GAP cells in a row are unchanged
+        int end = c + 1;
+        int same = 0;
+        while (end < cols && same < SCREEN_RUN_GAP) {
+            same = back[end] == front[end] ? same + 1 : 0;
+            end++;
+        }
+        end -= same;
+
+        if (*cursor_row != r || *cursor_col != c) {
+            screen_emit_move(screen, r, c);
+        }
+
+        if (end > last + 1) {
+            // The rest of the row is blank: write up to its end and erase the tail
+            if (c <= last) {
+                screen_emit(screen, back + c, (size_t)(last + 1 - c));
+            }
+            screen_emit(screen, "\033[K", 3);
+            *cursor_row = r;
+            *cursor_col = c <= last ? last + 1 : c;
+            return;
+        }
+
+        screen_emit(screen, back + c, (size_t)(end - c));
+        *cursor_row = r;
+        *cursor_col = end < cols ? end : -1;   // Pending wrap at the right edge
+        c = end;
+    }
+}
+
+/**
+ * Send the differences between the composed frame and the terminal
+ * @param screen Screen to present
+ * @return 0 on success, -1 if the write failed
+ */
+int screen_present(screen_t *screen) {
+    int cursor_row = -1, cursor_col = -1;
+
+    if (screen->wanted_rows > screen->rows) {
+        screen_mark_overflow(screen);
+    }
+
+    screen->out_len = 0;
+    if (screen->full_redraw) {
+        screen_emit(screen, "\033[H\033[2J", 7);
+        memset(screen->front, ' ', (size_t)screen->rows * (size_t)screen->cols);
+        screen->shown_rows = 0;
+        cursor_row = cursor_col = 0;
+        screen->full_redraw = 0;
+    }
+
+    int rows = screen->used_rows > screen->shown_rows ? screen->used_rows : screen->shown_rows;
+    for (int r = 0; r < rows && r < screen->rows; r++) {
+        screen_diff_row(screen, r, &cursor_row, &cursor_col);
+    }
+
+    // Park the cursor below the frame so other output does not overwrite it
+    if (screen->out_len > 0) {
+        int park = screen->used_rows < screen->rows ? screen->used_rows : screen->rows - 1;
+        if (cursor_row != park || cursor_col != 0) {
+            screen_emit_move(screen, park, 0);
+        }
+    }
+
+    memcpy(screen->front, screen->back, (size_t)screen->rows * (size_t)screen->cols);
+    screen->shown_rows = screen->used_rows;
+
+    // One write per frame
+    if (screen_flush(screen) != 0) {
+        screen->full_redraw = 1;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Force the next present to repaint the whole frame
+ * @param screen Screen to invalidate
+ */
+void screen_invalidate(screen_t *screen) {
+    screen->full_redraw = 1;
+}
+
+/**
+ * Leave the cursor below the last frame and release the screen
+ * @param screen Screen to release
+ */
+void screen_free(screen_t *screen) {
+    signal(SIGWINCH, SIG_DFL);
+
+    // Output written after the last frame starts on the row below it; a
+    // frame that fills the terminal is scrolled up one line first
+    if (screen->front != NULL && screen->shown_rows > 0) {
+        screen->out_len = 0;
+        if (screen->shown_rows < screen->rows) {
+            screen_emit_move(screen, screen->shown_rows, 0);
+        } else {
+            screen_emit_move(screen, screen->rows - 1, 0);
+            screen_emit(screen, "\n", 1);
+        }
+        screen_flush(screen);
+    }
+
+    free(screen->front);
+    free(screen->back);
+    free(screen->out);
+    memset(screen, 0, sizeof(*screen));
+}
@@ -0,0 +1,93 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <stddef.h>
+
+/**
+ * Differential terminal renderer
+ *
+ * A frame is composed into a cell buffer (one byte per column, so frames
+ * must be ASCII) and compared with the frame the terminal already shows.
+ * Only the changed runs of each row are sent, with cursor moves in
+ * between, in a single write(). Rows past the bottom or text past the
+ * right edge are clipped. A SIGWINCH handler flags resizes; the next
+ * frame then resizes the buffers and redraws everything.
+ */
+typedef struct {
+    int rows;               // Terminal size
+    int cols;
+    char *front;            // What the terminal shows (rows * cols)
+    char *back;             // Frame being composed (rows * cols)
+    int row;                // Compose cursor
+    int col;
+    int used_rows;          // Rows the composed frame reaches
+    int wanted_rows;        // Rows the composed text needs (may exceed rows)
+    int shown_rows;         // Rows the terminal frame reaches
+    int full_redraw;        // Clear and repaint on the next present
+    int fd;                 // Output descriptor
+
+    // Escape sequence output of one frame
+    char *out;
+    size_t out_len;
+    size_t out_cap;
+} screen_t;
+
+/**
+ * Set up a screen on standard output
+ *
+ * @param screen Screen to initialize
+ * @return 0 on success, -1 on allocation failure
+ */
+int screen_init(screen_t *screen);
+
+/**
+ * Start composing a frame: apply a pending resize and blank the frame
+ *
+ * @param screen Screen to compose on
+ */
+void screen_begin(screen_t *screen);
+
+/**
+ * Append text at the compose cursor ('\n' starts a new row)
+ *
+ * Rows below the terminal height are not shown; the last row is then
+ * replaced by a marker telling how many rows were left out.
+ *
+ * @param screen Screen to compose on
+ * @param text Text to append
+ */
+void screen_puts(screen_t *screen, const char *text);
+
+/**
+ * Append formatted text at the compose cursor
+ *
+ * @param screen Screen to compose on
+ * @param fmt Format string
+ * @param ... Format arguments
+ */
+void screen_printf(screen_t *screen, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * Send the differences between the composed frame and the terminal
+ *
+ * @param screen Screen to present
+ * @return 0 on success, -1 if the write failed
+ */
+int screen_present(screen_t *screen);
+
+/**
+ * Force the next present to repaint the whole frame
+ * Use after something else has written to the terminal.
+ *
+ * @param screen Screen to invalidate
+ */
+void screen_invalidate(screen_t *screen);
+
+/**
+ * Leave the cursor below the last frame and release the screen
+ *
+ * @param screen Screen to release
+ */
+void screen_free(screen_t *screen);
+
+#endif // SCREEN_H
@@ -0,0 +1,258 @@
+#define _GNU_SOURCE
+#include "spsc_ring.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+/**
+ * Round a slot count up to a power of two
+ * @param n Requested count
+ * @return Smallest power of two >= n
+ */
+static uint32_t round_up_pow2(uint32_t n) {
+    uint32_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * Map shared memory for the ring
+ * Uses a memfd on Linux and falls back to an anonymous shared mapping.
+ * @param ring Ring being created (map_size already set)
+ * @return Mapped address, or MAP_FAILED
+ */
+static void *map_ring(spsc_ring_t *ring) {
+    ring->mem_fd = -1;
+
+#ifdef __linux__
+    ring->mem_fd = memfd_create("sysmon-ring", MFD_CLOEXEC);
+    if (ring->mem_fd >= 0) {
+        if (ftruncate(ring->mem_fd, (off_t)ring->map_size) == 0) {
+            void *addr = mmap(NULL, ring->map_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, ring->mem_fd, 0);
+            if (addr != MAP_FAILED) {
+                return addr;
+            }
+        }
+        close(ring->mem_fd);
+        ring->mem_fd = -1;
+    }
+#endif
+
+    return mmap(NULL, ring->map_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+}
+
+/**
+ * Create the wakeup descriptors
+ * eventfd on Linux; a non-blocking pipe elsewhere.
+ * @param ring Ring being created
+ * @return 0 on success, -1 on failure
+ */
+static int open_event(spsc_ring_t *ring) {
+#ifdef __linux__
+    ring->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ring->notify_fd = ring->event_fd;
+    return ring->event_fd < 0 ? -1 : 0;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        ring->event_fd = ring->notify_fd = -1;
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    ring->event_fd = fds[0];
+    ring->notify_fd = fds[1];
+    return 0;
+#endif
+}
+
+/**
+ * Post one wakeup to the consumer
+ * @param ring Ring to signal
+ */
+static void notify(spsc_ring_t *ring) {
+#ifdef __linux__
+    uint64_t one = 1;
+    ssize_t n = write(ring->notify_fd, &one, sizeof(one));
+#else
+    char one = 1;
+    ssize_t n = write(ring->notify_fd, &one, sizeof(one));
+#endif
+    // EAGAIN means a wakeup is already pending
+    (void)n;
+}
+
+/**
+ * Consume all pending wakeups
+ * @param ring Ring to drain
+ */
+static void drain_event(spsc_ring_t *ring) {
+#ifdef __linux__
+    uint64_t count;
+    ssize_t n = read(ring->event_fd, &count, sizeof(count));
+    (void)n;
+#else
+    char buf[64];
+    while (read(ring->event_fd, buf, sizeof(buf)) > 0) {
+    }
+#endif
+}
+
+/**
+ * Create a ring
+ * @param ring Ring to initialize
+ * @param slot_size Size of one record in bytes
+ * @param capacity Number of slots, rounded up to a power of two
+ * @return 0 on success, -1 on failure
+ */
+int spsc_ring_create(spsc_ring_t *ring, size_t slot_size, uint32_t capacity) {
+    capacity = round_up_pow2(capacity ? capacity : 1);
+
+    // Keep every slot cache-line aligned
+    ring->slot_size = slot_size;
+    ring->stride = (slot_size + SPSC_RING_CACHE_LINE - 1) & ~(size_t)(SPSC_RING_CACHE_LINE - 1);
+    ring->mask = capacity - 1;
+    ring->map_size = sizeof(spsc_ring_header_t) + ring->stride * capacity;
+
+    void *addr = map_ring(ring);
+    if (addr == MAP_FAILED) {
+        return -1;
+    }
+
+    if (open_event(ring) != 0) {
+        munmap(addr, ring->map_size);
+        if (ring->mem_fd >= 0) {
+            close(ring->mem_fd);
+        }
+        return -1;
+    }
+
+    // Fresh mappings are zero-filled: indices start at 0, ring open
+    ring->hdr = addr;
+    ring->slots = (unsigned char *)addr + sizeof(spsc_ring_header_t);
+    return 0;
+}
+
+/**
+ * Unmap the ring and close its descriptors
+ * @param ring Ring to destroy
+ */
+void spsc_ring_destroy(spsc_ring_t *ring) {
+    if (ring->hdr != NULL) {
+        munmap(ring->hdr, ring->map_size);
+        ring->hdr = NULL;
+    }
+    if (ring->mem_fd >= 0) {
+        close(ring->mem_fd);
+        ring->mem_fd = -1;
+    }
+    if (ring->notify_fd >= 0 && ring->notify_fd != ring->event_fd) {
+        close(ring->notify_fd);
+    }
+    if (ring->event_fd >= 0) {
+        close(ring->event_fd);
+    }
+    ring->event_fd = ring->notify_fd = -1;
+}
+
+/**
+ * Copy a record into the ring (producer side)
+ * @param ring Ring to write
+ * @param record Record of slot_size bytes
+ * @return 0 on success, -1 if the ring was full
+ */
+int spsc_ring_push(spsc_ring_t *ring, const void *record) {
+    spsc_ring_header_t *hdr = ring->hdr;
+    uint64_t head = atomic_load_explicit(&hdr->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&hdr->tail, memory_order_acquire);
+
+    if (head - tail > ring->mask) {
+        atomic_fetch_add_explicit(&hdr->dropped, 1, memory_order_relaxed);
+        return -1;
+    }
+
+    memcpy(ring->slots + (head & ring->mask) * ring->stride, record, ring->slot_size);
+    atomic_store_explicit(&hdr->head, head + 1, memory_order_release);
+
+    // Pairs with the fence in spsc_ring_wait: either the consumer sees the
+    // new head before sleeping, or we see its waiting flag and wake it
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&hdr->consumer_waiting, memory_order_relaxed)) {
+        notify(ring);
+    }
+    return 0;
+}
+
+/**
+ * Copy the oldest record out of the ring (consumer side)
+ * @param ring Ring to read
+ * @param record Output buffer of slot_size bytes
+ * @return 0 on success, -1 if the ring was empty
+ */
+int spsc_ring_pop(spsc_ring_t *ring, void *record) {
+    spsc_ring_header_t *hdr = ring->hdr;
+    uint64_t tail = atomic_load_explicit(&hdr->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&hdr->head, memory_order_acquire);
+
+    if (head == tail) {
+        return -1;
+    }
+
+    memcpy(record, ring->slots + (tail & ring->mask) * ring->stride, ring->slot_size);
+    atomic_store_explicit(&hdr->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * Sleep until the ring has a record, is closed or is woken (consumer side)
+ * @param ring Ring to wait on
+ * @param timeout_ms Maximum wait in milliseconds (-1: no limit)
+ */
+void spsc_ring_wait(spsc_ring_t *ring, int timeout_ms) {
+    spsc_ring_header_t *hdr = ring->hdr;
+
+    atomic_store_explicit(&hdr->consumer_waiting, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Re-check after announcing the wait so a concurrent push is not missed
+    if (atomic_load_explicit(&hdr->head, memory_order_acquire) ==
+            atomic_load_explicit(&hdr->tail, memory_order_relaxed) &&
+        !atomic_load_explicit(&hdr->closed, memory_order_acquire)) {
+        struct pollfd pfd = { .fd = ring->event_fd, .events = POLLIN };
+        while (poll(&pfd, 1, timeout_ms) < 0 && errno == EINTR) {
+        }
+    }
+
+    drain_event(ring);
+    atomic_store_explicit(&hdr->consumer_waiting, 0, memory_order_relaxed);
+}
+
+/**
+ * Mark the ring as finished and wake the consumer (producer side)
+ * @param ring Ring to close
+ */
+void spsc_ring_close(spsc_ring_t *ring) {
+    atomic_store_explicit(&ring->hdr->closed, 1, memory_order_release);
+    notify(ring);
+}
+
+/**
+ * Wake a consumer sleeping in spsc_ring_wait regardless of ring state
+ * @param ring Ring to wake
+ */
+void spsc_ring_wake(spsc_ring_t *ring) {
+    notify(ring);
+}
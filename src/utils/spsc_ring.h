@@ -0,0 +1,116 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+// Cache line size used to keep producer and consumer indices apart
+#define SPSC_RING_CACHE_LINE 64
+
+/**
+ * Ring control block
+ *
+ * Lives at the start of the shared mapping, so a ring created before fork()
+ * or passed by descriptor works across processes as well as threads.
+ * head is written only by the producer, tail only by the consumer.
+ */
+typedef struct {
+    _Atomic uint64_t head;              // Next slot to write (producer)
+    char pad0[SPSC_RING_CACHE_LINE - sizeof(uint64_t)];
+    _Atomic uint64_t tail;              // Next slot to read (consumer)
+    char pad1[SPSC_RING_CACHE_LINE - sizeof(uint64_t)];
+    _Atomic int consumer_waiting;       // Consumer is about to sleep on the event fd
+    _Atomic int closed;                 // Producer finished
+    _Atomic uint64_t dropped;           // Records rejected because the ring was full
+} spsc_ring_header_t;
+
+/**
+ * Lock-free single-producer/single-consumer ring of fixed-size records
+ *
+ * Records are copied into a memfd/mmap-backed slot array. Publishing is a
+ * copy plus a release store; the producer only makes a syscall (an eventfd
+ * write) when the consumer has announced that it is going to sleep.
+ */
+typedef struct {
+    spsc_ring_header_t *hdr;    // Control block (start of the mapping)
+    unsigned char *slots;       // Slot array (follows the control block)
+    size_t slot_size;           // Bytes per record
+    size_t stride;              // Distance between slots
+    uint32_t mask;              // Capacity - 1 (capacity is a power of two)
+    size_t map_size;            // Size of the mapping
+    int mem_fd;                 // memfd backing the mapping (-1 if anonymous)
+    int event_fd;               // Wakeup descriptor the consumer polls
+    int notify_fd;              // Wakeup descriptor the producer writes
+} spsc_ring_t;
+
+/**
+ * Create a ring
+ *
+ * @param ring Ring to initialize
+ * @param slot_size Size of one record in bytes
+ * @param capacity Number of slots, rounded up to a power of two
+ * @return 0 on success, -1 on failure
+ */
+int spsc_ring_create(spsc_ring_t *ring, size_t slot_size, uint32_t capacity);
+
+/**
+ * Unmap the ring and close its descriptors
+ *
+ * @param ring Ring to destroy
+ */
+void spsc_ring_destroy(spsc_ring_t *ring);
+
+/**
+ * Copy a record into the ring (producer side)
+ *
+ * Never blocks. A full ring rejects the record and counts it as dropped,
+ * so a slow consumer cannot stall sampling.
+ *
+ * @param ring Ring to write
+ * @param record Record of slot_size bytes
+ * @return 0 on success, -1 if the ring was full
+ */
+int spsc_ring_push(spsc_ring_t *ring, const void *record);
+
+/**
+ * Copy the oldest record out of the ring (consumer side)
+ *
+ * @param ring Ring to read
+ * @param record Output buffer of slot_size bytes
+ * @return 0 on success, -1 if the ring was empty
+ */
+int spsc_ring_pop(spsc_ring_t *ring, void *record);
+
+/**
+ * Sleep until the ring has a record, is closed or is woken (consumer side)
+ *
+ * @param ring Ring to wait on
+ * @param timeout_ms Maximum wait in milliseconds (-1: no limit)
+ */
+void spsc_ring_wait(spsc_ring_t *ring, int timeout_ms);
+
+/**
+ * Mark the ring as finished and wake the consumer (producer side)
+ *
+ * @param ring Ring to close
+ */
+void spsc_ring_close(spsc_ring_t *ring);
+
+/**
+ * Wake a consumer sleeping in spsc_ring_wait regardless of ring state
+ *
+ * @param ring Ring to wake
+ */
+void spsc_ring_wake(spsc_ring_t *ring);
+
+/**
+ * Check whether the ring is closed and drained
+ */
+static inline int spsc_ring_finished(spsc_ring_t *ring) {
+    return atomic_load_explicit(&ring->hdr->closed, memory_order_acquire) &&
+           atomic_load_explicit(&ring->hdr->head, memory_order_acquire) ==
+           atomic_load_explicit(&ring->hdr->tail, memory_order_relaxed);
+}
+
+#endif // SPSC_RING_H
@@ -0,0 +1,267 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+
+/**
+ * One trace record
+ */
+typedef struct {
+    uint64_t time_ns;               // CLOCK_MONOTONIC
+    const char *fmt;
+    int nargs;
+    char types[TRACE_MAX_ARGS];
+    uint64_t args[TRACE_MAX_ARGS];
+} trace_record_t;
+
+/**
+ * Per-thread record ring
+ * Only the owning thread writes; the dumper reads behind it and discards
+ * records the owner may have overwritten while they were being copied.
+ */
+typedef struct trace_ring {
+    trace_record_t records[TRACE_RING_RECORDS];
+    _Atomic uint64_t head;          // Records ever written
+    uint64_t dumped;                // Records already dumped (dumper only)
+    unsigned long thread;           // Owning thread, for the dump
+    struct trace_ring *next;
+} trace_ring_t;
+
+static _Thread_local trace_ring_t *trace_ring;
+static trace_ring_t *trace_rings;           // All rings, newest first
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *trace_out;
+static uint64_t trace_start_ns;
+
+/**
+ * Current CLOCK_MONOTONIC time
+ * @return Nanoseconds
+ */
+static uint64_t trace_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * Allocate and register the calling thread's ring
+ * @return The ring, or NULL on allocation failure
+ */
+static trace_ring_t *trace_ring_create(void) {
+    trace_ring_t *ring = calloc(1, sizeof(*ring));
+    if (ring == NULL) {
+        return NULL;
+    }
+    ring->thread = (unsigned long)pthread_self();
+
+    // Rings outlive their threads so that late dumps still see them
+    pthread_mutex_lock(&trace_lock);
+    ring->next = trace_rings;
+    trace_rings = ring;
+    pthread_mutex_unlock(&trace_lock);
+    return ring;
+}
+
+/**
+ * Record an event in the calling thread's ring
+ * @param fmt Format string (string literal)
+ * @param nargs Number of arguments
+ * @param args Arguments
+ */
+void trace_emit(const char *fmt, int nargs, const trace_arg_t *args) {
+    trace_ring_t *ring = trace_ring;
+    if (ring == NULL) {
+        ring = trace_ring = trace_ring_create();
+        if (ring == NULL) {
+            return;
+        }
+    }
+
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    trace_record_t *record = &ring->records[head & (TRACE_RING_RECORDS - 1)];
+
+    record->time_ns = trace_now_ns();
+    record->fmt = fmt;
+    record->nargs = nargs < TRACE_MAX_ARGS ? nargs : TRACE_MAX_ARGS;
+    for (int i = 0; i < record->nargs; i++) {
+        record->types[i] = args[i].type;
+        record->args[i] = args[i].bits;
+    }
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+/**
+ * Print one record, substituting its arguments into the format
+ * @param out Output stream
+ * @param ring Ring the record came from
+ * @param record Record to print
+ */
+static void trace_print(FILE *out, const trace_ring_t *ring, const trace_record_t *record) {
+    char line[512];
+    size_t used = 0;
+    int arg = 0;
+    const char *p = record->fmt;
+
+    while (*p != '\0' && used < sizeof(line) - 1) {
+        if (*p != '%') {
+            line[used++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            line[used++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Copy flags, width and precision; drop length modifiers
+        char spec[32] = "%";
+        size_t len = 1;
+        p++;
+        while (*p != '\0' && strchr("-+ #0123456789.", *p) != NULL && len < sizeof(spec) - 4) {
+            spec[len++] = *p++;
+        }
+        while (*p != '\0' && strchr("hlLqjzt", *p) != NULL) {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        char conversion = *p++;
+
+        int written = 0;
+        size_t room = sizeof(line) - used;
+        if (arg >= record->nargs) {
+            written = snprintf(line + used, room, "?");
+        } else if (record->types[arg] == 'f') {
+            union { uint64_t u; double d; } bits = { .u = record->args[arg] };
+            spec[len++] = strchr("eEfFgGaA", conversion) != NULL ? conversion : 'g';
+            spec[len] = '\0';
+            written = snprintf(line + used, room, spec, bits.d);
+        } else {
+            int is_signed = record->types[arg] == 'i';
+            spec[len++] = 'l';
+            spec[len++] = 'l';
+            if (strchr("dixXuo", conversion) != NULL) {
+                spec[len++] = (conversion == 'd' || conversion == 'i') && !is_signed ? 'u' : conversion;
+            } else {
+                spec[len++] = is_signed ? 'd' : 'u';
+            }
+            spec[len] = '\0';
+            if (is_signed) {
+                written = snprintf(line + used, room, spec, (long long)record->args[arg]);
+            } else {
+                written = snprintf(line + used, room, spec, (unsigned long long)record->args[arg]);
+            }
+        }
+        arg++;
+        if (written > 0) {
+            used += (size_t)written < room ? (size_t)written : room - 1;
+        }
+    }
+    line[used] = '\0';
+
+    uint64_t since = record->time_ns - trace_start_ns;
+    fprintf(out, "[%6llu.%06llu] %#lx | %s\n",
+            (unsigned long long)(since / 1000000000ull),
+            (unsigned long long)(since % 1000000000ull / 1000ull),
+            ring->thread, line);
+}
+
+/**
+ * Write the records traced since the previous dump
+ * @param reason Shown in the dump header
+ */
+void trace_dump(const char *reason) {
+    FILE *out = trace_out != NULL ? trace_out : stderr;
+
+    pthread_mutex_lock(&trace_lock);
+    fprintf(out, "--- trace dump (%s) ---\n", reason);
+
+    for (trace_ring_t *ring = trace_rings; ring != NULL; ring = ring->next) {
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t first = ring->dumped;
+        if (head - first > TRACE_RING_RECORDS) {
+            fprintf(out, "(thread %#lx: %llu older records overwritten)\n", ring->thread,
+                    (unsigned long long)(head - first - TRACE_RING_RECORDS));
+            first = head - TRACE_RING_RECORDS;
+        }
+
+        for (uint64_t i = first; i < head; i++) {
+            trace_record_t record = ring->records[i & (TRACE_RING_RECORDS - 1)];
+
+            // The owner keeps writing: skip a slot it may have reused meanwhile
+            uint64_t now = atomic_load_explicit(&ring->head, memory_order_acquire);
+            if (now - i > TRACE_RING_RECORDS - 1) {
+                continue;
+            }
+            trace_print(out, ring, &record);
+        }
+        ring->dumped = head;
+    }
+
+    fflush(out);
+    pthread_mutex_unlock(&trace_lock);
+}
+
+#if TRACE_LEVEL > TRACE_LEVEL_OFF
+/**
+ * Dump thread: waits for SIGUSR2
+ * @param arg Blocked signal set
+ * @return NULL
+ */
+static void *trace_signal_thread(void *arg) {
+    sigset_t *signals = arg;
+    int signal;
+
+    while (sigwait(signals, &signal) == 0) {
+        trace_dump("SIGUSR2");
+    }
+    return NULL;
+}
+
+/**
+ * Dump the remaining records at exit
+ */
+static void trace_dump_at_exit(void) {
+    trace_dump("exit");
+}
+#endif
+
+/**
+ * Start tracing: route SIGUSR2 to a dump thread and dump at exit
+ * @param dump_path File the dumps are appended to (NULL for stderr)
+ * @return 0 on success, -1 on failure
+ */
+int trace_init(const char *dump_path) {
+#if TRACE_LEVEL > TRACE_LEVEL_OFF
+    static sigset_t signals;
+    pthread_t thread;
+
+    trace_start_ns = trace_now_ns();
+    if (dump_path != NULL) {
+        trace_out = fopen(dump_path, "a");
+        if (trace_out == NULL) {
+            return -1;
+        }
+    }
+
+    // SIGUSR2 is blocked here and in every thread created afterwards, so
+    // only the dump thread receives it and the dump runs outside a handler
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR2);
+    if (pthread_sigmask(SIG_BLOCK, &signals, NULL) != 0 ||
+        pthread_create(&thread, NULL, trace_signal_thread, &signals) != 0) {
+        return -1;
+    }
+    pthread_detach(thread);
+
+    atexit(trace_dump_at_exit);
+#else
+    (void)dump_path;
+#endif
+    return 0;
+}
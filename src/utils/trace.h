@@ -0,0 +1,127 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/**
+ * Compile-time trace points
+ *
+ * TRACE_INFO and TRACE_DEBUG record an event as a binary record (format
+ * string pointer, timestamp and up to TRACE_MAX_ARGS numeric arguments)
+ * in a per-thread in-memory ring. Nothing is formatted when the event
+ * happens: records are turned into text only when the rings are dumped,
+ * on SIGUSR2 or at exit.
+ *
+ * Trace points above TRACE_LEVEL compile to nothing, arguments included.
+ * Build with e.g. `make TRACE_LEVEL=2` to enable the detailed ones.
+ *
+ * Formats may only use numeric conversions (d, i, u, x, f, g, e, ...);
+ * length modifiers are ignored, the argument's own type decides.
+ */
+
+// Trace levels
+#define TRACE_LEVEL_OFF   0     // No trace points
+#define TRACE_LEVEL_INFO  1     // One event per sample or frame
+#define TRACE_LEVEL_DEBUG 2     // Raw counters and intermediate values
+
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL TRACE_LEVEL_OFF
+#endif
+
+#define TRACE_MAX_ARGS     6
+#define TRACE_RING_RECORDS 2048    // Records kept per thread (power of two)
+
+/**
+ * One numeric trace argument
+ */
+typedef struct {
+    uint64_t bits;      // Value (a double's bit pattern for 'f')
+    char type;          // 'i' signed, 'u' unsigned, 'f' floating point
+} trace_arg_t;
+
+/**
+ * Start tracing: route SIGUSR2 to a dump thread and dump at exit
+ * Call before any other thread is created, so that all of them inherit
+ * the blocked SIGUSR2.
+ *
+ * @param dump_path File the dumps are appended to (NULL for stderr)
+ * @return 0 on success, -1 on failure
+ */
+int trace_init(const char *dump_path);
+
+/**
+ * Write the records traced since the previous dump
+ *
+ * @param reason Shown in the dump header
+ */
+void trace_dump(const char *reason);
+
+/**
+ * Record an event in the calling thread's ring (use the TRACE_* macros)
+ *
+ * @param fmt Format string (string literal)
+ * @param nargs Number of arguments
+ * @param args Arguments
+ */
+void trace_emit(const char *fmt, int nargs, const trace_arg_t *args);
+
+static inline trace_arg_t trace_arg_signed(long long value) {
+    trace_arg_t arg = { (uint64_t)value, 'i' };
+    return arg;
+}
+
+static inline trace_arg_t trace_arg_unsigned(unsigned long long value) {
+    trace_arg_t arg = { (uint64_t)value, 'u' };
+    return arg;
+}
+
+static inline trace_arg_t trace_arg_double(double value) {
+    union { double d; uint64_t u; } bits = { .d = value };
+    trace_arg_t arg = { bits.u, 'f' };
+    return arg;
+}
+
+#define TRACE_ARG(x) _Generic((x),                          \
+    float: trace_arg_double,                                \
+    double: trace_arg_double,                               \
+    unsigned char: trace_arg_unsigned,                      \
+    unsigned short: trace_arg_unsigned,                     \
+    unsigned int: trace_arg_unsigned,                       \
+    unsigned long: trace_arg_unsigned,                      \
+    unsigned long long: trace_arg_unsigned,                 \
+    default: trace_arg_signed)(x)
+
+// Argument list expansion: the format counts as the first argument
+#define TRACE_COUNT_(_0, _1, _2, _3, _4, _5, _6, n, ...) n
+#define TRACE_COUNT(...) TRACE_COUNT_(__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0, -1)
+#define TRACE_ARGS_0(f) TRACE_ARG(0)
+#define TRACE_ARGS_1(f, a) TRACE_ARG(a)
+#define TRACE_ARGS_2(f, a, b) TRACE_ARG(a), TRACE_ARG(b)
+#define TRACE_ARGS_3(f, a, b, c) TRACE_ARG(a), TRACE_ARG(b), TRACE_ARG(c)
+#define TRACE_ARGS_4(f, a, b, c, d) TRACE_ARGS_3(f, a, b, c), TRACE_ARG(d)
+#define TRACE_ARGS_5(f, a, b, c, d, e) TRACE_ARGS_4(f, a, b, c, d), TRACE_ARG(e)
+#define TRACE_ARGS_6(f, a, b, c, d, e, g) TRACE_ARGS_5(f, a, b, c, d, e), TRACE_ARG(g)
+#define TRACE_CAT_(a, b) a##b
+#define TRACE_CAT(a, b) TRACE_CAT_(a, b)
+
+#define TRACE_RECORD(...) do {                                                  \
+        const trace_arg_t trace_args_[] = {                                     \
+            TRACE_CAT(TRACE_ARGS_, TRACE_COUNT(__VA_ARGS__))(__VA_ARGS__) };    \
+        trace_emit(TRACE_FORMAT_(__VA_ARGS__, 0), TRACE_COUNT(__VA_ARGS__),    \
+                   trace_args_);                                                \
+    } while (0)
+#define TRACE_FORMAT_(fmt, ...) fmt
+
+#if TRACE_LEVEL >= TRACE_LEVEL_INFO
+#define TRACE_INFO(...) TRACE_RECORD(__VA_ARGS__)
+#else
+#define TRACE_INFO(...) ((void)0)
+#endif
+
+#if TRACE_LEVEL >= TRACE_LEVEL_DEBUG
+#define TRACE_DEBUG(...) TRACE_RECORD(__VA_ARGS__)
+#else
+#define TRACE_DEBUG(...) ((void)0)
+#endif
+
+#endif // TRACE_H
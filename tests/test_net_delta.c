@@ -0,0 +1,46 @@
+#include "net.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/**
+ * One counter pair and the increase it must give
+ */
+typedef struct {
+    const char *name;
+    uint64_t last;
+    uint64_t now;
+    uint64_t expected;
+} DeltaCase;
+
+/**
+ * Counter increases across normal growth, 32-bit wraps and resets.
+ */
+int main(void) {
+    static const DeltaCase cases[] = {
+        { "growth", 1000, 1500, 500 },
+        { "no change", 42, 42, 0 },
+        { "growth above 2^32", 0x100000000ULL, 0x100000400ULL, 0x400 },
+        { "32-bit wrap", UINT32_MAX - 99, 50, 150 },
+        { "32-bit wrap from the top", UINT32_MAX, 0, 1 },
+        { "small counter reset", 12, 3, 0 },
+        { "reset from the lower half", (UINT32_MAX >> 1) - 10, 5, 0 },
+        { "64-bit counter going backwards", 0x500000000ULL, 0x400000000ULL, 0 },
+        { "64-bit counter reset to a small value", 0x500000000ULL, 10, 0 },
+    };
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const DeltaCase *c = &cases[i];
+        uint64_t delta = netCounterDelta(c->now, c->last);
+        if (delta != c->expected) {
+            printf("FAIL: %s: %" PRIu64 " -> %" PRIu64 " gave %" PRIu64 ", expected %" PRIu64 "\n",
+                   c->name, c->last, c->now, delta, c->expected);
+            failed = 1;
+        }
+    }
+    if (failed) {
+        return 1;
+    }
+    printf("PASS: %zu counter deltas\n", sizeof(cases) / sizeof(cases[0]));
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "metric_source.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// How long the worker spins while the source measures (microseconds)
+#define SPIN_USEC 1500000
+
+static atomic_int spinning = 1;
+
+/**
+ * Worker thread: burn CPU while the main thread sleeps
+ * @param arg Unused
+ * @return NULL
+ */
+static void *spin(void *arg) {
+    (void)arg;
+    while (atomic_load_explicit(&spinning, memory_order_relaxed)) {
+    }
+    return NULL;
+}
+
+/**
+ * A process whose only busy thread is not the thread-group leader must
+ * still rank with the CPU time of all its threads.
+ */
+int main(void) {
+    static SystemSnapshot snapshot;
+    void *state = NULL;
+    pthread_t worker;
+    int pid = getpid();
+
+    if (processMetricSource.init(&state) != 0) {
+        printf("SKIP: process source unavailable\n");
+        return 0;
+    }
+    if (pthread_create(&worker, NULL, spin, NULL) != 0) {
+        printf("FAIL: pthread_create\n");
+        return 1;
+    }
+
+    // Leave the worker one full interval, then rank
+    usleep(SPIN_USEC);
+    processMetricSource.collect(state, &snapshot);
+    atomic_store(&spinning, 0);
+    pthread_join(worker, NULL);
+    processMetricSource.teardown(state);
+
+    for (int i = 0; i < snapshot.processes.count; i++) {
+        const ProcessEntry *entry = &snapshot.processes.top[i];
+        if (entry->pid == pid) {
+            if (entry->cpu_percent < 50.0f) {
+                printf("FAIL: spinning worker ranked at %.1f%%\n", entry->cpu_percent);
+                return 1;
+            }
+            printf("PASS: %d threads, %.1f%%\n", entry->threads, entry->cpu_percent);
+            return 0;
+        }
+    }
+    printf("FAIL: process with a spinning worker missing from the CPU ranking\n");
+    return 1;
+}